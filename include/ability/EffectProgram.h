@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/// @brief 能力效果指令操作码
+enum class EffectOp : uint8_t {
+	// 数值
+	LoadConst,		// num[a] = constants[b]
+	Add,			// num[a] = num[b] + num[c]
+	Mul,			// num[a] = num[b] * num[c]
+	SetSize,		// num[a] = set[b] 的目标数
+
+	// 查询
+	QueryRadius,	// set[a] = 施法者 num[c] 半径内带标签 b 的实体
+	QueryNearest,	// set[a] = 施法者 num[c] 半径内带标签 b 的最近 num[d] 个实体
+
+	// 流程
+	Require,		// set[a] 为空时本次施放失败，后续指令不再执行
+
+	// 效果
+	Damage,			// 对 set[a] 造成 num[b] 点类型为 c 的伤害
+	Modify,			// 对 set[a] 的属性 b 施加运算 c、数值 num[d]、持续 num[e] 秒的修正
+	Assimilate,		// 同化 set[a] 中的敌人 num[b] 秒
+	Push,			// 把 set[a] 沿远离施法者的水平方向推开 num[b] 距离
+	Projectiles,	// 沿施法者朝向在 num[d] 度扇形内发射 num[a] 个速度 num[b]、伤害 num[c] 的投射物
+	Corrupt,		// 施法者腐蚀度增加 num[a]（负数为减少，由腐蚀组件夹紧到不低于0）
+	Cleanse,		// 从扩散场移除施法者 num[a] 半径内每格 num[b] 的腐蚀
+	FlipGravity,	// 反转施法者的重力方向
+
+	Count
+};
+
+/// @brief 能力效果程序 - 编译成寄存器字节码的能力效果
+/// @details 从文本描述编译而来，由 EffectVM 对一批施放同时解释执行。
+///
+/// 设计思路：
+/// 1. 文本格式每行一条语句，# 之后为注释；`名称 = 表达式` 把结果写入命名寄存器，
+///    其余语句直接产生效果，每条语句编译为一条8字节的定长指令
+/// 2. 寄存器分为数值和目标集合两类，编译时按名称分配编号；集合寄存器0固定为施法者自身（self）
+/// 3. 字面量编译为常量表中的一项，并在程序开头用 LoadConst 装入数值寄存器
+/// 4. 编译时检查寄存器类型、数量和指令数上限，运行时不再做任何校验
+///
+/// 为何这样做：
+/// - 新能力或调整能力效果只需编写数据文件，不再修改C++分支
+/// - 定长指令和固定数量的寄存器让虚拟机可以用预分配的数组执行，运行时不分配内存
+/// - 指令按操作码统计耗时，新增效果的开销可以直接观察
+class EffectProgram
+{
+public:
+	static const int NumberRegisters = 16;	// 数值寄存器数
+	static const int SetRegisters = 8;	// 目标集合寄存器数（含 self）
+	static const int MaxInstructions = 64;	// 最多指令数
+	static const uint8_t SelfSet = 0;	// 施法者自身所在的集合寄存器
+
+	/// @brief 目标标签
+	enum TargetTag : uint8_t
+	{
+		TargetAny,		// 任意实体
+		TargetEnemy,	// 敌人
+		TargetPlayer	// 玩家
+	};
+
+	/// @brief 编译后的指令
+	struct Instruction
+	{
+		EffectOp op;	// 操作码
+		uint8_t a;	// 操作数，含义见 EffectOp
+		uint8_t b;
+		uint8_t c;
+		uint8_t d;
+		uint8_t e;
+		uint16_t reserved;	// 对齐保留
+	};
+
+	/// @brief 从文本编译程序
+	/// @param name [IN] 程序名称
+	/// @param source [IN] 文本内容
+	/// @param error [OUT] 失败时的错误信息
+	/// @return 是否成功
+	bool compile(const std::string& name, const std::string& source, std::string& error);
+
+	/// @brief 获取名称
+	const std::string& getName() const { return m_name; }
+
+	/// @brief 获取指令数组
+	const std::vector<Instruction>& getCode() const { return m_code; }
+
+	/// @brief 获取常量表
+	const std::vector<float>& getConstants() const { return m_constants; }
+
+private:
+	std::string m_name;	// 名称
+	std::vector<Instruction> m_code;	// 指令
+	std::vector<float> m_constants;	// 常量表
+};
+
+/// @brief 能力效果库 - 加载并持有所有能力效果程序
+/// @details 程序按ID访问，能力表只保存程序名称，能力系统在构造时解析为ID。
+class EffectLibrary
+{
+public:
+	/// @brief 从文件加载程序
+	/// @details 名称取文件名（不含目录和扩展名），失败时记录错误日志
+	/// @param path [IN] 文件路径
+	/// @return 程序ID，失败返回-1
+	int load(const std::string& path);
+
+	/// @brief 从文本加载程序
+	/// @param name [IN] 程序名称
+	/// @param source [IN] 文本内容
+	/// @return 程序ID，失败返回-1
+	int loadFromSource(const std::string& name, const std::string& source);
+
+	/// @brief 按名称查找程序
+	/// @param name [IN] 程序名称
+	/// @return 程序ID，找不到返回-1
+	int find(const std::string& name) const;
+
+	/// @brief 按ID获取程序
+	/// @param id [IN] 程序ID
+	/// @return 程序，ID无效时返回nullptr
+	const EffectProgram* get(int id) const
+	{
+		return id >= 0 && id < static_cast<int>(m_programs.size()) ? &m_programs[id] : nullptr;
+	}
+
+private:
+	std::vector<EffectProgram> m_programs;	// 已加载的程序
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include "ability/EffectProgram.h"
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "spatial/SpatialIndex.h"
+
+// 前向声明
+class Entity;
+class DamageQueue;
+class ProjectilePool;
+class CorruptionDiffusion;
+
+/// @brief 能力效果虚拟机 - 对一批施放同时解释执行效果程序
+/// @details 指令按顺序执行，每条指令依次作用于批内所有仍然有效的施放。
+///
+/// 设计思路：
+/// 1. 寄存器按列存放：num[寄存器][施放]，集合寄存器是共享目标缓冲中的一段区间
+/// 2. 批大小、目标缓冲和最近邻查询缓冲都在构造时按上限分配，执行过程中不分配内存，
+///    目标超出缓冲容量时截断
+/// 3. Require 失败的施放标记为无效，之后的指令跳过它，最终结果逐个返回
+/// 4. 每条指令执行前后取一次时间，按操作码累计执行次数和耗时
+///
+/// 为何这样做：
+/// - 指令解码和分派的开销由整批施放分摊
+/// - 效果只能通过有限的操作码作用于世界，数据文件不会引入无界的开销或内存分配
+/// - 按操作码统计的耗时可以直接定位新增效果带来的热点
+class EffectVM
+{
+public:
+	static const int MaxBatch = 32;	// 每批最多施放数
+	static const size_t TargetCapacity = 2048;	// 每批所有集合共享的目标数上限
+	static const size_t MaxNearest = 64;	// 最近邻查询的最多目标数
+
+	/// @brief 效果作用的共享服务
+	struct Context
+	{
+		const SpatialIndex* spatialIndex;	// 空间索引，用于查询目标
+		DamageQueue* damageQueue;	// 伤害队列
+		ProjectilePool* projectiles;	// 投射物池
+		CorruptionDiffusion* corruptionDiffusion;	// 腐蚀扩散场
+	};
+
+	/// @brief 某个操作码的统计
+	struct OpStats
+	{
+		uint64_t executions;	// 执行次数（按施放计）
+		uint64_t nanoseconds;	// 累计耗时
+	};
+
+	/// @brief 构造函数
+	/// @param context [IN] 共享服务
+	explicit EffectVM(const Context& context);
+
+	/// @brief 执行一批施放
+	/// @param program [IN] 效果程序
+	/// @param casters [IN] 施法者数组
+	/// @param count [IN] 施法者数量，不超过 MaxBatch
+	/// @param modifierSource [IN] 修正指令使用的来源
+	/// @param results [OUT] 每个施放是否成功
+	void run(const EffectProgram& program, Entity* const* casters, int count, uint32_t modifierSource, bool* results);
+
+	/// @brief 获取某个操作码的统计
+	/// @param op [IN] 操作码
+	/// @return 统计
+	const OpStats& getStats(EffectOp op) const { return m_stats[static_cast<int>(op)]; }
+
+	/// @brief 清空统计
+	void resetStats();
+
+	/// @brief 把有执行记录的操作码统计写入日志
+	void logStats() const;
+
+private:
+	/// @brief 集合寄存器的值
+	struct Span
+	{
+		uint32_t begin;	// 在目标缓冲中的起始下标
+		uint32_t end;	// 结束下标
+	};
+
+	/// @brief 执行一条指令
+	/// @param instruction [IN] 指令
+	/// @param program [IN] 所属程序
+	/// @param modifierSource [IN] 修正指令使用的来源
+	void execute(const EffectProgram::Instruction& instruction, const EffectProgram& program, uint32_t modifierSource);
+
+	/// @brief 把实体追加到目标缓冲
+	/// @param entity [IN] 实体
+	/// @return 缓冲已满时返回false
+	bool pushTarget(Entity* entity);
+
+	/// @brief 构造查询过滤器
+	/// @param tag [IN] 目标标签
+	/// @param cast [IN] 施放下标
+	/// @return 过滤器
+	SpatialIndex::Filter makeFilter(uint8_t tag, int cast) const;
+
+private:
+	Context m_context;	// 共享服务
+
+	// 当前批次
+	int m_count;	// 施放数
+	Entity* m_casters[MaxBatch];	// 施法者
+	glm::vec3 m_positions[MaxBatch];	// 施法者位置
+	glm::vec3 m_forwards[MaxBatch];	// 施法者水平朝向
+	bool m_alive[MaxBatch];	// 施放是否仍然有效
+	float m_numbers[EffectProgram::NumberRegisters][MaxBatch];	// 数值寄存器
+	Span m_sets[EffectProgram::SetRegisters][MaxBatch];	// 集合寄存器
+	std::vector<Entity*> m_targets;	// 目标缓冲，容量 TargetCapacity
+	size_t m_targetCount;	// 已使用的目标数
+	std::vector<SpatialIndex::Neighbor> m_neighbors;	// 最近邻查询缓冲，容量 MaxNearest
+
+	OpStats m_stats[static_cast<int>(EffectOp::Count)];	// 每个操作码的统计
+};
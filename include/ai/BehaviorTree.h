@@ -0,0 +1,181 @@
+#pragma once
+#include "components/Behavior.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/// @brief 行为树节点执行结果
+enum class BehaviorStatus : uint8_t {
+	Success,    // 成功
+	Failure,    // 失败
+	Running     // 运行中，下次更新继续
+};
+
+/// @brief 行为树节点操作码
+enum class BehaviorOp : uint8_t {
+	// 组合节点
+	Selector,       // 依次执行子节点，直到有一个成功
+	Sequence,       // 依次执行子节点，直到有一个失败
+	Invert,         // 反转唯一子节点的结果
+
+	// 条件叶子
+	InRange,        // 玩家在 param0 距离内
+	HealthBelow,    // 生命值比例低于 param0
+
+	// 行为叶子
+	Idle,           // 原地停留 param0 秒
+	Patrol,         // 沿巡逻点移动 param0 秒，玩家进入 param1 距离时失败
+	Chase,          // 追向玩家，进入 param0 距离成功，超过 param1 距离失败
+	Attack,         // 面向玩家并在冷却结束时攻击一次
+	Flee,           // 远离玩家，直到距离达到 param0
+
+	Count
+};
+
+/// @brief 行为树 - 编译成扁平节点数组的行为树
+/// @details 从文本描述编译而来，节点按前序排列，每个节点记录父节点和子树结束位置。
+/// 
+/// 设计思路：
+/// 1. 文本格式每行一个节点，缩进表示层级，# 之后为注释，节点名后跟数值参数
+/// 2. 编译时为需要记忆的叶子分配黑板槽位，运行状态全部存放在实体的 Behavior 组件里
+/// 3. 解释执行不使用递归：叶子返回后沿父节点链向上传递结果，
+///    顺序/选择节点直接跳到下一个兄弟子树的第一个叶子
+/// 4. 叶子返回 Running 时记下该叶子，下次更新直接从它继续
+/// 
+/// 为何这样做：
+/// - 新的敌人类型只需编写数据文件，不再修改C++分支
+/// - 节点是16字节的定长结构，整棵树连续存放，遍历对缓存友好
+/// - 没有虚函数和每实体的节点对象，单个实体的开销只与执行路径长度有关
+class BehaviorTree
+{
+public:
+	/// @brief 编译后的节点
+	struct Node
+	{
+		BehaviorOp op;	// 操作码
+		uint8_t slot;	// 黑板槽位（不需要时为0xFF）
+		uint16_t parent;	// 父节点下标（根节点为 Behavior::NoNode）
+		uint16_t end;	// 子树结束位置（子树最后一个节点的下一个下标）
+		uint16_t reserved;	// 对齐保留
+		float params[2];	// 参数
+	};
+
+	/// @brief 从文本编译行为树
+	/// @param name [IN] 行为树名称
+	/// @param source [IN] 文本内容
+	/// @param error [OUT] 失败时的错误信息
+	/// @return 是否成功
+	bool compile(const std::string& name, const std::string& source, std::string& error);
+
+	/// @brief 执行一次行为树
+	/// @details 从实体正在运行的叶子继续，没有时从根节点开始；返回 Running 之外的结果表示整棵树本次执行完毕
+	/// @tparam LeafFn [IN] 叶子执行函数类型，签名为 BehaviorStatus(const Node&, float* slot, bool resumed)
+	/// @param state [IN/OUT] 实体的行为组件
+	/// @param leaf [IN] 叶子执行函数
+	/// @return 本次执行结果
+	template <typename LeafFn>
+	BehaviorStatus tick(Behavior& state, LeafFn&& leaf) const;
+
+	/// @brief 获取名称
+	const std::string& getName() const { return m_name; }
+
+	/// @brief 获取节点数组
+	const std::vector<Node>& getNodes() const { return m_nodes; }
+
+private:
+	/// @brief 从节点向下找到第一个叶子
+	/// @param index [IN] 节点下标
+	/// @return 叶子下标
+	uint16_t firstLeaf(uint16_t index) const
+	{
+		while (m_nodes[index].op <= BehaviorOp::Invert) ++index;	// 组合节点的第一个子节点紧随其后
+		return index;
+	}
+
+private:
+	std::string m_name;	// 名称
+	std::vector<Node> m_nodes;	// 前序排列的节点
+};
+
+template <typename LeafFn>
+BehaviorStatus BehaviorTree::tick(Behavior& state, LeafFn&& leaf) const
+{
+	if (m_nodes.empty()) return BehaviorStatus::Failure;
+
+	const uint16_t resumedNode = state.running;
+	uint16_t index = resumedNode != Behavior::NoNode ? resumedNode : firstLeaf(0);
+
+	for (;;) {
+		// 1. 执行叶子
+		const Node& node = m_nodes[index];
+		float* slot = node.slot != 0xFF ? &state.blackboard[node.slot] : nullptr;
+		BehaviorStatus status = leaf(node, slot, index == resumedNode);
+		if (status == BehaviorStatus::Running) {
+			state.running = index;
+			return status;
+		}
+
+		// 2. 沿父节点链向上传递结果，直到某个组合节点决定进入下一个子树
+		bool descended = false;
+		while (!descended) {
+			const uint16_t parent = m_nodes[index].parent;
+			if (parent == Behavior::NoNode) {	// 整棵树执行完毕，下次从根节点开始
+				state.running = Behavior::NoNode;
+				return status;
+			}
+
+			const Node& parentNode = m_nodes[parent];
+			const uint16_t sibling = m_nodes[index].end;
+			const bool hasSibling = sibling < parentNode.end;
+			switch (parentNode.op) {
+			case BehaviorOp::Sequence:
+				descended = status == BehaviorStatus::Success && hasSibling;
+				break;
+			case BehaviorOp::Selector:
+				descended = status == BehaviorStatus::Failure && hasSibling;
+				break;
+			case BehaviorOp::Invert:
+				status = status == BehaviorStatus::Success ? BehaviorStatus::Failure : BehaviorStatus::Success;
+				break;
+			default:
+				break;
+			}
+			index = descended ? firstLeaf(sibling) : parent;
+		}
+	}
+}
+
+/// @brief 行为树库 - 加载并持有所有行为树
+/// @details 行为树按ID访问，实体的 Behavior 组件只保存ID。
+class BehaviorTreeLibrary
+{
+public:
+	/// @brief 从文件加载行为树
+	/// @details 名称取文件名（不含目录和扩展名），失败时记录错误日志
+	/// @param path [IN] 文件路径
+	/// @return 行为树ID，失败返回-1
+	int load(const std::string& path);
+
+	/// @brief 从文本加载行为树
+	/// @param name [IN] 行为树名称
+	/// @param source [IN] 文本内容
+	/// @return 行为树ID，失败返回-1
+	int loadFromSource(const std::string& name, const std::string& source);
+
+	/// @brief 按名称查找行为树
+	/// @param name [IN] 行为树名称
+	/// @return 行为树ID，找不到返回-1
+	int find(const std::string& name) const;
+
+	/// @brief 按ID获取行为树
+	/// @param id [IN] 行为树ID
+	/// @return 行为树，ID无效时返回nullptr
+	const BehaviorTree* get(int id) const
+	{
+		return id >= 0 && id < static_cast<int>(m_trees.size()) ? &m_trees[id] : nullptr;
+	}
+
+private:
+	std::vector<BehaviorTree> m_trees;	// 已加载的行为树
+};
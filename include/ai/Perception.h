@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class NavGrid;
+class JobSystem;
+
+/// @brief 感知 - 每帧一次性计算所有AI到目标的距离、方向和可见性
+/// @details AI系统每帧把需要决策的实体登记进来，统一计算后各个行为阶段只读取结果。
+///
+/// 设计思路：
+/// 1. 输入（位置和各项距离阈值）与输出（距离、单位方向、标志位）都按SoA存放在连续数组中
+/// 2. 距离、方向和范围判断用 simd::float4 每次处理4个实体，数组末尾补齐到4的倍数
+/// 3. 只有进入视野范围的实体才沿导航网格检查视线，视线检查是逐个进行的标量代码
+/// 4. 实体较多时按块分发给任务系统并行计算，各块只写自己的区间
+///
+/// 为何这样做：
+/// - 每个实体到玩家的距离每帧只算一次，状态机、行为树和细节层次分档共用同一份结果
+/// - 行为阶段只比较标志位，不再各自调用 glm::distance
+/// - 视线检查开销较大，先用视野范围筛掉大部分实体
+class Perception
+{
+public:
+	/// @brief 感知标志位
+	enum Flag : uint8_t {
+		HasTarget = 1 << 0,      // 存在目标
+		InSight = 1 << 1,        // 目标在视野范围内
+		InAttackRange = 1 << 2,  // 目标在攻击范围内（严格小于）
+		InChaseRange = 1 << 3,   // 目标在追逐范围内
+		LineOfSight = 1 << 4,    // 视线未被障碍遮挡（只对视野范围内的实体检查）
+		Visible = InSight | LineOfSight  // 能看到目标
+	};
+
+	/// @brief 构造函数
+	/// @param navGrid [IN] 用于视线检查的导航网格，为空时视线总是通畅
+	explicit Perception(const NavGrid* navGrid = nullptr);
+
+	/// @brief 清空所有登记的实体
+	void clear();
+
+	/// @brief 登记一个实体
+	/// @param position [IN] 实体位置
+	/// @param sightRange [IN] 视野范围
+	/// @param attackRange [IN] 攻击范围
+	/// @param chaseRange [IN] 追逐范围
+	/// @return 实体在感知数组中的下标
+	uint32_t add(const glm::vec3& position, float sightRange, float attackRange, float chaseRange);
+
+	/// @brief 计算所有实体的感知结果
+	/// @details 没有目标时距离为 FLT_MAX，方向为零，只清空标志位
+	/// @param target [IN] 目标位置，为空表示没有目标
+	/// @param jobSystem [IN] 任务系统，可为空
+	void update(const glm::vec3* target, JobSystem* jobSystem);
+
+	/// @brief 获取登记的实体数量
+	size_t size() const { return m_count; }
+
+	/// @brief 获取到目标的距离
+	float getDistance(uint32_t i) const { return m_distance[i]; }
+
+	/// @brief 获取指向目标的单位方向
+	glm::vec3 getDirection(uint32_t i) const { return glm::vec3(m_dirX[i], m_dirY[i], m_dirZ[i]); }
+
+	/// @brief 获取标志位
+	uint8_t getFlags(uint32_t i) const { return m_flags[i]; }
+
+	/// @brief 判断是否具有全部给定的标志位
+	bool has(uint32_t i, uint8_t flags) const { return (m_flags[i] & flags) == flags; }
+
+private:
+	/// @brief 计算 [begin, end) 区间，begin 和 end 都是4的倍数
+	/// @param begin [IN] 起始下标
+	/// @param end [IN] 结束下标
+	void compute(size_t begin, size_t end);
+
+private:
+	const NavGrid* m_pNavGrid;	// 导航网格
+	size_t m_count;	// 登记的实体数量
+	glm::vec3 m_target;	// 本帧目标位置
+
+	// 输入
+	std::vector<float> m_posX, m_posY, m_posZ;	// 位置
+	std::vector<float> m_sightRange;	// 视野范围
+	std::vector<float> m_attackRange;	// 攻击范围
+	std::vector<float> m_chaseRange;	// 追逐范围
+
+	// 输出
+	std::vector<float> m_distance;	// 到目标的距离
+	std::vector<float> m_dirX, m_dirY, m_dirZ;	// 指向目标的单位方向
+	std::vector<uint8_t> m_flags;	// 标志位
+};
@@ -0,0 +1,118 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <initializer_list>
+#include <glm/glm.hpp>
+
+#include "core/Simd.h"
+
+class JobSystem;
+
+/// @brief 响应曲线 - 把一个输入映射为评分系数的分段线性函数
+/// @details 由最多 MaxPoints 个横坐标严格递增的控制点定义，两端之外取端点值。
+class ResponseCurve
+{
+public:
+	static const int MaxPoints = 6;	// 最多控制点数
+
+	/// @brief 构造函数
+	/// @param points [IN] 控制点（x, y），x 必须严格递增
+	ResponseCurve(std::initializer_list<glm::vec2> points = { glm::vec2(0.0f, 1.0f) });
+
+	/// @brief 计算单个输入的曲线值
+	/// @param x [IN] 输入
+	/// @return 曲线值
+	float evaluate(float x) const;
+
+	/// @brief 同时计算4个输入的曲线值
+	/// @details 曲线值 = y0 + Σ clamp((x - x_k) / (x_{k+1} - x_k), 0, 1) * (y_{k+1} - y_k)，没有分支
+	/// @param x [IN] 输入
+	/// @return 曲线值
+	simd::float4 evaluate(const simd::float4& x) const;
+
+private:
+	int m_segments;	// 线段数
+	float m_y0;	// 第一个控制点的值
+	float m_x[MaxPoints];	// 每段起点横坐标
+	float m_invSpan[MaxPoints];	// 每段横向跨度的倒数
+	float m_deltaY[MaxPoints];	// 每段纵向增量
+};
+
+/// @brief 效用评估器 - 批量为大量实体的候选行动打分并选出最优行动
+/// @details 每个行动由若干考量组成，每个考量用一条响应曲线把某个输入映射为系数，行动得分为所有系数之积。
+///
+/// 设计思路：
+/// 1. 输入按SoA存放，每种输入一个连续数组，实体数补齐到4的倍数
+/// 2. 按行动、考量逐个处理，每次用 simd::float4 计算4个实体的曲线值并累乘
+/// 3. 当前正在执行的行动得分加上固定的滞后量，避免在得分接近时来回切换；
+///    滞后量是加法的，不会随其他考量的系数一起放大
+/// 4. 最后用比较和选择指令求每个实体得分最高的行动，实体较多时分块并行
+///
+/// 为何这样做：
+/// - 决策逻辑变成数据（曲线和考量），调整行为时不必修改分支代码
+/// - 同一条曲线连续作用于整个数组，没有逐实体的分支和虚函数调用
+/// - 每个实体的开销只是几次乘加，与原来的阈值判断相当
+class UtilityEvaluator
+{
+public:
+	/// @brief 构造函数
+	/// @param inputCount [IN] 输入种类数
+	/// @param actionCount [IN] 行动种类数
+	/// @param hysteresis [IN] 当前行动的得分加成
+	UtilityEvaluator(int inputCount, int actionCount, float hysteresis = 0.15f);
+
+	/// @brief 为行动添加一项考量
+	/// @param action [IN] 行动
+	/// @param input [IN] 输入
+	/// @param curve [IN] 响应曲线
+	void addConsideration(int action, int input, const ResponseCurve& curve);
+
+	/// @brief 设置实体数量
+	/// @details 输入数组按补齐后的长度分配，新增部分为0
+	/// @param count [IN] 实体数量
+	void resize(size_t count);
+
+	/// @brief 获取某种输入的数组，供调用方逐实体填写
+	/// @param input [IN] 输入
+	/// @return 输入数组
+	float* getInput(int input) { return m_inputs[input].data(); }
+
+	/// @brief 设置实体当前正在执行的行动
+	/// @param i [IN] 实体下标
+	/// @param action [IN] 行动
+	void setCurrent(size_t i, int action) { m_current[i] = static_cast<float>(action); }
+
+	/// @brief 计算所有实体的最优行动
+	/// @param jobSystem [IN] 任务系统，可为空
+	void evaluate(JobSystem* jobSystem);
+
+	/// @brief 获取实体的最优行动
+	/// @param i [IN] 实体下标
+	/// @return 行动
+	int getBest(size_t i) const { return m_best[i]; }
+
+private:
+	/// @brief 一项考量
+	struct Consideration
+	{
+		int action;	// 行动
+		int input;	// 输入
+		ResponseCurve curve;	// 响应曲线
+	};
+
+	/// @brief 计算 [begin, end) 区间，begin 和 end 都是4的倍数
+	/// @param begin [IN] 起始下标
+	/// @param end [IN] 结束下标
+	void compute(size_t begin, size_t end);
+
+private:
+	int m_inputCount;	// 输入种类数
+	int m_actionCount;	// 行动种类数
+	float m_hysteresis;	// 当前行动的得分加成
+	size_t m_count;	// 实体数量
+
+	std::vector<Consideration> m_considerations;	// 按行动排序的考量
+	std::vector<std::vector<float>> m_inputs;	// 每种输入一个数组
+	std::vector<float> m_current;	// 当前行动
+	std::vector<uint8_t> m_best;	// 最优行动
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+class World;
+
+/// @brief 伤害类型
+enum class DamageType : uint8_t {
+	Physical,	// 近战、投射物等物理伤害
+	Rift,		// 空间裂隙
+	Corruption,	// 腐蚀
+	Count
+};
+
+/// @brief 伤害事件
+/// @details 攻击者和目标都以实体ID表示，事件在结算前目标可能已被销毁
+struct DamageEvent
+{
+	int attacker;	// 攻击者实体ID（-1表示环境）
+	int target;	// 目标实体ID
+	float amount;	// 伤害值（减免前）
+	DamageType type;	// 伤害类型
+};
+
+/// @brief 伤害队列 - 收集一帧内的所有伤害并一次性结算
+/// @details 各系统在更新过程中只追加伤害事件，由战斗系统统一结算。
+///
+/// 设计思路：
+/// 1. 事件只记录实体ID、数值和类型，追加是一次 push_back，不访问任何组件
+/// 2. 结算时按目标ID排序，同一目标的事件连续排列；世界中的实体本身按ID递增存放，
+///    两者做一次归并即可找到每个目标，不需要逐个事件查找
+/// 3. 每个目标只获取一次组件，累加减免后的伤害后扣除一次生命值，并记录最后一击的攻击者
+/// 4. 结算只修改生命值，夹紧和死亡判断由生命值系统在帧末统一完成
+///
+/// 为何这样做：
+/// - 大范围伤害命中大量目标时，总开销与事件数和实体数成线性（加排序）关系
+/// - 同一目标被多次命中只扣除一次生命值，死亡也只会在帧末被发现一次
+/// - 伤害来源与结算解耦，新的伤害来源只需追加事件
+class DamageQueue
+{
+public:
+	/// @brief 追加一个伤害事件
+	/// @param attacker [IN] 攻击者实体ID（-1表示环境）
+	/// @param target [IN] 目标实体ID
+	/// @param amount [IN] 伤害值
+	/// @param type [IN] 伤害类型
+	void push(int attacker, int target, float amount, DamageType type)
+	{
+		m_events.push_back({ attacker, target, amount, type });
+	}
+
+	/// @brief 结算所有待处理的伤害
+	/// @details 每帧只调用一次，结算后清空事件
+	/// @param world [IN] 当前游戏世界
+	void resolve(World& world);
+
+	/// @brief 获取待处理的事件数
+	size_t getPendingCount() const { return m_events.size(); }
+
+private:
+	std::vector<DamageEvent> m_events;	// 待处理的伤害事件
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "combat/DamageQueue.h"
+
+class JobSystem;
+
+/// @brief 投射物池 - 预分配的投射物存储，按SoA排列
+/// @details 投射物不是ECS实体，只是池中的一行数据，由投射物系统负责碰撞和销毁。
+///
+/// 设计思路：
+/// 1. 构造时按容量一次性分配所有数组，之后生成和销毁都不分配内存
+/// 2. 存活的投射物始终紧密排列在 [0, count) 中：生成追加到末尾，销毁把最后一个移到空位，都是 O(1)
+/// 3. 位置、速度、剩余时间各自是连续数组，积分时用 simd::float4 一次处理4个投射物
+///
+/// 为何这样做：
+/// - 暗蚀潮汐的弹幕需要同时存在数万个投射物，按实体存放的组件开销和内存分配都承受不起
+/// - 紧密排列使积分和碰撞只遍历存活的投射物，没有空洞和存活标记
+class ProjectilePool
+{
+public:
+	/// @brief 构造函数
+	/// @param capacity [IN] 最多同时存在的投射物数
+	explicit ProjectilePool(size_t capacity = 65536);
+
+	/// @brief 生成一个投射物
+	/// @param position [IN] 初始位置
+	/// @param velocity [IN] 速度
+	/// @param radius [IN] 碰撞半径
+	/// @param damage [IN] 命中伤害
+	/// @param lifetime [IN] 存活时间（秒）
+	/// @param owner [IN] 发射者实体ID，不会命中发射者
+	/// @param targetTags [IN] 可命中目标必须拥有的空间索引标签
+	/// @param type [IN] 伤害类型
+	/// @return 池已满时返回false
+	bool spawn(const glm::vec3& position, const glm::vec3& velocity, float radius, float damage, float lifetime,
+		int owner, uint32_t targetTags, DamageType type = DamageType::Physical);
+
+	/// @brief 销毁一个投射物
+	/// @details 最后一个投射物会被移到该下标，倒序遍历时可以边遍历边销毁
+	/// @param i [IN] 投射物下标
+	void despawn(size_t i);
+
+	/// @brief 销毁所有投射物
+	void clear() { m_count = 0; }
+
+	/// @brief 积分位置并扣减剩余时间
+	/// @param deltaTime [IN] 时间增量
+	/// @param jobSystem [IN] 任务系统，可为空
+	void integrate(float deltaTime, JobSystem* jobSystem);
+
+	size_t getCount() const { return m_count; }	// 存活的投射物数
+	size_t getCapacity() const { return m_capacity; }	// 容量
+
+	glm::vec3 getPosition(size_t i) const { return glm::vec3(m_posX[i], m_posY[i], m_posZ[i]); }	// 位置
+	glm::vec3 getVelocity(size_t i) const { return glm::vec3(m_velX[i], m_velY[i], m_velZ[i]); }	// 速度
+	float getRadius(size_t i) const { return m_radius[i]; }	// 碰撞半径
+	float getDamage(size_t i) const { return m_damage[i]; }	// 命中伤害
+	float getLifetime(size_t i) const { return m_lifetime[i]; }	// 剩余时间
+	int getOwner(size_t i) const { return m_owner[i]; }	// 发射者实体ID
+	uint32_t getTargetTags(size_t i) const { return m_targetTags[i]; }	// 目标标签
+	DamageType getType(size_t i) const { return m_type[i]; }	// 伤害类型
+
+private:
+	/// @brief 积分 [begin, end) 区间，begin 和 end 都是4的倍数
+	/// @param begin [IN] 起始下标
+	/// @param end [IN] 结束下标
+	/// @param deltaTime [IN] 时间增量
+	void integrateRange(size_t begin, size_t end, float deltaTime);
+
+private:
+	size_t m_capacity;	// 容量
+	size_t m_count;	// 存活的投射物数
+
+	// 数组长度为容量补齐到4的倍数，补齐部分参与积分但不会被读取
+	std::vector<float> m_posX;	// 位置X
+	std::vector<float> m_posY;	// 位置Y
+	std::vector<float> m_posZ;	// 位置Z
+	std::vector<float> m_velX;	// 速度X
+	std::vector<float> m_velY;	// 速度Y
+	std::vector<float> m_velZ;	// 速度Z
+	std::vector<float> m_lifetime;	// 剩余时间
+	std::vector<float> m_radius;	// 碰撞半径
+	std::vector<float> m_damage;	// 命中伤害
+	std::vector<int> m_owner;	// 发射者实体ID
+	std::vector<uint32_t> m_targetTags;	// 目标标签
+	std::vector<DamageType> m_type;	// 伤害类型
+};
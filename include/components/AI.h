@@ -1,8 +1,8 @@
 #pragma once
 #include "ecs/Component.h"
-#include "core/Timer.h"
 
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 /// @brief AI状态枚举
@@ -29,7 +29,7 @@ enum class AIState {
 /// - 巡逻路径的设计使AI在巡逻状态下更自然，避免重复路径导致的行为单一。
 struct AI : public Component {
 	AIState state;  // 当前状态
-	Timer stateTimer;        // 当前状态持续时间
+	float stateTime;        // 当前状态持续时间（由AI系统按时间增量累加）
 
 	// 感知参数
 	float sightRange;       // 视野范围
@@ -48,14 +48,32 @@ struct AI : public Component {
 	std::vector<glm::vec3> patrolPoints;	// 巡逻点列表
 	int currentPatrolIndex;	// 当前巡逻点索引
 
+	// 寻路
+	uint32_t pathRequest;	// 进行中的寻路请求ID（0表示无）
+	std::vector<glm::vec3> path;	// 前往当前巡逻点的路径点
+	int pathIndex;	// 当前路径点索引
+
+	// 群体转向
+	glm::vec3 desiredVelocity;	// 行为逻辑期望的速度，群体转向在此基础上修正实际速度
+
+	// 同化状态
+	float assimilatedTime;	// 被同化剩余时间（大于0时不执行行为逻辑）
+
+	// 细节层次
+	float pendingDelta;	// 自上次更新以来累积的时间（跳帧期间累加）
+
 	/// @brief 构造函数，初始化AI组件
 	/// @details 设置初始状态和参数
 	AI()
-		: state(AIState::Idle),
+		: state(AIState::Idle), stateTime(0.0f),
 		sightRange(10.0f), chaseRange(15.0f), attackRange(2.0f),
 		chaseSpeed(4.0f), patrolSpeed(2.0f),
 		idleDuration(3.0f), patrolDuration(5.0f),
-		currentPatrolIndex(0)
+		currentPatrolIndex(0),
+		pathRequest(0), pathIndex(0),
+		desiredVelocity(0.0f),
+		assimilatedTime(0.0f),
+		pendingDelta(0.0f)
 	{
 	}
 };
\ No newline at end of file
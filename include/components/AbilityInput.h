@@ -1,39 +1,46 @@
 #pragma once
 #include "ecs/Component.h"
 #include "core/AbilityTypes.h"
-
-#include <vector>
-#include <unordered_map>
+#include <bitset>
 
 /// @brief 能力输入组件 - 存储玩家的能力激活请求
 /// @details 该组件用于记录玩家希望激活的能力。可以通过系统处理这些输入来触发相应的能力效果。
 /// 
 /// 设计思路：
-/// 1. 存储玩家想要激活的能力类型
+/// 1. 存储玩家想要激活的能力类型，每种能力一位
 /// 2. 作为输入系统和能力系统之间的桥梁
 /// 
 /// 为何这样做：
 /// - 保持系统间解耦
 /// - 支持多玩家输入
 /// - 符合ECS数据驱动原则
+/// - 位集按能力下标访问，没有哈希和内存分配
 struct AbilityInput : public Component
 {
-	std::vector<AbilityType> requestedAbilities; /// 存储玩家希望激活的能力类型列表
-	std::unordered_map<AbilityType, bool> abilityTriggered; /// 存储玩家希望激活的能力类型列表
+	std::bitset<ABILITY_COUNT> requestedAbilities;	// 本帧请求激活的能力
+	std::bitset<ABILITY_COUNT> abilityTriggered;	// 按键按住期间已经请求过的能力
 
-	/// @brief 添加一个能力请求到输入列表
-	/// @details 将指定的能力类型添加到请求列表中，以便后续处理
+	/// @brief 添加一个能力请求
+	/// @details 同一帧内重复请求同一能力只记一次
 	/// @param ability [IN] 要请求的能力类型
 	void requestAbility(AbilityType ability)
 	{
-		requestedAbilities.push_back(ability);
+		requestedAbilities.set(abilityIndex(ability));
+	}
+
+	/// @brief 是否请求了指定能力
+	/// @param ability [IN] 能力类型
+	/// @return 是否请求
+	bool isRequested(AbilityType ability) const
+	{
+		return requestedAbilities.test(abilityIndex(ability));
 	}
 
 	/// @brief 清空所有能力请求
 	/// @details 清除当前所有的能力请求，以便重新开始输入收集
 	void clear()
 	{
-		requestedAbilities.clear();
+		requestedAbilities.reset();
 	}
 
 	/// @brief 设置能力点击状态
@@ -42,7 +49,7 @@ struct AbilityInput : public Component
 	/// @param triggered [IN] 是否请求过
 	void setAbilityTriggered(AbilityType type, bool triggered)
 	{
-		abilityTriggered[type] = triggered;
+		abilityTriggered.set(abilityIndex(type), triggered);
 	}
 
 	/// @brief 获取能力是否请求过
@@ -51,7 +58,6 @@ struct AbilityInput : public Component
 	/// @return true：触发过了	false：未触发
 	bool isAbilityTriggered(AbilityType type) const
 	{
-		auto it = abilityTriggered.find(type);
-		return (it != abilityTriggered.end()) ? it->second : false;
+		return abilityTriggered.test(abilityIndex(type));
 	}
-};
\ No newline at end of file
+};
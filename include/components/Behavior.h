@@ -0,0 +1,32 @@
+#pragma once
+#include "ecs/Component.h"
+
+#include <cstdint>
+
+/// @brief 行为组件 - 由数据驱动的行为树控制实体
+/// @details 拥有该组件的AI实体不再执行内置状态机，而是每次更新时执行指定的行为树。
+/// 
+/// 设计思路：
+/// 1. 只记录行为树ID和每个实体自己的运行状态，行为树本身由所有实体共享
+/// 2. 黑板是组件内的定长数组，槽位由行为树编译时分配给需要记忆的节点（如计时）
+/// 3. 记录正在运行的叶子节点，下次更新直接从该节点继续
+/// 
+/// 为何这样做：
+/// - 每个实体的运行状态紧凑连续，不做任何堆分配
+/// - 恢复运行节点时不需要从根节点重新遍历整棵树
+struct Behavior : public Component
+{
+	static const int BlackboardSize = 8;	// 黑板槽位数
+	static const uint16_t NoNode = 0xFFFF;	// 没有正在运行的节点
+
+	int tree;	// 行为树ID
+	uint16_t running;	// 正在运行的叶子节点下标
+	float blackboard[BlackboardSize];	// 黑板
+
+	/// @brief 构造函数
+	/// @param tree [IN] 行为树ID，-1表示未指定
+	explicit Behavior(int tree = -1)
+		: tree(tree), running(NoNode), blackboard{}
+	{
+	}
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "ecs/Component.h"
+
+/// @brief 碰撞体组件 - 描述实体的碰撞形状和休眠状态
+/// @details 形状为竖直胶囊体，从实体位置向上延伸 height，高度不超过直径时退化为球体。
+/// 
+/// 设计思路：
+/// 1. 使用竖直胶囊体近似角色，半径决定XZ平面上的占地
+/// 2. 质量倒数为0表示静态物体，不会被推动
+/// 3. 记录休眠状态，静止成组的实体不再参与碰撞求解
+/// 
+/// 为何这样做：
+/// - 胶囊体之间的距离计算简单且稳定
+/// - 休眠让大量静止敌人几乎不产生开销
+struct Collider : public Component
+{
+	float radius;	// 半径
+	float height;	// 总高度（从实体位置向上）
+	float inverseMass;	// 质量倒数（0为静态）
+
+	bool sleeping;	// 是否处于休眠
+	float sleepTimer;	// 持续静止的时间
+
+	/// @brief 默认构造函数
+	/// @details 初始化为半径0.5、高度1的可移动胶囊体
+	Collider()
+		: radius(0.5f), height(1.0f), inverseMass(1.0f), sleeping(false), sleepTimer(0.0f)
+	{
+	}
+	/// @brief 带参数的构造函数
+	/// @details 用于自定义碰撞体形状和质量
+	/// @param radius [IN] 半径
+	/// @param height [IN] 总高度
+	/// @param inverseMass [IN] 质量倒数
+	Collider(float radius, float height, float inverseMass)
+		: radius(radius), height(height), inverseMass(inverseMass), sleeping(false), sleepTimer(0.0f)
+	{
+	}
+};
@@ -2,50 +2,53 @@
 #include "ecs/Component.h"
 #include "core/AbilityTypes.h"
 
-#include <unordered_map>
-
 /// @brief 冷却时间组件 - 管理能力的冷却状态
-/// @details 该组件存储每个能力的冷却时间，允许检查和更新冷却状态。
+/// @details 该组件按能力下标存储每个能力冷却结束的时刻，时刻以能力系统的时钟为准。
 /// 
 /// 设计思路：
-/// 1. 存储各能力的剩余冷却时间
-/// 2. 提供冷却状态查询
+/// 1. 记录冷却结束时刻而不是剩余时间，冷却中不需要每帧递减
+/// 2. 以能力类型为下标的定长数组，查询不需要哈希
 /// 
 /// 为何这样做：
 /// - 防止能力滥用
 /// - 增加策略性
+/// - 持有该组件的实体每帧没有任何冷却相关的开销
 struct Cooldown : public Component
 {
-	std::unordered_map<AbilityType, float> cooldowns;	// 能力冷却时间映射
+	float readyTimes[ABILITY_COUNT];	// 每个能力冷却结束的时刻
+
+	Cooldown()
+		: readyTimes{}
+	{
+	}
 
 	/// @brief 设置指定能力的冷却时间
-	/// @details 设置指定能力的冷却时间，单位为秒。
+	/// @details 冷却在 now + duration 时刻结束，单位为秒。
 	/// @param type [IN] 能力类型
+	/// @param now [IN] 当前时刻
 	/// @param duration [IN] 冷却持续时间
-	void setCooldown(AbilityType type, float duration)
+	void setCooldown(AbilityType type, float now, float duration)
 	{
-		cooldowns[type] = duration;
+		readyTimes[abilityIndex(type)] = now + duration;
 	}
 
-	/// @brief 更新冷却时间
-	/// @details 每帧调用，减少各能力的冷却时间。
-	/// @param deltaTime [IN] 时间增量，单位为秒
-	void update(float deltaTime)
+	/// @brief 检查指定能力是否在冷却中
+	/// @details 当前时刻早于冷却结束时刻即为冷却中。
+	/// @param type [IN] 能力类型
+	/// @param now [IN] 当前时刻
+	/// @return 如果在冷却中返回true，否则返回false
+	bool isOnCooldown(AbilityType type, float now) const
 	{
-		for (auto& pair : cooldowns) {
-			if (pair.second > 0) {
-				pair.second -= deltaTime;
-			}
-		}
+		return now < readyTimes[abilityIndex(type)];
 	}
 
-	/// @brief 检查指定能力是否在冷却中
-	/// @details 检查指定能力的冷却时间是否大于0。
+	/// @brief 获取指定能力的剩余冷却时间
 	/// @param type [IN] 能力类型
-	/// @return 如果在冷却中返回true，否则返回false
-	bool isOnCooldown(AbilityType type) const
+	/// @param now [IN] 当前时刻
+	/// @return 剩余冷却时间，不在冷却中时为0
+	float getRemaining(AbilityType type, float now) const
 	{
-		auto it = cooldowns.find(type);
-		return it != cooldowns.end() && it->second > 0;
+		const float remaining = readyTimes[abilityIndex(type)] - now;
+		return remaining > 0.0f ? remaining : 0.0f;
 	}
-};
\ No newline at end of file
+};
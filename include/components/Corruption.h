@@ -1,7 +1,19 @@
 #pragma once
 #include "ecs/Component.h"
-#include "core/Timer.h"
+#include "core/EventQueue.h"
 
+/// @brief 腐蚀度组件 - 保存实体的腐蚀度和所处的腐蚀阶段
+/// @details 腐蚀度只能通过 set/add 修改，修改时重新判断阶段，阶段变化时向绑定的队列追加 StageChanged 事件。
+///
+/// 设计思路：
+/// 1. 阶段按阈值划分为连续的区间：(0, 低) 低腐蚀，[低, 中) 中腐蚀，[中, 高) 高腐蚀，[高, ∞) 临界，
+///    其余为无腐蚀，任何腐蚀度都恰好属于一个阶段
+/// 2. 阶段随腐蚀度一起更新并缓存，读取阶段不再重新判断
+/// 3. 组件由腐蚀系统绑定实体ID和事件队列；绑定前发生的变化在绑定时补发
+///
+/// 为何这样做：
+/// - 阶段切换在写入腐蚀度的那一刻被精确发现，阈值上的取值不会落入空档
+/// - 腐蚀度不变的实体不产生任何开销，腐蚀系统只处理事件
 struct Corruption : public Component
 {
 	/// @brief 腐蚀阶段
@@ -15,56 +27,113 @@ struct Corruption : public Component
 		Critical  // 危险腐蚀效果
 	};
 
-	float current; // 当前腐蚀度
-	float lowThreshold; // 低腐蚀度阈值
-	float mediumThreshold; // 中腐蚀度阈值
-	float highThreshold;  // 高腐蚀阶段阈值
-
-	Stage stage; // 当前腐蚀阶段
-	Stage lastStage; // 上次腐蚀阶段（用于判断阶段变化）
-	Timer effectTimer; // 效果触发计时器
+	/// @brief 阶段变化事件
+	struct StageChanged
+	{
+		int entity;	// 实体ID
+		Stage from;	// 原阶段
+		Stage to;	// 新阶段
+	};
 
 	/// @brief 默认构造函数
 	/// @details 初始化腐蚀度为0，阈值为默认值
 	Corruption()
-		: current(0.0f), lowThreshold(30.0f), mediumThreshold(70.0f), highThreshold(90.0f)
+		: m_current(0.0f), m_lowThreshold(30.0f), m_mediumThreshold(70.0f), m_highThreshold(90.0f),
+		m_stage(None), m_entity(-1), m_pEvents(nullptr)
 	{
 	}
 	/// @brief 带参数的构造函数
-	/// @details 初始化腐蚀度和阈值，并更新效果标志
+	/// @details 初始化腐蚀度和阈值，并计算初始阶段
 	/// @param initial 初始腐蚀度
 	/// @param low 低腐蚀度阈值
 	/// @param medium 中腐蚀度阈值
 	/// @param high 高腐蚀度阈值
 	Corruption(float initial, float low, float medium, float high)
-		: current(initial), lowThreshold(low), mediumThreshold(medium), highThreshold(high)
+		: m_current(initial > 0.0f ? initial : 0.0f), m_lowThreshold(low), m_mediumThreshold(medium), m_highThreshold(high),
+		m_stage(stageOf(m_current, low, medium, high)), m_entity(-1), m_pEvents(nullptr)
 	{
 	}
 
-	/// @brief 获取腐蚀阶段
-	/// @details 根据当前腐蚀度获取当前腐蚀阶段
-	/// @return 当前腐蚀阶段
-	Stage getStage() const {
-		if (current > 0.0f && current < lowThreshold) return Low;
-		if (current > lowThreshold && current < mediumThreshold) return Medium;
-		if (current > mediumThreshold && current < highThreshold) return High;
-		if (current > highThreshold) return Critical;
+	/// @brief 按阈值判断腐蚀度所处的阶段
+	/// @param value [IN] 腐蚀度
+	/// @param low [IN] 低腐蚀度阈值
+	/// @param medium [IN] 中腐蚀度阈值
+	/// @param high [IN] 高腐蚀度阈值
+	/// @return 腐蚀阶段
+	static Stage stageOf(float value, float low, float medium, float high)
+	{
+		if (value >= high) return Critical;
+		if (value >= medium) return High;
+		if (value >= low) return Medium;
+		if (value > 0.0f) return Low;
 		return None;
 	}
 
-	/// @brief 检查腐蚀阶段是否发生变化
-	/// @details 比较当前阶段和上次阶段，如果不同则返回 true
-	/// @return 是否发生变化
-	bool stageChanged() const {
-		return stage != lastStage;
+	/// @brief 获取当前腐蚀度
+	float getCurrent() const { return m_current; }
+
+	/// @brief 获取腐蚀阶段
+	Stage getStage() const { return m_stage; }
+
+	float getLowThreshold() const { return m_lowThreshold; }
+	float getMediumThreshold() const { return m_mediumThreshold; }
+	float getHighThreshold() const { return m_highThreshold; }
+
+	/// @brief 设置腐蚀度
+	/// @details 腐蚀度不低于0，阶段变化时追加事件
+	/// @param value [IN] 新的腐蚀度
+	void set(float value)
+	{
+		m_current = value > 0.0f ? value : 0.0f;
+		refreshStage();
 	}
 
-	/// @brief 更新腐蚀阶段并返回是否发生变化
-	/// @details 更新当前阶段和上次阶段，并返回是否发生变化
-	/// @return 是否发生变化
-	bool updateStage() {
-		lastStage = stage;
-		stage = getStage();
-		return stageChanged();
+	/// @brief 增加腐蚀度
+	/// @param delta [IN] 增量，负数为减少
+	void add(float delta) { set(m_current + delta); }
+
+	/// @brief 设置阈值
+	/// @param low [IN] 低腐蚀度阈值
+	/// @param medium [IN] 中腐蚀度阈值
+	/// @param high [IN] 高腐蚀度阈值
+	void setThresholds(float low, float medium, float high)
+	{
+		m_lowThreshold = low;
+		m_mediumThreshold = medium;
+		m_highThreshold = high;
+		refreshStage();
+	}
+
+	/// @brief 绑定实体ID和事件队列
+	/// @details 尚未绑定时已经离开无腐蚀阶段的，补发一次从无腐蚀开始的变化
+	/// @param entity [IN] 实体ID
+	/// @param events [IN] 阶段变化事件队列
+	void bind(int entity, EventQueue<StageChanged>* events)
+	{
+		const bool wasBound = m_pEvents != nullptr;
+		m_entity = entity;
+		m_pEvents = events;
+		if (!wasBound && m_pEvents && m_stage != None) {
+			m_pEvents->push({ m_entity, None, m_stage });
+		}
 	}
-};
\ No newline at end of file
+
+private:
+	/// @brief 重新判断阶段，变化时追加事件
+	void refreshStage()
+	{
+		const Stage stage = stageOf(m_current, m_lowThreshold, m_mediumThreshold, m_highThreshold);
+		if (stage == m_stage) return;
+		if (m_pEvents) m_pEvents->push({ m_entity, m_stage, stage });
+		m_stage = stage;
+	}
+
+private:
+	float m_current; // 当前腐蚀度
+	float m_lowThreshold; // 低腐蚀度阈值
+	float m_mediumThreshold; // 中腐蚀度阈值
+	float m_highThreshold;  // 高腐蚀阶段阈值
+	Stage m_stage; // 当前腐蚀阶段
+	int m_entity;	// 所属实体ID，未绑定时为-1
+	EventQueue<StageChanged>* m_pEvents;	// 阶段变化事件队列，未绑定时为空
+};
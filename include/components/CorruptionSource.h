@@ -14,14 +14,15 @@
 /// - 实现动态环境威胁
 /// - 为腐蚀系统提供环境来源
 struct CorruptionSource : public Component {
-    float power;    // 腐蚀强度
+    float power;    // 腐蚀强度（叠加属性修正后的值）
+    float basePower;    // 基础腐蚀强度（随时间增长，不受潮汐等修正影响）
     float radius;     // 影响范围（单位）
     Timer pulseTimer; // 脉冲计时器
 
 	/// @brief 默认构造函数
 	/// @details 初始化默认腐蚀强度和范围
     CorruptionSource()
-        : power(20.0f), radius(8.0f)
+        : power(20.0f), basePower(20.0f), radius(8.0f)
     {
 	}
 	/// @brief 带参数的构造函数
@@ -29,6 +30,6 @@ struct CorruptionSource : public Component {
 	/// @param power [IN] 腐蚀强度
 	/// @param radius [IN] 影响范围
     CorruptionSource(float power, float radius)
-        : power(power), radius(radius) {
+        : power(power), basePower(power), radius(radius) {
     }
 };
\ No newline at end of file
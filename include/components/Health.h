@@ -1,32 +1,71 @@
 #pragma once
+#include <cstdint>
+
 #include "ecs/Component.h"
+#include "ecs/World.h"
+#include "components/HealthStore.h"
 
 /// @brief 生命值组件 - 表示实体的生命值状态
-/// @details 包含当前生命值、最大生命值和基础最大生命值（不受腐蚀影响）
-/// 
+/// @details 包含当前生命值、最大生命值和基础最大生命值（不受腐蚀影响），
+/// 数值存放在所属世界的 HealthStore 中，组件只保存槽位并提供读写接口
+///
 /// 设计思路：
 /// 1. 存储当前生命值和最大值
 /// 2. 提供基础生命值和临时修改
-/// 
+/// 3. 数值按列连续存放，由生命值系统在帧末统一夹紧并发现死亡
+///
 /// 为何这样做：
 /// - 统一管理生命值状态
 /// - 支持腐蚀系统对生命值的修改
+/// - 修改生命值的代码不需要各自判断死亡
 struct Health : public Component {
-	float current;	// 当前生命值
-	float max;	// 最大生命值
-	float baseMax;	// 基础最大生命值（不受腐蚀影响）
-
-	/// @brief 默认构造函数
-	/// @details 初始化当前生命值和最大生命值为100.0f，基础最大生命值也为100.0f
-	Health()
-		: current(100.0f), max(100.0f), baseMax(100.0f)
-	{}
-	/// @brief 带参数的构造函数
-	/// @details 用于初始化生命值状态
+	/// @brief 构造函数
+	/// @details 在实体所属世界的生命值存储中分配槽位，实体必须已经关联世界
+	/// @param owner [IN] 所属实体
 	/// @param current [IN] 当前生命值
 	/// @param max [IN] 最大生命值
 	/// @param baseMax [IN] 基础最大生命值（不受腐蚀影响）
-	Health(float current, float max, float baseMax)
-		: current(current), max(max), baseMax(baseMax) {
+	explicit Health(Entity& owner, float current = 100.0f, float max = 100.0f, float baseMax = 100.0f)
+		: m_pStore(&owner.getWorld().getHealthStore()), m_slot(m_pStore->allocate(&owner, current, max, baseMax))
+	{
+	}
+
+	/// @brief 析构函数
+	/// @details 归还槽位
+	~Health() override { m_pStore->release(m_slot); }
+
+	Health(const Health&) = delete;
+	Health& operator=(const Health&) = delete;
+
+	float getCurrent() const { return m_pStore->getCurrent()[m_slot]; }	// 当前生命值
+	float getMax() const { return m_pStore->getMax()[m_slot]; }	// 最大生命值
+	float getBaseMax() const { return m_pStore->getBaseMax()[m_slot]; }	// 基础最大生命值
+
+	/// @brief 设置当前生命值
+	/// @details 不做夹紧，帧末统一夹紧到 [0, 最大值]；恢复到正数时重新视为存活
+	/// @param value [IN] 当前生命值
+	void setCurrent(float value)
+	{
+		m_pStore->getCurrent()[m_slot] = value;
+		if (value > 0.0f) m_pStore->getReported()[m_slot] = 0.0f;
 	}
-};
\ No newline at end of file
+
+	/// @brief 设置最大生命值
+	void setMax(float value) { m_pStore->getMax()[m_slot] = value; }
+
+	/// @brief 设置基础最大生命值
+	void setBaseMax(float value) { m_pStore->getBaseMax()[m_slot] = value; }
+
+	/// @brief 扣除生命值并记录攻击者
+	/// @param amount [IN] 伤害值
+	/// @param attacker [IN] 攻击者实体ID（-1表示环境）
+	void damage(float amount, int attacker)
+	{
+		m_pStore->getCurrent()[m_slot] -= amount;
+		m_pStore->lastAttacker(m_slot) = attacker;
+	}
+
+private:
+	HealthStore* m_pStore;	// 所属世界的生命值存储
+	uint32_t m_slot;	// 在存储中的槽位
+};
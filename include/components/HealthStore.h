@@ -0,0 +1,98 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 前向声明
+class Entity;
+
+/// @brief 死亡事件
+struct DeathEvent
+{
+	int entity;	// 死亡的实体ID
+	int killer;	// 造成最后一击的实体ID（-1表示环境）
+};
+
+/// @brief 生命值存储 - 世界中所有 Health 组件的数值按列连续存放
+/// @details Health 组件只保存槽位，当前值、最大值、基础最大值分别存放在三个连续数组中，
+/// 死亡扫描直接以4路SIMD遍历这些数组。
+///
+/// 设计思路：
+/// 1. 槽位在组件构造时分配、析构时归还，空闲槽位放入空闲列表复用，组件指针始终有效
+/// 2. 数组长度始终是4的倍数，空闲和补齐的槽位标记为已上报死亡，扫描时不会被当作新死亡
+/// 3. 每个槽位记录所属实体和最后一次造成伤害的实体，死亡时据此生成死亡事件
+///
+/// 为何这样做：
+/// - 死亡判断只剩一次连续数组上的向量化扫描，不需要逐个实体查找组件
+/// - 任何修改生命值的代码路径都只写数值，死亡统一在扫描时发现，不会遗漏
+class HealthStore
+{
+public:
+	/// @brief 分配一个槽位
+	/// @param owner [IN] 所属实体
+	/// @param current [IN] 当前生命值
+	/// @param max [IN] 最大生命值
+	/// @param baseMax [IN] 基础最大生命值
+	/// @return 槽位
+	uint32_t allocate(Entity* owner, float current, float max, float baseMax)
+	{
+		if (m_free.empty()) {
+			// 一次扩充4个槽位，保持数组长度是4的倍数
+			const uint32_t begin = static_cast<uint32_t>(m_current.size());
+			grow(begin + 4);
+			for (uint32_t slot = begin + 4; slot > begin; --slot) m_free.push_back(slot - 1);
+		}
+		const uint32_t slot = m_free.back();
+		m_free.pop_back();
+
+		m_current[slot] = current;
+		m_max[slot] = max;
+		m_baseMax[slot] = baseMax;
+		m_reported[slot] = 0.0f;
+		m_owners[slot] = owner;
+		m_lastAttackers[slot] = -1;
+		return slot;
+	}
+
+	/// @brief 归还槽位
+	/// @param slot [IN] 槽位
+	void release(uint32_t slot)
+	{
+		m_current[slot] = 0.0f;
+		m_max[slot] = 0.0f;
+		m_reported[slot] = 1.0f;
+		m_owners[slot] = nullptr;
+		m_free.push_back(slot);
+	}
+
+	/// @brief 获取槽位数，始终是4的倍数
+	size_t getCapacity() const { return m_current.size(); }
+
+	float* getCurrent() { return m_current.data(); }	// 当前生命值数组
+	float* getMax() { return m_max.data(); }	// 最大生命值数组
+	float* getBaseMax() { return m_baseMax.data(); }	// 基础最大生命值数组
+	float* getReported() { return m_reported.data(); }	// 死亡是否已上报（0或1）
+	Entity* getOwner(uint32_t slot) const { return m_owners[slot]; }	// 槽位所属实体
+	int& lastAttacker(uint32_t slot) { return m_lastAttackers[slot]; }	// 最后一次造成伤害的实体ID
+
+private:
+	/// @brief 扩充数组，新槽位按空闲槽位初始化
+	void grow(size_t size)
+	{
+		m_current.resize(size, 0.0f);
+		m_max.resize(size, 0.0f);
+		m_baseMax.resize(size, 0.0f);
+		m_reported.resize(size, 1.0f);
+		m_owners.resize(size, nullptr);
+		m_lastAttackers.resize(size, -1);
+	}
+
+private:
+	std::vector<float> m_current;	// 当前生命值
+	std::vector<float> m_max;	// 最大生命值
+	std::vector<float> m_baseMax;	// 基础最大生命值
+	std::vector<float> m_reported;	// 死亡已上报为1，存活或尚未上报为0
+	std::vector<Entity*> m_owners;	// 所属实体
+	std::vector<int> m_lastAttackers;	// 最后一次造成伤害的实体ID
+	std::vector<uint32_t> m_free;	// 空闲槽位
+};
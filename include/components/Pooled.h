@@ -0,0 +1,17 @@
+#pragma once
+#include "ecs/Component.h"
+
+/// @brief 池化标记组件
+/// @details 这是一个空的标记组件，用于标识由对象池创建的实体。
+/// 
+/// 设计思路：
+/// 1. 对象池创建的实体带有该标记
+/// 2. 实体销毁时，对象池据此把实体收回而不是释放
+/// 
+/// 为何这样做：
+/// - 其他系统照常标记销毁，不需要知道实体来自对象池
+/// - 池外创建的同类实体仍按原来的方式释放
+class Pooled : public Component
+{
+	// 空组件，仅作为标记
+};
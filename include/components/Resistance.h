@@ -0,0 +1,23 @@
+#pragma once
+#include "ecs/Component.h"
+#include "combat/DamageQueue.h"
+
+/// @brief 抗性组件 - 按伤害类型减免受到的伤害
+/// @details 每种伤害类型一个减免比例，0为不减免，1为完全免疫；没有该组件的实体不减免任何伤害。
+struct Resistance : public Component
+{
+	float values[static_cast<int>(DamageType::Count)];	// 每种伤害类型的减免比例
+
+	Resistance()
+		: values{}
+	{
+	}
+
+	/// @brief 设置某种伤害类型的减免比例
+	/// @param type [IN] 伤害类型
+	/// @param value [IN] 减免比例
+	void set(DamageType type, float value)
+	{
+		values[static_cast<int>(type)] = value;
+	}
+};
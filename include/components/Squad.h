@@ -0,0 +1,38 @@
+#pragma once
+#include "ecs/Component.h"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+/// @brief 小队成员 - 合并进小队的单个敌人的数据
+struct SquadMember
+{
+	glm::vec3 offset;	// 相对小队中心的偏移
+	float health;	// 当前生命值
+	float maxHealth;	// 最大生命值
+	float baseMaxHealth;	// 基础最大生命值
+};
+
+/// @brief 小队组件 - 把远处的一群敌人聚合成一个实体
+/// @details 远离玩家的敌人被合并为一个小队，整体移动；玩家接近时按记录的偏移和生命值拆回单个敌人。
+/// 小队延续成员的巡逻意图，以巡逻速度在组建位置附近的随机路点之间游荡，不会主动靠近玩家。
+/// 
+/// 设计思路：
+/// 1. 小队只保存重建成员所需的最少数据：相对偏移和生命值
+/// 2. 成员按值存放在连续数组中，合并和拆分都只是追加和遍历
+/// 
+/// 为何这样做：
+/// - 远处敌人的个体行为玩家看不到，整体模拟即可
+/// - 模拟开销随小队数量而不是敌人数量增长
+struct Squad : public Component
+{
+	std::vector<SquadMember> members;	// 成员
+	float speed;	// 整体移动速度
+	glm::vec3 anchor;	// 游荡中心，即组建时成员的中心
+	glm::vec3 waypoint;	// 当前前往的路点
+
+	Squad()
+		: speed(1.5f), anchor(0.0f), waypoint(0.0f)
+	{
+	}
+};
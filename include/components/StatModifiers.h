@@ -0,0 +1,205 @@
+#pragma once
+#include "ecs/Component.h"
+
+#include <vector>
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief 属性修正组件 - 保存实体上所有生效中的属性修正，并缓存折叠后的结果
+/// @details 每条修正记录目标属性、运算方式、数值、来源和到期时刻。派生值 = (基础值 + Σ加法) × Π乘法，
+/// 存在覆盖修正时直接取最后添加的覆盖值。
+///
+/// 设计思路：
+/// 1. 同一来源对同一属性最多一条修正，来源再次设置时原地替换，数值不变时什么也不做
+/// 2. 修正集合变化时只把对应属性标记为脏，折叠推迟到下次读取时进行
+/// 3. 限时修正的到期时刻记在组件自己的时钟上，只有存在限时修正时时钟才会推进
+///
+/// 为何这样做：
+/// - 腐蚀、潮汐等效果不再每帧从头重算最大生命值、恢复速率和腐蚀强度
+/// - 效果结束时移除修正即可恢复，不会像直接相乘那样永久累积
+/// - 没有修正变化的实体每帧只需要一次位掩码判断
+struct StatModifiers : public Component
+{
+	/// @brief 可被修正的属性
+	enum Stat
+	{
+		MaxHealth,			// Health::max，基础值为 Health::baseMax
+		EnergyRecovery,		// DarkEnergy::recoveryRate，基础值为 DarkEnergy::baseRecoveryRate
+		CorruptionPower,	// CorruptionSource::power，基础值为 CorruptionSource::basePower
+		StatCount
+	};
+
+	/// @brief 修正的运算方式
+	enum Op
+	{
+		Add,		// 加到基础值上
+		Multiply,	// 乘到（基础值 + 加法）上
+		Override	// 直接替换结果
+	};
+
+	/// @brief 修正来源
+	enum Source : uint32_t
+	{
+		SourceCorruption = 1,	// 腐蚀阶段效果
+		SourceDarkTide,			// 暗蚀潮汐
+		SourceAbility = 16		// 能力效果，加上能力类型下标区分不同能力
+	};
+
+	/// @brief 一条修正
+	struct Modifier
+	{
+		Stat stat;	// 目标属性
+		Op op;	// 运算方式
+		float value;	// 数值
+		uint32_t source;	// 来源
+		float expiry;	// 到期时刻（组件时钟），FLT_MAX 表示永久
+	};
+
+	/// @brief 某个属性折叠后的修正
+	struct Folded
+	{
+		float add;	// 加法之和
+		float mul;	// 乘法之积
+		float override;	// 覆盖值
+		bool hasOverride;	// 是否存在覆盖
+	};
+
+	std::vector<Modifier> modifiers;	// 生效中的修正
+	Folded folded[StatCount];	// 每个属性折叠后的修正
+	uint32_t dirtyMask;	// 修正集合变化、尚未重新折叠的属性
+	uint32_t pendingMask;	// 修正集合变化、派生值尚未写回组件的属性
+	float clock;	// 组件时钟，只在存在限时修正时推进
+	float nextExpiry;	// 最早的到期时刻
+
+	StatModifiers()
+		: folded{}, dirtyMask(0), pendingMask(0), clock(0.0f), nextExpiry(FLT_MAX)
+	{
+		for (Folded& f : folded) {
+			f.mul = 1.0f;
+		}
+	}
+
+	/// @brief 设置某个来源对某个属性的修正
+	/// @details 已存在时原地替换，运算方式、数值和时长都不变时不标记脏
+	/// @param stat [IN] 目标属性
+	/// @param op [IN] 运算方式
+	/// @param value [IN] 数值
+	/// @param source [IN] 来源
+	/// @param duration [IN] 持续时间（秒），小于等于0表示永久
+	/// @return 修正集合是否发生变化
+	bool set(Stat stat, Op op, float value, uint32_t source, float duration = 0.0f)
+	{
+		const float expiry = duration > 0.0f ? clock + duration : FLT_MAX;
+		for (Modifier& modifier : modifiers) {
+			if (modifier.stat != stat || modifier.source != source) continue;
+			if (modifier.op == op && modifier.value == value && modifier.expiry == expiry) return false;
+
+			modifier.op = op;
+			modifier.value = value;
+			modifier.expiry = expiry;
+			refreshExpiry();
+			markDirty(stat);
+			return true;
+		}
+
+		modifiers.push_back(Modifier{ stat, op, value, source, expiry });
+		if (expiry < nextExpiry) nextExpiry = expiry;
+		markDirty(stat);
+		return true;
+	}
+
+	/// @brief 移除某个来源的所有修正
+	/// @param source [IN] 来源
+	/// @return 是否移除了修正
+	bool removeSource(uint32_t source)
+	{
+		bool removed = false;
+		for (size_t i = 0; i < modifiers.size();) {
+			if (modifiers[i].source == source) {
+				markDirty(modifiers[i].stat);
+				modifiers.erase(modifiers.begin() + i);
+				removed = true;
+			}
+			else {
+				++i;
+			}
+		}
+		if (removed) refreshExpiry();
+		return removed;
+	}
+
+	/// @brief 推进组件时钟并移除到期的修正
+	/// @param deltaTime [IN] 时间增量
+	/// @return 是否有修正到期
+	bool advance(float deltaTime)
+	{
+		if (nextExpiry == FLT_MAX) return false;
+
+		clock += deltaTime;
+		if (clock < nextExpiry) return false;
+
+		for (size_t i = 0; i < modifiers.size();) {
+			if (modifiers[i].expiry <= clock) {
+				markDirty(modifiers[i].stat);
+				modifiers.erase(modifiers.begin() + i);
+			}
+			else {
+				++i;
+			}
+		}
+		refreshExpiry();
+		return true;
+	}
+
+	/// @brief 把折叠后的修正作用到基础值上
+	/// @details 属性为脏时先重新折叠，之后的调用只是一次乘加
+	/// @param stat [IN] 属性
+	/// @param base [IN] 基础值
+	/// @return 派生值
+	float apply(Stat stat, float base)
+	{
+		const uint32_t bit = 1u << stat;
+		if (dirtyMask & bit) {
+			fold(stat);
+			dirtyMask &= ~bit;
+		}
+
+		const Folded& f = folded[stat];
+		return f.hasOverride ? f.override : (base + f.add) * f.mul;
+	}
+
+private:
+	/// @brief 标记属性为脏
+	/// @param stat [IN] 属性
+	void markDirty(Stat stat)
+	{
+		dirtyMask |= 1u << stat;
+		pendingMask |= 1u << stat;
+	}
+
+	/// @brief 重新折叠某个属性的所有修正
+	/// @param stat [IN] 属性
+	void fold(Stat stat)
+	{
+		Folded f{ 0.0f, 1.0f, 0.0f, false };
+		for (const Modifier& modifier : modifiers) {
+			if (modifier.stat != stat) continue;
+			switch (modifier.op) {
+			case Add:		f.add += modifier.value; break;
+			case Multiply:	f.mul *= modifier.value; break;
+			case Override:	f.override = modifier.value; f.hasOverride = true; break;
+			}
+		}
+		folded[stat] = f;
+	}
+
+	/// @brief 重新求最早的到期时刻
+	void refreshExpiry()
+	{
+		nextExpiry = FLT_MAX;
+		for (const Modifier& modifier : modifiers) {
+			if (modifier.expiry < nextExpiry) nextExpiry = modifier.expiry;
+		}
+	}
+};
@@ -1,11 +1,21 @@
 #pragma once
+#include <cstddef>
 
 /// @brief 能力类型枚举 - 定义界痕使的能力
-/// @details 每种能力对应不同的效果和用途
+/// @details 每种能力对应不同的效果和用途，枚举值同时是能力表、冷却数组和请求位集的下标
 enum class AbilityType {
     Perception,     // 感知：显示隐藏元素
     Manipulation,   // 操控：移动物体
     Distortion,     // 扭曲：改变重力
     Assimilation,   // 同化：控制敌人
-    Purification    // 净化：减少腐蚀
-};
\ No newline at end of file
+    Purification,   // 净化：减少腐蚀
+    Count           // 能力数量，不是有效能力
+};
+
+/// @brief 能力数量
+constexpr size_t ABILITY_COUNT = static_cast<size_t>(AbilityType::Count);
+
+/// @brief 能力类型转下标
+/// @param type [IN] 能力类型
+/// @return 下标
+constexpr size_t abilityIndex(AbilityType type) { return static_cast<size_t>(type); }
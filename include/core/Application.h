@@ -9,6 +9,19 @@
 // 前向声明
 class InputMap;
 class Logger;
+class SpatialIndex;
+class CorruptionField;
+class CorruptionDiffusion;
+class JobSystem;
+class DistortionEffects;
+class InfluenceMap;
+class DamageQueue;
+class ProjectilePool;
+class NavGrid;
+class FlowField;
+class Pathfinder;
+class BehaviorTreeLibrary;
+class EffectLibrary;
 
 /// @brief 应用程序类 - 管理整个游戏生命周期
 /// @details 该类负责初始化SDL和OpenGL环境，处理事件循环，并在应用程序退出时清理资源。
@@ -74,6 +87,19 @@ private:
 	bool m_bIsRunning;	// 应用程序是否正在运行标志
 
 	std::unique_ptr<InputMap> m_pInputMap;	// 输入映射
+	std::unique_ptr<SpatialIndex> m_pSpatialIndex;	// 空间索引，由多个系统共享
+	std::unique_ptr<JobSystem> m_pJobSystem;	// 任务系统，由多个系统共享工作线程
+	std::unique_ptr<CorruptionField> m_pCorruptionField;	// 腐蚀场，由环境系统写入、渲染等系统读取
+	std::unique_ptr<CorruptionDiffusion> m_pCorruptionDiffusion;	// 腐蚀扩散场
+	std::unique_ptr<DistortionEffects> m_pDistortionEffects;	// 空间扭曲效果，由扭曲系统写入、移动系统读取
+	std::unique_ptr<InfluenceMap> m_pInfluenceMap;	// 影响力图，由影响力系统更新、AI和环境系统采样
+	std::unique_ptr<DamageQueue> m_pDamageQueue;	// 伤害队列，各系统追加、战斗系统结算
+	std::unique_ptr<ProjectilePool> m_pProjectiles;	// 投射物池，远程攻击发射、投射物系统推进
+	std::unique_ptr<NavGrid> m_pNavGrid;	// 导航网格
+	std::unique_ptr<FlowField> m_pFlowField;	// 指向玩家的流场，由导航系统更新、AI系统读取
+	std::unique_ptr<Pathfinder> m_pPathfinder;	// 寻路服务，由导航系统推进、AI系统请求
+	std::unique_ptr<BehaviorTreeLibrary> m_pBehaviorTrees;	// 行为树库，由AI系统执行
+	std::unique_ptr<EffectLibrary> m_pEffects;	// 能力效果库，由能力系统执行
 	
 	Timer m_frameTimer;	// 帧率计时器
 	Logger* m_pLogger;	// 日志记录器
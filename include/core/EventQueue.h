@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+
+/// @brief 类型化事件队列 - 生产者追加事件，由唯一的消费者在自己的更新中集中处理
+/// @details 事件按追加顺序保存，消费者遍历后清空；容器只在第一次达到新的峰值时分配内存。
+///
+/// 设计思路：
+/// 1. 每种事件一个队列，事件本身是只包含实体ID和数值的小结构
+/// 2. 追加只是一次 push_back，生产者不需要知道谁在消费
+/// 3. 清空保留容量，稳定运行后不再分配内存
+///
+/// 为何这样做：
+/// - 状态变化只在真正发生时产生事件，消费者不必每帧轮询所有实体
+/// - 生产者和消费者的更新顺序无关，本帧之后追加的事件下一帧处理
+/// @tparam T [IN] 事件类型
+template <typename T>
+class EventQueue
+{
+public:
+	/// @brief 追加一个事件
+	/// @param event [IN] 事件
+	void push(const T& event) { m_events.push_back(event); }
+
+	/// @brief 获取待处理的事件
+	const std::vector<T>& getEvents() const { return m_events; }
+
+	/// @brief 是否没有待处理的事件
+	bool empty() const { return m_events.empty(); }
+
+	/// @brief 清空已处理的事件
+	void clear() { m_events.clear(); }
+
+private:
+	std::vector<T> m_events;	// 待处理的事件
+};
@@ -28,6 +28,7 @@ public:
 		MoveRight,		// 向右转向
 
 		AttackPrimary,	// 主攻击
+		AttackRanged,	// 远程攻击（发射投射物）
 		Ability1,		// 使用技能1
 		Ability2,		// 使用技能2
 		Ability3,		// 使用技能3
@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/// @brief 任务系统 - 固定数量工作线程的线程池
+/// @details 提供并行循环和异步任务两种用法，供网格模拟、寻路等耗时计算使用。
+/// 
+/// 设计思路：
+/// 1. 启动时创建固定数量的工作线程，运行期间不再创建线程
+/// 2. parallelFor 把区间切成若干块，调用线程也参与执行，全部完成后才返回
+/// 3. submit 提交的任务在工作线程上异步执行，由调用方自行同步结果
+/// 
+/// 为何这样做：
+/// - 避免每帧创建/销毁线程的开销
+/// - 调用线程参与计算，单核机器上也不会死等
+/// - 各系统共享同一组线程，避免线程数量失控
+class JobSystem
+{
+public:
+	/// @brief 构造函数
+	/// @details 创建工作线程，数量为0时使用硬件线程数减一
+	/// @param workerCount [IN] 工作线程数量
+	explicit JobSystem(unsigned int workerCount = 0);
+	/// @brief 析构函数
+	/// @details 等待所有工作线程退出
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// @brief 并行循环
+	/// @details 把 [0, count) 切成大小为 grain 的块并行执行，阻塞直到全部完成
+	/// @param count [IN] 元素数量
+	/// @param grain [IN] 每块的元素数量
+	/// @param fn [IN] 处理函数，参数为块的 [begin, end)
+	void parallelFor(int count, int grain, const std::function<void(int, int)>& fn);
+
+	/// @brief 提交异步任务
+	/// @details 任务在某个工作线程上执行，没有工作线程时立即在调用线程执行
+	/// @param job [IN] 任务
+	void submit(std::function<void()> job);
+
+	/// @brief 获取工作线程数量
+	/// @return 工作线程数量
+	unsigned int getWorkerCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+private:
+	/// @brief 工作线程主循环
+	void workerLoop();
+
+private:
+	std::vector<std::thread> m_workers;	// 工作线程
+	std::deque<std::function<void()>> m_jobs;	// 待执行任务队列
+	std::mutex m_mutex;	// 保护任务队列
+	std::condition_variable m_condition;	// 任务到达通知
+	bool m_bStopping;	// 是否正在退出
+};
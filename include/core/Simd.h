@@ -0,0 +1,114 @@
+#pragma once
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NDD_SIMD_SSE 1
+#include <emmintrin.h>
+#else
+#define NDD_SIMD_SSE 0
+#endif
+
+/// @brief SIMD辅助函数 - 4路单精度浮点向量
+/// @details 在支持SSE2的平台上封装 __m128，否则退化为4个标量，接口保持一致。
+/// 
+/// 设计思路：
+/// 1. 只提供数据导向内核实际用到的少量运算
+/// 2. 比较结果以掩码形式返回，配合 select 实现无分支选择
+/// 3. 所有加载/存储均为非对齐版本，调用方无需关心内存对齐
+/// 
+/// 为何这样做：
+/// - 热点循环可以一次处理4个实体或4个网格单元
+/// - 避免在业务代码中直接散落平台相关的内建函数
+namespace simd
+{
+#if NDD_SIMD_SSE
+	/// @brief 4路浮点向量
+	struct float4
+	{
+		__m128 v;
+		float4() : v(_mm_setzero_ps()) {}
+		float4(__m128 value) : v(value) {}
+		explicit float4(float s) : v(_mm_set1_ps(s)) {}
+	};
+
+	inline float4 load(const float* p) { return _mm_loadu_ps(p); }	// 加载4个浮点数
+	inline void store(float* p, const float4& a) { _mm_storeu_ps(p, a.v); }	// 存储4个浮点数
+	inline float4 operator+(const float4& a, const float4& b) { return _mm_add_ps(a.v, b.v); }
+	inline float4 operator-(const float4& a, const float4& b) { return _mm_sub_ps(a.v, b.v); }
+	inline float4 operator*(const float4& a, const float4& b) { return _mm_mul_ps(a.v, b.v); }
+	inline float4 operator/(const float4& a, const float4& b) { return _mm_div_ps(a.v, b.v); }
+	inline float4 min(const float4& a, const float4& b) { return _mm_min_ps(a.v, b.v); }
+	inline float4 max(const float4& a, const float4& b) { return _mm_max_ps(a.v, b.v); }
+	inline float4 sqrt(const float4& a) { return _mm_sqrt_ps(a.v); }
+	inline float4 cmplt(const float4& a, const float4& b) { return _mm_cmplt_ps(a.v, b.v); }	// a < b 的掩码
+	inline float4 cmple(const float4& a, const float4& b) { return _mm_cmple_ps(a.v, b.v); }	// a <= b 的掩码
+	inline float4 cmpgt(const float4& a, const float4& b) { return _mm_cmpgt_ps(a.v, b.v); }	// a > b 的掩码
+	inline float4 cmpge(const float4& a, const float4& b) { return _mm_cmpge_ps(a.v, b.v); }	// a >= b 的掩码
+	inline float4 operator&(const float4& a, const float4& b) { return _mm_and_ps(a.v, b.v); }
+	inline float4 operator|(const float4& a, const float4& b) { return _mm_or_ps(a.v, b.v); }
+	/// @brief 按掩码选择：掩码为真取a，否则取b
+	inline float4 select(const float4& mask, const float4& a, const float4& b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v));
+	}
+	/// @brief 掩码转位图：第i位对应第i个分量
+	inline int movemask(const float4& mask) { return _mm_movemask_ps(mask.v); }
+	/// @brief 四个分量求和
+	inline float sum(const float4& a)
+	{
+		__m128 shuf = _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 3, 0, 1));
+		__m128 sums = _mm_add_ps(a.v, shuf);
+		shuf = _mm_movehl_ps(shuf, sums);
+		return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+	}
+#else
+	/// @brief 4路浮点向量（标量回退实现）
+	struct float4
+	{
+		float v[4];
+		float4() : v{ 0.0f, 0.0f, 0.0f, 0.0f } {}
+		explicit float4(float s) : v{ s, s, s, s } {}
+	};
+
+	namespace detail
+	{
+		template <typename Op>
+		inline float4 map(const float4& a, const float4& b, Op op)
+		{
+			float4 r;
+			for (int i = 0; i < 4; ++i) r.v[i] = op(a.v[i], b.v[i]);
+			return r;
+		}
+		inline float maskOf(bool b) { return b ? -1.0f : 0.0f; }
+	}
+
+	inline float4 load(const float* p) { float4 r; for (int i = 0; i < 4; ++i) r.v[i] = p[i]; return r; }
+	inline void store(float* p, const float4& a) { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+	inline float4 operator+(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return x + y; }); }
+	inline float4 operator-(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return x - y; }); }
+	inline float4 operator*(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return x * y; }); }
+	inline float4 operator/(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return x / y; }); }
+	inline float4 min(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+	inline float4 max(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+	inline float4 sqrt(const float4& a) { float4 r; for (int i = 0; i < 4; ++i) r.v[i] = std::sqrt(a.v[i]); return r; }
+	inline float4 cmplt(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x < y); }); }
+	inline float4 cmple(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x <= y); }); }
+	inline float4 cmpgt(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x > y); }); }
+	inline float4 cmpge(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x >= y); }); }
+	inline float4 operator&(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return x != 0.0f ? y : 0.0f; }); }
+	inline float4 operator|(const float4& a, const float4& b) { return detail::map(a, b, [](float x, float y) { return (x != 0.0f || y != 0.0f) ? -1.0f : 0.0f; }); }
+	inline float4 select(const float4& mask, const float4& a, const float4& b)
+	{
+		float4 r;
+		for (int i = 0; i < 4; ++i) r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+		return r;
+	}
+	inline int movemask(const float4& mask)
+	{
+		int bits = 0;
+		for (int i = 0; i < 4; ++i) if (mask.v[i] != 0.0f) bits |= 1 << i;
+		return bits;
+	}
+	inline float sum(const float4& a) { return a.v[0] + a.v[1] + a.v[2] + a.v[3]; }
+#endif
+}
@@ -90,6 +90,8 @@ public:
 	/// @return 返回实体所属世界的引用
 	World& getWorld() { return *m_world; }
 private:
+	friend class World;	// 重新加入世界时由世界分配新ID
+
 	int m_id;   // 实体的唯一ID
 	World* m_world;	// 所属世界的引用
 	std::unordered_map<std::type_index, std::unique_ptr<Component>> m_components;   // 存储组件的映射
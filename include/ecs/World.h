@@ -2,9 +2,13 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <functional>
+#include <algorithm>
 
 #include "ecs/Entity.h"
 #include "ecs/System.h"
+#include "core/Random.h"
+#include "components/HealthStore.h"
 
 /// @brief ECS世界 - 管理所有实体和系统
 /// @details 该类允许创建实体，添加系统，并在每帧更新所有系统。
@@ -13,6 +17,10 @@
 /// 1. 集中管理所有游戏对象
 /// 2. 按顺序更新所有系统
 /// 3. 负责实体的创建和销毁
+/// 4. 销毁时先通知监听器释放实体在外部服务中的资源，再交给回收器接管，
+///    被接管的实体以后可以带着全部组件重新加入世界
+/// 5. 保存随机种子和帧序号，系统按（种子，帧序号，实体）推导各自的随机数流
+/// 6. 持有生命值的列存储，先于实体构造、晚于实体析构
 /// 
 /// 为何这样做：
 /// - 统一管理游戏状态
@@ -20,7 +28,7 @@
 /// - 提供实体生命周期管理
 class World {
 public:
-	World() : m_nextEntityId(0) {}
+	World() : m_nextEntityId(0), m_seed(0), m_tick(0) {}
 	/// @brief 创建一个新的实体
 	/// @details 创建一个新的实体并将其添加到世界中。实体的ID是唯一的，自动递增。
 	/// @return 返回新创建的实体的引用
@@ -28,6 +36,28 @@ public:
 		m_entities.emplace_back(std::make_unique<Entity>(m_nextEntityId++, this));
 		return *m_entities.back();
 	}
+	/// @brief 把世界外的实体加入世界
+	/// @details 实体分配一个新的ID并追加到末尾，保持实体按ID递增排列；
+	/// 用于重新启用对象池中保存的实体，旧ID不会被复用
+	/// @param entity [IN] 实体，必须属于这个世界且当前不在世界中
+	/// @return 返回加入的实体的引用
+	Entity& adoptEntity(std::unique_ptr<Entity> entity) {
+		entity->m_id = m_nextEntityId++;
+		m_entities.push_back(std::move(entity));
+		return *m_entities.back();
+	}
+	/// @brief 设置实体回收器
+	/// @details 销毁实体时先交给回收器，回收器取走所有权（把指针置空）的实体不会被释放
+	/// @param recycler [IN] 回收器，为空时直接释放
+	void setRecycler(std::function<void(std::unique_ptr<Entity>&)> recycler) {
+		m_recycler = std::move(recycler);
+	}
+	/// @brief 添加实体销毁监听器
+	/// @details 每个被销毁的实体在交给回收器或释放之前，按添加顺序通知所有监听器
+	/// @param listener [IN] 监听器
+	void addDestroyListener(std::function<void(Entity&)> listener) {
+		m_destroyListeners.push_back(std::move(listener));
+	}
 	/// @brief 添加一个系统到世界中
 	/// @details 将一个系统添加到世界中，以便在每帧更新时调用该系统的update方法。
 	/// @param system [IN] 要添加的系统
@@ -41,8 +71,26 @@ public:
 		for (auto& system : m_systems) {
 			system->update(*this, deltaTime);
 		}
+		++m_tick;
 	}
 
+	/// @brief 设置随机种子
+	/// @details 相同的种子和输入得到相同的随机结果
+	/// @param seed [IN] 种子
+	void setSeed(uint64_t seed) { m_seed = seed; }
+	uint64_t getSeed() const { return m_seed; }	// 随机种子
+	uint64_t getTick() const { return m_tick; }	// 已经更新的帧数
+
+	/// @brief 获取本帧的随机数流
+	/// @details 同一帧内以相同参数多次获取得到相同的序列
+	/// @param stream [IN] 流标识
+	/// @param entity [IN] 实体ID，不属于某个实体时为-1
+	/// @return 随机数流
+	Random random(RandomStream stream, int entity = -1) const { return Random(m_seed, stream, m_tick, entity); }
+
+	/// @brief 获取生命值存储
+	HealthStore& getHealthStore() { return m_healthStore; }
+
 	/// @brief 获取所有实体
 	/// @details 返回一个对所有实体的引用，允许访问和操作世界中的所有实体。
 	/// @return 返回一个对实体向量的常量引用
@@ -64,19 +112,26 @@ public:
 	{
 		for (int id : m_entitiesToDestroy)
 		{
-			auto it = std::remove_if(m_entities.begin(), m_entities.end(),
+			auto it = std::find_if(m_entities.begin(), m_entities.end(),
 				[id](const std::unique_ptr<Entity>& e) { return e->getId() == id; });
 
 			if (it != m_entities.end())
 			{
-				m_entities.erase(it, m_entities.end());
+				for (auto& listener : m_destroyListeners) listener(**it);
+				if (m_recycler) m_recycler(*it);
+				m_entities.erase(it);
 			}
 		}
 		m_entitiesToDestroy.clear();
 	}
 private:
+	HealthStore m_healthStore;	// 生命值存储，必须在实体之前声明
 	std::vector<std::unique_ptr<Entity>> m_entities;    // 存储所有实体的向量
 	std::vector<std::unique_ptr<System>> m_systems; // 存储所有系统的向量
 	std::vector<int> m_entitiesToDestroy; // 待销毁实体ID列表
 	int m_nextEntityId;	// 下一个实体的ID，用于确保实体ID的唯一性
+	std::function<void(std::unique_ptr<Entity>&)> m_recycler;	// 实体回收器
+	std::vector<std::function<void(Entity&)>> m_destroyListeners;	// 实体销毁监听器
+	uint64_t m_seed;	// 随机种子
+	uint64_t m_tick;	// 已经更新的帧数
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// 前向声明
+class NavGrid;
+class JobSystem;
+
+/// @brief 流场 - 所有追逐者共享的指向玩家的方向场
+/// @details 从玩家所在格子做一次 Dijkstra 积分，每个格子记录通往玩家的下一步方向。
+/// 
+/// 设计思路：
+/// 1. 玩家跨越格子或障碍变化时才重新积分，其余帧直接复用
+/// 2. 积分在后台缓冲区进行，可提交到任务系统的工作线程，完成后与前台缓冲区交换
+/// 3. 积分开始时拷贝一份障碍数据，工作线程不读取可能被修改的导航网格
+/// 4. 八方向移动，斜向移动不允许穿过障碍的拐角
+/// 
+/// 为何这样做：
+/// - 数百个追逐者只需一次积分加上每个 O(1) 的查表，远比逐个寻路便宜
+/// - 双缓冲让查询永远读到完整的流场，不会读到积分一半的数据
+class FlowField
+{
+public:
+	/// @brief 构造函数
+	/// @param grid [IN] 导航网格
+	explicit FlowField(const NavGrid* grid);
+
+	/// @brief 析构函数
+	/// @details 等待进行中的积分完成
+	~FlowField();
+
+	FlowField(const FlowField&) = delete;
+	FlowField& operator=(const FlowField&) = delete;
+
+	/// @brief 更新目标位置
+	/// @details 在主线程每帧调用。取回已完成的积分；目标换了格子或障碍变化时发起新的积分
+	/// @param goal [IN] 目标（玩家）位置
+	/// @param jobSystem [IN] 任务系统，为空时在调用线程积分
+	void update(const glm::vec3& goal, JobSystem* jobSystem);
+
+	/// @brief 查询某个位置的移动方向
+	/// @details 位于目标格子、不可达或流场尚未生成时返回false，调用方应直接朝目标移动
+	/// @param position [IN] 世界坐标
+	/// @param direction [OUT] XZ平面上的单位方向
+	/// @return 是否查到方向
+	bool getDirection(const glm::vec3& position, glm::vec3& direction) const;
+
+	/// @brief 查询某个位置沿路径到目标的距离
+	/// @param position [IN] 世界坐标
+	/// @return 路径距离（世界单位），不可达时返回负数
+	float getDistance(const glm::vec3& position) const;
+
+private:
+	/// @brief 一份完整的流场数据
+	struct Layer
+	{
+		std::vector<uint8_t> blocked;	// 积分时的障碍数据
+		std::vector<float> costs;	// 每个格子到目标的积分代价（格子数）
+		std::vector<uint8_t> directions;	// 每个格子的下一步方向，NoDirection 表示无
+		int goalX = -1;	// 目标格子X
+		int goalZ = -1;	// 目标格子Z
+		uint32_t gridVersion = 0;	// 积分时的导航网格版本
+	};
+
+	/// @brief 在给定缓冲区上执行积分
+	/// @param layer [IN/OUT] 缓冲区，blocked 和目标需已填好
+	void integrate(Layer& layer);
+
+	/// @brief 取回已完成的积分
+	void collect();
+
+	/// @brief 世界坐标转格子下标
+	/// @return 网格外返回-1
+	int cellIndex(const glm::vec3& position) const;
+
+private:
+	static constexpr uint8_t NoDirection = 0xFF;	// 无方向（目标格子或不可达）
+
+	const NavGrid* m_pGrid;	// 导航网格
+	int m_width;	// X方向格子数
+	int m_height;	// Z方向格子数
+
+	Layer m_front;	// 供查询的流场
+	Layer m_back;	// 正在积分的流场
+	bool m_hasField;	// 前台缓冲区是否有效
+	bool m_pending;	// 是否有已提交但尚未取回的积分
+	std::atomic<bool> m_building;	// 工作线程是否正在积分
+
+	std::vector<std::pair<float, int>> m_open;	// 积分用的优先队列（仅积分线程访问）
+};
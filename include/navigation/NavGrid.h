@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+/// @brief 导航网格 - XZ平面上的可通行性栅格
+/// @details 记录每个格子是否被障碍占据，供流场和寻路使用。
+/// 
+/// 设计思路：
+/// 1. 与腐蚀场使用相同的坐标约定，格子 (x, z) 覆盖 [origin + (x, z) * cellSize, origin + (x + 1, z + 1) * cellSize)
+/// 2. 网格外的位置一律视为不可通行
+/// 3. 每次修改障碍都递增版本号，寻路结果据此判断是否失效
+/// 
+/// 为何这样做：
+/// - 所有寻路算法共享同一份障碍数据
+/// - 版本号让缓存失效判断只需比较一个整数
+class NavGrid
+{
+public:
+	/// @brief 构造函数
+	/// @details 创建所有格子都可通行的网格
+	/// @param width [IN] X方向格子数
+	/// @param height [IN] Z方向格子数
+	/// @param cellSize [IN] 格子边长（世界单位）
+	/// @param origin [IN] 网格左下角的XZ世界坐标
+	NavGrid(int width = 128, int height = 128, float cellSize = 1.0f,
+		const glm::vec2& origin = glm::vec2(-64.0f, -64.0f));
+
+	/// @brief 世界坐标转格子坐标
+	/// @param position [IN] 世界坐标
+	/// @param x [OUT] X方向格子下标
+	/// @param z [OUT] Z方向格子下标
+	/// @return 位置在网格内返回true
+	bool worldToCell(const glm::vec3& position, int& x, int& z) const;
+
+	/// @brief 获取格子中心的世界坐标
+	/// @param x [IN] X方向格子下标
+	/// @param z [IN] Z方向格子下标
+	/// @return 格子中心（Y为0）
+	glm::vec3 cellCenter(int x, int z) const;
+
+	/// @brief 判断格子是否不可通行
+	/// @details 网格外的格子视为不可通行
+	/// @param x [IN] X方向格子下标
+	/// @param z [IN] Z方向格子下标
+	/// @return 不可通行返回true
+	bool isBlocked(int x, int z) const;
+
+	/// @brief 设置格子是否不可通行
+	/// @param x [IN] X方向格子下标
+	/// @param z [IN] Z方向格子下标
+	/// @param blocked [IN] 是否不可通行
+	void setBlocked(int x, int z, bool blocked);
+
+	/// @brief 判断两点之间的视线是否被障碍遮挡
+	/// @details 沿线段逐格遍历（DDA），只比较XZ平面；网格外的格子不遮挡视线
+	/// @param from [IN] 起点
+	/// @param to [IN] 终点
+	/// @return 视线通畅返回true
+	bool hasLineOfSight(const glm::vec3& from, const glm::vec3& to) const;
+
+	/// @brief 获取障碍数据
+	/// @details 按行存放，下标为 z * width + x，非0表示不可通行
+	/// @return 障碍数组
+	const std::vector<uint8_t>& getBlocked() const { return m_blocked; }
+
+	int getWidth() const { return m_width; }	// X方向格子数
+	int getHeight() const { return m_height; }	// Z方向格子数
+	float getCellSize() const { return m_cellSize; }	// 格子边长
+	const glm::vec2& getOrigin() const { return m_origin; }	// 网格左下角的XZ坐标
+
+	/// @brief 获取网格版本号
+	/// @details 每次障碍变化后递增
+	/// @return 版本号
+	uint32_t getVersion() const { return m_version; }
+
+private:
+	int m_width;	// X方向格子数
+	int m_height;	// Z方向格子数
+	float m_cellSize;	// 格子边长
+	float m_invCellSize;	// 格子边长倒数
+	glm::vec2 m_origin;	// 网格左下角的XZ坐标
+
+	std::vector<uint8_t> m_blocked;	// 障碍数据
+	uint32_t m_version;	// 网格版本号
+};
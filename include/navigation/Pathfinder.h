@@ -0,0 +1,136 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// 前向声明
+class NavGrid;
+class JobSystem;
+
+/// @brief 寻路服务 - 导航网格上的异步 A* 寻路
+/// @details 面向巡逻、游荡等各自目标不同的实体，请求在之后的若干帧内由工作线程完成。
+/// 
+/// 设计思路：
+/// 1. 调用方提交请求得到请求ID，之后每帧用 takePath 轮询结果
+/// 2. 每帧最多把固定数量的请求打包成一批提交到任务系统，同一时间只有一批在执行
+/// 3. 单次搜索扩展的节点数有上限，超出视为不可达
+/// 4. 结果按起点格子和终点格子缓存，导航网格版本变化时整体失效
+/// 5. 搜索使用提交时拷贝的障碍数据，工作线程不读取可能被修改的导航网格
+/// 
+/// 为何这样做：
+/// - 任何一帧都不会为大量搜索买单
+/// - 巡逻路线固定，缓存命中后不再搜索
+/// - 版本号让缓存失效判断只需比较一个整数
+class Pathfinder
+{
+public:
+	/// @brief 请求状态
+	enum class Status
+	{
+		Pending,	// 等待或正在搜索
+		Ready,	// 已找到路径
+		Failed	// 不可达或请求无效
+	};
+
+	/// @brief 构造函数
+	/// @param grid [IN] 导航网格
+	explicit Pathfinder(const NavGrid* grid);
+
+	/// @brief 析构函数
+	/// @details 等待进行中的搜索完成
+	~Pathfinder();
+
+	Pathfinder(const Pathfinder&) = delete;
+	Pathfinder& operator=(const Pathfinder&) = delete;
+
+	/// @brief 提交寻路请求
+	/// @details 命中缓存时请求立即完成
+	/// @param start [IN] 起点
+	/// @param goal [IN] 终点
+	/// @return 请求ID（非0）
+	uint32_t requestPath(const glm::vec3& start, const glm::vec3& goal);
+
+	/// @brief 查询请求结果
+	/// @details 返回 Ready 或 Failed 后请求被释放，ID不可再使用
+	/// @param id [IN] 请求ID
+	/// @param waypoints [OUT] 路径点（不含起点所在格子，终点为终点格子中心）
+	/// @return 请求状态，未知ID返回 Failed
+	Status takePath(uint32_t id, std::vector<glm::vec3>& waypoints);
+
+	/// @brief 取消请求
+	/// @param id [IN] 请求ID
+	void cancel(uint32_t id);
+
+	/// @brief 推进寻路
+	/// @details 在主线程每帧调用。取回已完成的一批搜索，再提交下一批
+	/// @param jobSystem [IN] 任务系统，为空时在调用线程搜索
+	void update(JobSystem* jobSystem);
+
+private:
+	/// @brief 寻路请求
+	struct Request
+	{
+		int start;	// 起点格子下标
+		int goal;	// 终点格子下标
+		Status status;	// 状态
+		std::vector<glm::vec3> waypoints;	// 结果路径点
+	};
+
+	/// @brief 一次搜索任务（仅搜索线程写入结果）
+	struct Search
+	{
+		uint32_t id;	// 请求ID
+		int start;	// 起点格子下标
+		int goal;	// 终点格子下标
+		bool found;	// 是否找到路径
+		std::vector<glm::vec3> waypoints;	// 结果路径点
+	};
+
+	/// @brief A* 搜索
+	/// @param search [IN/OUT] 搜索任务
+	void runSearch(Search& search);
+
+	/// @brief 取回已完成的一批搜索
+	void collect();
+
+	/// @brief 尝试用缓存完成请求
+	/// @return 命中返回true
+	bool resolveFromCache(Request& request) const;
+
+	/// @brief 缓存键
+	uint64_t cacheKey(int start, int goal) const
+	{
+		return static_cast<uint64_t>(start) * static_cast<uint64_t>(m_width * m_height) + static_cast<uint64_t>(goal);
+	}
+
+private:
+	const NavGrid* m_pGrid;	// 导航网格
+	int m_width;	// X方向格子数
+	int m_height;	// Z方向格子数
+
+	uint32_t m_nextId;	// 下一个请求ID
+	std::unordered_map<uint32_t, Request> m_requests;	// 未释放的请求
+	std::deque<uint32_t> m_queue;	// 等待搜索的请求
+
+	/// @brief 路径缓存，空数组表示不可达
+	std::unordered_map<uint64_t, std::vector<glm::vec3>> m_cache;
+	uint32_t m_cacheVersion;	// 缓存对应的导航网格版本
+
+	// 进行中的一批搜索
+	std::vector<Search> m_batch;	// 搜索任务
+	std::vector<uint8_t> m_blocked;	// 障碍数据快照
+	uint32_t m_batchVersion;	// 快照对应的导航网格版本
+	bool m_pending;	// 是否有已提交但尚未取回的一批
+	std::atomic<bool> m_running;	// 工作线程是否正在搜索
+
+	// 搜索用的临时数据（仅搜索线程访问）
+	std::vector<float> m_costs;	// 起点到各格子的代价
+	std::vector<int> m_parents;	// 各格子的前驱
+	std::vector<uint32_t> m_visited;	// 格子最近一次被访问的搜索序号
+	uint32_t m_searchStamp;	// 搜索序号
+	std::vector<std::pair<float, int>> m_open;	// 开放列表
+	std::vector<int> m_cells;	// 回溯得到的格子序列
+};
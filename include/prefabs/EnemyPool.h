@@ -0,0 +1,62 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+
+// 前向声明
+class World;
+class Entity;
+
+/// @brief 敌人池 - 预先创建的暗蚀生物，启用和回收都不分配组件或网格
+/// @details 池中的实体不在世界里；启用时重置组件并加入世界，销毁时由世界交还给池。
+///
+/// 设计思路：
+/// 1. 加载阶段一次性创建指定数量的暗蚀生物，组件和网格（含GPU缓冲上传）都在此时完成
+/// 2. 启用时只原地重置组件数值，并以新的ID加入世界；旧ID不会被复用，按ID保存的引用自然失效
+/// 3. 池创建的实体带有 Pooled 标记，世界销毁这类实体时把所有权交还给池
+/// 4. 池耗尽时退回即时创建并记录警告，新建的实体同样带标记，之后也会回到池中
+///
+/// 为何这样做：
+/// - 暗蚀潮汐一次生成数百个敌人时，帧内只剩重置数值的开销，不会出现内存分配和GPU上传造成的卡顿
+/// - 其他系统照常通过世界销毁敌人，不需要知道敌人来自池
+class EnemyPool
+{
+public:
+	/// @brief 构造函数
+	/// @details 向世界注册回收器
+	/// @param world [IN] 池中实体所属的世界
+	explicit EnemyPool(World& world);
+
+	/// @brief 析构函数
+	/// @details 从世界注销回收器
+	~EnemyPool();
+
+	EnemyPool(const EnemyPool&) = delete;
+	EnemyPool& operator=(const EnemyPool&) = delete;
+
+	/// @brief 预先创建实体
+	/// @details 需要在图形上下文创建之后调用
+	/// @param count [IN] 新增的实体数
+	void prewarm(size_t count);
+
+	/// @brief 启用一个暗蚀生物
+	/// @param position [IN] 初始位置
+	/// @return 加入世界的实体
+	Entity& acquire(const glm::vec3& position);
+
+	size_t getAvailable() const { return m_available.size(); }	// 池中可用的实体数
+	size_t getCreated() const { return m_created; }	// 池累计创建的实体数
+
+private:
+	/// @brief 创建一个不在世界中的池化实体
+	std::unique_ptr<Entity> create();
+
+	/// @brief 世界销毁实体时调用，取走池化实体的所有权
+	/// @param entity [IN/OUT] 被销毁的实体，取走后置空
+	void recycle(std::unique_ptr<Entity>& entity);
+
+private:
+	World& m_world;	// 所属世界
+	std::vector<std::unique_ptr<Entity>> m_available;	// 可用的实体
+	size_t m_created;	// 累计创建的实体数
+};
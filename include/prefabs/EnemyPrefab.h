@@ -10,6 +10,10 @@
 #include "components/CombatInput.h"
 #include "components/MeshRenderer.h"
 #include "components/MovementProperties.h"
+#include "components/Collider.h"
+#include "components/Behavior.h"
+#include "components/Squad.h"
+#include "components/StatModifiers.h"
 
 /// @brief 预设体：敌人实体
 /// @details 创建一个敌人实体，包含必要的组件和初始值设置。
@@ -24,31 +28,105 @@
 /// - 集中管理敌人配置
 /// - 支持多种敌人类型（未来扩展）
 namespace Prefab {
-    /// @brief 创建暗蚀生物实体
-	/// @details 该函数创建一个暗蚀生物实体，并为其添加必要的组件和初始值设置。
-	/// @param world [IN] 需要添加实体的世界对象
-	/// @param position [IN] 实体的初始位置
-	/// @return 返回创建的敌人实体
-    inline Entity& createDarkCreature(World& world, const glm::vec3& position) {
-        auto& enemy = world.createEntity();
+    /// @brief 创建敌人网格（金字塔形状）
+	/// @param color [IN] 顶点颜色
+	/// @param scale [IN] 缩放比例
+	/// @return 新建的网格，由渲染组件负责释放
+    inline Mesh* createEnemyMesh(const glm::vec3& color, float scale = 1.0f) {
+        std::vector<Mesh::Vertex> enemyVertices = {
+            // 底部
+            {{-0.5f * scale, 0.0f, -0.5f * scale},	{0.0f, -1.0f, 0.0f},	{0.0f, 0.0f}, color},
+            {{0.5f * scale, 0.0f, -0.5f * scale},	{0.0f, -1.0f, 0.0f},	{1.0f, 0.0f}, color},
+            {{0.5f * scale, 0.0f, 0.5f * scale},	{0.0f, -1.0f, 0.0f},	{1.0f, 1.0f}, color},
+            {{-0.5f * scale, 0.0f, 0.5f * scale},	{0.0f, -1.0f, 0.0f},	{0.0f, 1.0f}, color},
+
+            // 侧面
+            {{0.0f, scale, 0.0f},	{0.0f, 0.0f, 1.0f},	{0.5f, 1.0f}, color},
+            {{-0.5f * scale, 0.0f, 0.5f * scale},	{0.0f, 0.0f, 1.0f},	{0.0f, 0.0f}, color},
+            {{0.5f * scale, 0.0f, 0.5f * scale},	{0.0f, 0.0f, 1.0f},	{1.0f, 0.0f}, color},
+
+            {{0.0f, scale, 0.0f},	{1.0f, 0.0f, 0.0f},	{0.5f, 1.0f}, color},
+            {{0.5f * scale, 0.0f, 0.5f * scale},	{1.0f, 0.0f, 0.0f},	{0.0f, 0.0f}, color},
+            {{0.5f * scale, 0.0f, -0.5f * scale},	{1.0f, 0.0f, 0.0f},	{1.0f, 0.0f}, color},
+
+            {{0.0f, scale, 0.0f},	{0.0f, 0.0f, -1.0f},	{0.5f, 1.0f}, color},
+            {{0.5f * scale, 0.0f, -0.5f * scale},	{0.0f, 0.0f, -1.0f},	{0.0f, 0.0f}, color},
+            {{-0.5f * scale, 0.0f, -0.5f * scale},	{0.0f, 0.0f, -1.0f},	{1.0f, 0.0f}, color},
+
+            {{0.0f, scale, 0.0f},	{-1.0f, 0.0f, 0.0f},	{0.5f, 1.0f}, color},
+            {{-0.5f * scale, 0.0f, -0.5f * scale},	{-1.0f, 0.0f, 0.0f},	{0.0f, 0.0f}, color},
+            {{-0.5f * scale, 0.0f, 0.5f * scale},	{-1.0f, 0.0f, 0.0f},	{1.0f, 0.0f}, color}
+        };
+
+        std::vector<unsigned int> enemyIndices = {
+            // 底部
+            0, 1, 2,
+            0, 2, 3,
+
+            // 侧面
+            4, 5, 6,
+            7, 8, 9,
+            10, 11, 12,
+            13, 14, 15
+        };
+        return new Mesh(enemyVertices, enemyIndices);
+    }
 
+    /// @brief 为实体添加暗蚀生物的组件
+	/// @details 只添加组件和网格，数值由 resetDarkCreature 设置；对象池预热时也使用该函数
+	/// @param enemy [IN] 实体
+    inline void addDarkCreatureComponents(Entity& enemy) {
         // 添加标记组件
         enemy.addComponent<Enemy>();
 
-        // 添加变换组件
-        auto& transform = enemy.addComponent<Transform>();
+        // 添加变换、速度、移动属性和碰撞体组件
+        enemy.addComponent<Transform>();
+        enemy.addComponent<Velocity>();
+        enemy.addComponent<MovementProperties>();
+        enemy.addComponent<Collider>();
+
+        // 添加AI、攻击和攻击请求组件
+        enemy.addComponent<AI>();
+        enemy.addComponent<Attack>();
+        enemy.addComponent<CombatInput>();
+
+        // 添加生命值组件
+        enemy.addComponent<Health>(enemy);
+
+        // 添加属性修正组件（能力效果施加的修正写入这里，预先添加避免施放时分配）
+        enemy.addComponent<StatModifiers>();
+
+        // 添加渲染组件（红色三角形）
+        auto& renderer = enemy.addComponent<MeshRenderer>();
+        renderer.color = glm::vec3(1.0f, 0.0f, 0.0f); // 红色
+        renderer.mesh = createEnemyMesh(renderer.color);
+    }
+
+    /// @brief 把暗蚀生物的组件重置为初始值
+	/// @details 组件原地重新赋值，不分配组件也不重建网格；对象池重新启用实体时调用
+	/// @param enemy [IN] 已添加暗蚀生物组件的实体
+	/// @param position [IN] 实体的初始位置
+    inline void resetDarkCreature(Entity& enemy, const glm::vec3& position) {
+        // 变换组件
+        auto& transform = *enemy.getComponent<Transform>();
+        transform = Transform();
         transform.position = position;
         transform.updateDirectionVectors();
 
-        // 添加速度组件
-        enemy.addComponent<Velocity>();
+        // 速度组件
+        *enemy.getComponent<Velocity>() = Velocity();
 
-        // 添加移动属性组件
-        auto& movement = enemy.addComponent<MovementProperties>();
+        // 移动属性组件
+        auto& movement = *enemy.getComponent<MovementProperties>();
+        movement = MovementProperties();
         movement.moveSpeed = 7.0f; // 最大速度
 
-        // 添加AI组件
-        auto& ai = enemy.addComponent<AI>();
+        // 碰撞体组件
+        *enemy.getComponent<Collider>() = Collider(0.5f, 1.0f, 1.0f);
+
+        // AI组件
+        auto& ai = *enemy.getComponent<AI>();
+        ai = AI();
         ai.sightRange = 15.0f;
         ai.chaseRange = 25.0f;
         ai.attackRange = 1.0f;
@@ -60,63 +138,79 @@ namespace Prefab {
         ai.patrolPoints.push_back(position + glm::vec3(5.0f, 0.0f, 0.0f));
         ai.patrolPoints.push_back(position + glm::vec3(5.0f, 0.0f, 5.0f));
 
-        // 添加攻击组件
-        auto& attack = enemy.addComponent<Attack>();
+        // 攻击组件
+        auto& attack = *enemy.getComponent<Attack>();
+        attack = Attack();
         attack.damage = 15.0f;
         attack.range = 3.0f;
         attack.cooldown = 2.0f;
 
-        // 添加攻击请求组件
-        enemy.addComponent<CombatInput>();
+        // 攻击请求组件
+        *enemy.getComponent<CombatInput>() = CombatInput();
 
-        // 添加生命值组件
-        auto& health = enemy.addComponent<Health>();
-        health.current = 80.0f;
-        health.max = 80.0f;
-        health.baseMax = 80.0f;
+        // 生命值组件
+        auto& health = *enemy.getComponent<Health>();
+        health.setCurrent(80.0f);
+        health.setMax(80.0f);
+        health.setBaseMax(80.0f);
 
-        // 添加渲染组件（红色三角形）
-        auto& renderer = enemy.addComponent<MeshRenderer>();
-        renderer.color = glm::vec3(1.0f, 0.0f, 0.0f); // 红色
-        // 创建敌人网格（金字塔形状）
-        std::vector<Mesh::Vertex> enemyVertices = {
-            // 底部
-            {{-0.5f, 0.0f, -0.5f},	{0.0f, -1.0f, 0.0f},	{0.0f, 0.0f}, renderer.color},
-            {{0.5f, 0.0f, -0.5f},	{0.0f, -1.0f, 0.0f},	{1.0f, 0.0f}, renderer.color},
-            {{0.5f, 0.0f, 0.5f},	{0.0f, -1.0f, 0.0f},	{1.0f, 1.0f}, renderer.color},
-            {{-0.5f, 0.0f, 0.5f},	{0.0f, -1.0f, 0.0f},	{0.0f, 1.0f}, renderer.color},
+        // 属性修正组件
+        *enemy.getComponent<StatModifiers>() = StatModifiers();
 
-            // 侧面
-            {{0.0f, 1.0f, 0.0f},	{0.0f, 0.0f, 1.0f},	{0.5f, 1.0f}, renderer.color},
-            {{-0.5f, 0.0f, 0.5f},	{0.0f, 0.0f, 1.0f},	{0.0f, 0.0f}, renderer.color},
-            {{0.5f, 0.0f, 0.5f},	{0.0f, 0.0f, 1.0f},	{1.0f, 0.0f}, renderer.color},
+        // 渲染组件保留网格，只恢复可见
+        enemy.getComponent<MeshRenderer>()->visible = true;
+    }
 
-            {{0.0f, 1.0f, 0.0f},	{1.0f, 0.0f, 0.0f},	{0.5f, 1.0f}, renderer.color},
-            {{0.5f, 0.0f, 0.5f},	{1.0f, 0.0f, 0.0f},	{0.0f, 0.0f}, renderer.color},
-            {{0.5f, 0.0f, -0.5f},	{1.0f, 0.0f, 0.0f},	{1.0f, 0.0f}, renderer.color},
+    /// @brief 创建暗蚀生物实体
+	/// @details 该函数创建一个暗蚀生物实体，并为其添加必要的组件和初始值设置。
+	/// @param world [IN] 需要添加实体的世界对象
+	/// @param position [IN] 实体的初始位置
+	/// @return 返回创建的敌人实体
+    inline Entity& createDarkCreature(World& world, const glm::vec3& position) {
+        auto& enemy = world.createEntity();
+        addDarkCreatureComponents(enemy);
+        resetDarkCreature(enemy, position);
+        return enemy;
+    }
 
-            {{0.0f, 1.0f, 0.0f},	{0.0f, 0.0f, -1.0f},	{0.5f, 1.0f}, renderer.color},
-            {{0.5f, 0.0f, -0.5f},	{0.0f, 0.0f, -1.0f},	{0.0f, 0.0f}, renderer.color},
-            {{-0.5f, 0.0f, -0.5f},	{0.0f, 0.0f, -1.0f},	{1.0f, 0.0f}, renderer.color},
+    /// @brief 创建腐化潜行者实体
+	/// @details 在暗蚀生物的基础上添加行为组件，由行为树而不是内置状态机控制。
+	/// @param world [IN] 需要添加实体的世界对象
+	/// @param position [IN] 实体的初始位置
+	/// @param tree [IN] 行为树ID
+	/// @return 返回创建的敌人实体
+    inline Entity& createCorruptedStalker(World& world, const glm::vec3& position, int tree) {
+        auto& enemy = createDarkCreature(world, position);
+        enemy.addComponent<Behavior>(tree);
+        return enemy;
+    }
 
-            {{0.0f, 1.0f, 0.0f},	{-1.0f, 0.0f, 0.0f},	{0.5f, 1.0f}, renderer.color},
-            {{-0.5f, 0.0f, -0.5f},	{-1.0f, 0.0f, 0.0f},	{0.0f, 0.0f}, renderer.color},
-            {{-0.5f, 0.0f, 0.5f},	{-1.0f, 0.0f, 0.0f},	{1.0f, 0.0f}, renderer.color}
-        };
+    /// @brief 创建敌人小队实体
+	/// @details 小队没有 Enemy 标记和生命值，不参与战斗和个体AI，只整体移动和渲染。
+	/// @param world [IN] 需要添加实体的世界对象
+	/// @param position [IN] 小队中心位置
+	/// @param mesh [IN] 复用的网格，所有权交给渲染组件；为空时新建
+	/// @return 返回创建的小队实体
+    inline Entity& createSquad(World& world, const glm::vec3& position, Mesh* mesh = nullptr) {
+        auto& squad = world.createEntity();
 
-        std::vector<unsigned int> enemyIndices = {
-            // 底部
-            0, 1, 2,
-            0, 2, 3,
+        // 添加小队组件
+        auto& data = squad.addComponent<Squad>();
+        data.anchor = data.waypoint = position;
 
-            // 侧面
-            4, 5, 6,
-            7, 8, 9,
-            10, 11, 12,
-            13, 14, 15
-        };
-        renderer.mesh = new Mesh(enemyVertices, enemyIndices);
+        // 添加变换组件
+        auto& transform = squad.addComponent<Transform>();
+        transform.position = position;
+        transform.updateDirectionVectors();
 
-        return enemy;
+        // 添加速度组件
+        squad.addComponent<Velocity>();
+
+        // 添加渲染组件（放大的暗红色金字塔）
+        auto& renderer = squad.addComponent<MeshRenderer>();
+        renderer.color = glm::vec3(0.6f, 0.0f, 0.0f);
+        renderer.mesh = mesh ? mesh : createEnemyMesh(renderer.color, 2.0f);
+
+        return squad;
     }
 }
\ No newline at end of file
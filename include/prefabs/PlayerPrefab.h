@@ -14,6 +14,7 @@
 #include "components/Health.h"
 #include "components/Attack.h"
 #include "components/Camera.h"
+#include "components/Collider.h"
 
 /// @brief 预设体：玩家实体
 /// @details 创建一个玩家实体，包含必要的组件和初始值设置。
@@ -55,11 +56,11 @@ namespace Prefab
 		auto& movement = player.addComponent<MovementProperties>();
 		movement.moveSpeed = 7.0f; // 最大速度
 
+		// 添加碰撞体组件（质量较大，不易被敌人推动）
+		player.addComponent<Collider>(0.5f, 1.0f, 0.2f);
+
 		// 添加生命值组件
-		auto& health = player.addComponent<Health>();
-		health.current = 10000000000.0f;
-		health.max = 100000000000.0f;
-		health.baseMax = 100.0f;
+		player.addComponent<Health>(player, 10000000000.0f, 100000000000.0f, 100.0f);
 
 		// 添加攻击组件
 		auto& attack = player.addComponent<Attack>();
@@ -82,9 +83,8 @@ namespace Prefab
 
 		// 添加腐蚀度组件
 		auto& corruption = player.addComponent<Corruption>();
-		corruption.current = 0.0f;
-		corruption.lowThreshold = 30.0f;
-		corruption.mediumThreshold = 70.0f;
+		corruption.set(0.0f);
+		corruption.setThresholds(30.0f, 70.0f, 90.0f);
 
 		// 添加网格渲染组件
 		auto& meshRenderer = player.addComponent<MeshRenderer>();
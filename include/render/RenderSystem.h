@@ -4,10 +4,13 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <vector>
 
 // 前向声明
 class Shader;	// 着色器类
 class Mesh;	// 网格类
+class CorruptionField;	// 腐蚀场
+class ProjectilePool;	// 投射物池
 
 /// @brief 渲染系统 - 负责所有渲染逻辑
 /// @details 该系统处理所有渲染相关的操作，包括加载着色器、网格和渲染实体。
@@ -26,7 +29,9 @@ class RenderSystem : public System
 public:
 	/// @brief 构造函数
 	/// @details 初始化渲染系统，加载必要的着色器和网格数据。
-	RenderSystem();
+	/// @param corruptionField [IN] 腐蚀场，用于给处于腐蚀区域的实体着色
+	/// @param projectiles [IN] 投射物池，可为空
+	RenderSystem(const CorruptionField* corruptionField, const ProjectilePool* projectiles);
 	/// @brief 析构函数
 	/// @details 清理渲染系统，释放资源。
 	~RenderSystem() override;
@@ -51,8 +56,15 @@ private:
 	/// @param halfSize [IN] 网格的半尺寸（默认20）
 	/// @param step [IN] 网格线之间的间距（默认1.0f）
 	void drawDebugFloor(int halfSize = 20, float step = 1.0f) const;
+
+	/// @brief 绘制所有投射物
+	/// @details 投射物位置写入按池容量预分配的顶点缓冲，一次绘制调用画成点
+	void drawProjectiles();
 private:
 	Shader* m_pCoreShader;	// 渲染使用的着色器程序
+	const CorruptionField* m_pCorruptionField;	// 腐蚀场
+	const ProjectilePool* m_pProjectiles;	// 投射物池
+	std::vector<float> m_projectileVertices;	// 投射物顶点位置（每个投射物3个浮点数）
 
 	glm::mat4 m_viewMatrix;		// 视图矩阵
 	glm::mat4 m_projectionMatrix;	// 投影矩阵
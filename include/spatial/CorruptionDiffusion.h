@@ -0,0 +1,103 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+
+// 前向声明
+class JobSystem;
+
+/// @brief 腐蚀扩散场 - 在网格上模拟腐蚀的蔓延与消退
+/// @details 以元胞自动机方式每帧执行一次扩散/衰减模板计算，腐蚀源注入、净化能力移除。
+/// 
+/// 设计思路：
+/// 1. 使用前后两块缓冲区，读旧写新，一帧结束后交换
+/// 2. 五点模板：next = (c + k * (上 + 下 + 左 + 右 - 4c)) * 衰减
+/// 3. 每行内用4路SIMD计算，各行按条带分配给工作线程
+/// 4. 注入与移除请求先缓存，下一次模拟前统一写入
+/// 
+/// 为何这样做：
+/// - 双缓冲让各线程无需加锁即可并行写入
+/// - 512x512 网格每帧更新控制在1毫秒左右
+/// - 腐蚀不再只是腐蚀源周围的静态圆圈，而会随时间蔓延和消散
+class CorruptionDiffusion
+{
+public:
+	/// @brief 构造函数
+	/// @details 创建覆盖 [origin, origin + size * cellSize] 区域的网格
+	/// @param size [IN] 每边单元数
+	/// @param cellSize [IN] 单元边长（世界单位）
+	/// @param origin [IN] 网格左下角的XZ世界坐标
+	CorruptionDiffusion(int size = 512, float cellSize = 0.25f,
+		const glm::vec2& origin = glm::vec2(-64.0f, -64.0f));
+
+	/// @brief 设置模拟参数
+	/// @param diffusionRate [IN] 扩散速率（世界单位²/秒）
+	/// @param decayRate [IN] 每秒衰减比例
+	void setRates(float diffusionRate, float decayRate);
+
+	/// @brief 注入腐蚀
+	/// @details 在圆形区域内均匀增加腐蚀值，下一次模拟前生效
+	/// @param position [IN] 中心位置
+	/// @param radius [IN] 半径
+	/// @param amount [IN] 每个单元增加的值
+	void inject(const glm::vec3& position, float radius, float amount);
+
+	/// @brief 移除腐蚀
+	/// @details 在圆形区域内减少腐蚀值（不低于0），下一次模拟前生效
+	/// @param position [IN] 中心位置
+	/// @param radius [IN] 半径
+	/// @param amount [IN] 每个单元减少的值
+	void remove(const glm::vec3& position, float radius, float amount);
+
+	/// @brief 推进一次模拟
+	/// @details 先应用缓存的注入/移除，再执行扩散衰减并交换缓冲区
+	/// @param deltaTime [IN] 时间增量
+	/// @param jobSystem [IN] 任务系统，为空时在调用线程上执行
+	void step(float deltaTime, JobSystem* jobSystem);
+
+	/// @brief 采样腐蚀值
+	/// @details 对相邻四个单元做双线性插值，网格外返回0
+	/// @param position [IN] 世界坐标
+	/// @return 腐蚀值
+	float sample(const glm::vec3& position) const;
+
+	/// @brief 获取当前网格数据
+	/// @details 按行存放，下标为 z * size + x
+	/// @return 单元值数组
+	const std::vector<float>& getValues() const { return m_front; }
+
+	int getSize() const { return m_size; }	// 每边单元数
+	float getCellSize() const { return m_cellSize; }	// 单元边长
+	const glm::vec2& getOrigin() const { return m_origin; }	// 网格左下角坐标
+
+private:
+	/// @brief 缓存的注入/移除请求
+	struct Stamp
+	{
+		glm::vec3 position;	// 中心位置
+		float radius;	// 半径
+		float amount;	// 正为注入，负为移除
+	};
+
+	/// @brief 把缓存的请求写入当前缓冲区
+	void applyStamps();
+
+	/// @brief 计算一段行的扩散衰减
+	/// @param rowBegin [IN] 起始行（包含）
+	/// @param rowEnd [IN] 结束行（不包含）
+	/// @param k [IN] 扩散系数
+	/// @param keep [IN] 衰减后保留比例
+	void stepRows(int rowBegin, int rowEnd, float k, float keep);
+
+private:
+	int m_size;	// 每边单元数
+	float m_cellSize;	// 单元边长
+	float m_invCellSize;	// 单元边长倒数
+	glm::vec2 m_origin;	// 网格左下角坐标
+
+	float m_diffusionRate;	// 扩散速率
+	float m_decayRate;	// 每秒衰减比例
+
+	std::vector<float> m_front;	// 当前缓冲区（只读）
+	std::vector<float> m_back;	// 写入缓冲区
+	std::vector<Stamp> m_stamps;	// 缓存的注入/移除请求
+};
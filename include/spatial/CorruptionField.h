@@ -0,0 +1,95 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+/// @brief 腐蚀场 - XZ平面上预计算的腐蚀强度标量网格
+/// @details 腐蚀源把线性衰减的影响光栅化到网格节点上，实体通过双线性插值采样。
+/// 
+/// 设计思路：
+/// 1. 每个腐蚀源记录上次光栅化时的位置、强度和范围
+/// 2. 只有当这些参数变化超过容差时，才减去旧印记、叠加新印记
+/// 3. 节点值为所有腐蚀源 power * (1 - d / radius) 之和
+/// 4. 渲染和AI可以直接读取同一份网格数据
+/// 
+/// 为何这样做：
+/// - 每帧开销从 O(腐蚀源 × 实体) 降为 O(实体 + 变化的腐蚀源)
+/// - 多个腐蚀源重叠时采样开销不变
+class CorruptionField
+{
+public:
+	/// @brief 构造函数
+	/// @details 创建覆盖 [origin, origin + size * cellSize] 区域的网格
+	/// @param width [IN] X方向节点数
+	/// @param height [IN] Z方向节点数
+	/// @param cellSize [IN] 节点间距（世界单位）
+	/// @param origin [IN] 第一个节点的XZ世界坐标
+	CorruptionField(int width = 129, int height = 129, float cellSize = 1.0f,
+		const glm::vec2& origin = glm::vec2(-64.0f, -64.0f));
+
+	/// @brief 开始新一帧的腐蚀源更新
+	/// @details 之后本帧未通过 setSource 上报的腐蚀源会被 removeStaleSources 移除
+	void beginUpdate();
+
+	/// @brief 上报一个腐蚀源的当前参数
+	/// @details 参数变化超过容差时重新光栅化，否则只记录本帧已上报
+	/// @param id [IN] 腐蚀源实体ID
+	/// @param position [IN] 腐蚀源位置
+	/// @param power [IN] 腐蚀强度
+	/// @param radius [IN] 影响范围
+	void setSource(int id, const glm::vec3& position, float power, float radius);
+
+	/// @brief 移除本帧未上报的腐蚀源
+	/// @details 用于处理被销毁的腐蚀源实体
+	void removeStaleSources();
+
+	/// @brief 采样腐蚀强度
+	/// @details 对相邻四个节点做双线性插值，网格外返回0
+	/// @param position [IN] 世界坐标
+	/// @return 腐蚀强度（每秒增加的腐蚀度）
+	float sample(const glm::vec3& position) const;
+
+	/// @brief 获取网格数据
+	/// @details 按行存放，下标为 z * width + x
+	/// @return 节点值数组
+	const std::vector<float>& getValues() const { return m_values; }
+
+	int getWidth() const { return m_width; }	// X方向节点数
+	int getHeight() const { return m_height; }	// Z方向节点数
+	float getCellSize() const { return m_cellSize; }	// 节点间距
+	const glm::vec2& getOrigin() const { return m_origin; }	// 第一个节点的XZ坐标
+
+	/// @brief 获取网格版本号
+	/// @details 每次光栅化后递增，读取方可据此判断是否需要刷新缓存
+	/// @return 版本号
+	uint32_t getVersion() const { return m_version; }
+
+private:
+	/// @brief 腐蚀源印记
+	/// @details 记录上次光栅化时使用的参数
+	struct Stamp
+	{
+		glm::vec3 position;	// 位置
+		float power;	// 强度
+		float radius;	// 范围
+		uint32_t lastSeen;	// 最后一次上报的帧序号
+	};
+
+	/// @brief 把一个印记叠加到网格上
+	/// @param stamp [IN] 印记
+	/// @param sign [IN] 1为叠加，-1为移除
+	void rasterize(const Stamp& stamp, float sign);
+
+private:
+	int m_width;	// X方向节点数
+	int m_height;	// Z方向节点数
+	float m_cellSize;	// 节点间距
+	float m_invCellSize;	// 节点间距倒数
+	glm::vec2 m_origin;	// 第一个节点的XZ坐标
+
+	std::vector<float> m_values;	// 节点值
+	std::unordered_map<int, Stamp> m_stamps;	// 已光栅化的腐蚀源
+	uint32_t m_frame;	// 当前帧序号
+	uint32_t m_version;	// 网格版本号
+};
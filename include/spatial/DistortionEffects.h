@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+
+// 前向声明
+class World;
+class SpatialIndex;
+
+/// @brief 空间扭曲效果 - 每帧解析出的逐实体时间缩放与重力牵引
+/// @details 按实体在 World::getEntities() 中的下标存放为密集数组，供移动系统直接读取。
+/// 
+/// 设计思路：
+/// 1. 每帧先把所有实体重置为默认值（时间缩放1、无重力牵引）
+/// 2. 对每个扭曲区域用空间索引查询范围内的实体并累加效果
+/// 3. 多个时间膨胀区域的缩放相乘，多个重力偏移区域的牵引相加
+/// 
+/// 为何这样做：
+/// - 开销为 O(实体 + 区域内实体)，不必让每个实体与每个扭曲逐一比较
+/// - 移动系统按下标顺序读取，无需再查找组件
+class DistortionEffects
+{
+public:
+	/// @brief 解析本帧的扭曲效果
+	/// @details 空间索引必须已在本帧重建
+	/// @param world [IN] 当前游戏世界
+	/// @param spatialIndex [IN] 空间索引
+	void resolve(World& world, const SpatialIndex& spatialIndex);
+
+	/// @brief 获取实体的时间缩放
+	/// @param slot [IN] 实体在世界实体数组中的下标
+	/// @return 时间缩放，未解析到的实体返回1
+	float getTimeScale(size_t slot) const { return slot < m_timeScales.size() ? m_timeScales[slot] : 1.0f; }
+
+	/// @brief 获取实体的重力牵引速度
+	/// @param slot [IN] 实体在世界实体数组中的下标
+	/// @return 重力牵引速度，未解析到的实体返回零向量
+	glm::vec3 getGravity(size_t slot) const { return slot < m_gravities.size() ? m_gravities[slot] : glm::vec3(0.0f); }
+
+	/// @brief 获取时间缩放数组
+	/// @return 按实体下标排列的时间缩放
+	const std::vector<float>& getTimeScales() const { return m_timeScales; }
+
+	/// @brief 获取重力牵引数组
+	/// @return 按实体下标排列的重力牵引速度
+	const std::vector<glm::vec3>& getGravities() const { return m_gravities; }
+
+private:
+	std::vector<float> m_timeScales;	// 逐实体时间缩放
+	std::vector<glm::vec3> m_gravities;	// 逐实体重力牵引速度
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class SpatialIndex;
+class CorruptionField;
+
+/// @brief 影响力图 - 粗网格上分层记录威胁、敌人密度和腐蚀浓度
+/// @details AI和刷怪逻辑通过 O(1) 采样获得战术信息，不需要自己扫描世界。
+///
+/// 设计思路：
+/// 1. 三个图层共用同一套粗网格，格子边长与空间索引一致
+/// 2. 密度层按实体ID在连续数组中记录每个敌人上次所在的格子，只有敌人跨格、出现或被销毁时才修改计数，
+///    并把该格子及四邻标记为脏，之后只重新计算脏格子的平滑值；销毁由世界的销毁监听通知，不需要逐帧对账
+/// 3. 威胁层在玩家跨格或定期刷新时向周围格子写入，每个格子记录写入时间，
+///    衰减推迟到读取或下次写入时按经过的时间一次性计算
+/// 4. 腐蚀层只在腐蚀场版本号变化时重新采样
+///
+/// 为何这样做：
+/// - 每帧开销只与发生变化的格子数有关，而不是格子总数
+/// - 惰性衰减不需要每帧遍历整个图层
+/// - 采样只是一次下标计算，适合在每个AI的决策中调用
+class InfluenceMap
+{
+public:
+	/// @brief 图层
+	enum Layer
+	{
+		Threat,		// 玩家威胁，随时间衰减
+		Crowd,		// 敌人密度（含四邻的一半）
+		Corruption,	// 腐蚀浓度
+		LayerCount
+	};
+
+	/// @brief 构造函数
+	/// @param width [IN] X方向格子数
+	/// @param height [IN] Z方向格子数
+	/// @param cellSize [IN] 格子边长（世界单位）
+	/// @param origin [IN] 网格左下角的XZ世界坐标
+	InfluenceMap(int width = 32, int height = 32, float cellSize = 4.0f,
+		const glm::vec2& origin = glm::vec2(-64.0f, -64.0f));
+
+	/// @brief 用空间索引和腐蚀场增量更新所有图层
+	/// @param index [IN] 本帧已重建的空间索引
+	/// @param corruptionField [IN] 腐蚀场，可为空
+	/// @param deltaTime [IN] 时间增量
+	void update(const SpatialIndex& index, const CorruptionField* corruptionField, float deltaTime);
+
+	/// @brief 实体被销毁时移出密度计数
+	/// @details 由世界的销毁监听调用，影响在下次更新时计入平滑值；未计入过的实体直接忽略
+	/// @param entity [IN] 被销毁的实体ID
+	void removeEntity(int entity);
+
+	/// @brief 采样某个图层
+	/// @details 取所在格子的值，网格外返回0
+	/// @param layer [IN] 图层
+	/// @param position [IN] 世界坐标
+	/// @return 图层值
+	float sample(Layer layer, const glm::vec3& position) const;
+
+	/// @brief 世界坐标转格子坐标
+	/// @param position [IN] 世界坐标
+	/// @param x [OUT] X方向格子下标
+	/// @param z [OUT] Z方向格子下标
+	/// @return 位置在网格内返回true
+	bool worldToCell(const glm::vec3& position, int& x, int& z) const;
+
+	int getWidth() const { return m_width; }	// X方向格子数
+	int getHeight() const { return m_height; }	// Z方向格子数
+	float getCellSize() const { return m_cellSize; }	// 格子边长
+
+private:
+	/// @brief 修改格子的敌人计数并标记脏格子
+	/// @param cell [IN] 格子下标，-1时忽略
+	/// @param delta [IN] 计数增量
+	void addCount(int cell, int delta);
+
+	/// @brief 重新计算脏格子的密度值
+	void resolveDirty();
+
+	/// @brief 以玩家位置为中心写入威胁
+	/// @param position [IN] 玩家位置
+	void depositThreat(const glm::vec3& position);
+
+	/// @brief 取格子衰减到当前时刻的威胁值
+	/// @param cell [IN] 格子下标
+	/// @return 威胁值
+	float decayedThreat(int cell) const;
+
+private:
+	int m_width;	// X方向格子数
+	int m_height;	// Z方向格子数
+	float m_cellSize;	// 格子边长
+	float m_invCellSize;	// 格子边长倒数
+	glm::vec2 m_origin;	// 网格左下角的XZ坐标
+
+	float m_time;	// 累计时间
+
+	// 密度层
+	std::vector<int> m_counts;	// 每个格子的敌人数
+	std::vector<float> m_crowd;	// 平滑后的密度
+	std::vector<uint8_t> m_dirtyMask;	// 是否已在脏列表中
+	std::vector<int> m_dirty;	// 脏格子列表
+	std::vector<int> m_enemyCells;	// 以实体ID为下标，敌人上次计入的格子（网格外为-1，未计入为-2）
+
+	// 威胁层
+	std::vector<float> m_threat;	// 写入时的威胁值
+	std::vector<float> m_threatTime;	// 写入时间
+	int m_playerCell;	// 上次写入威胁时玩家所在的格子
+	float m_threatTimer;	// 距离上次写入威胁的时间
+
+	// 腐蚀层
+	std::vector<float> m_corruption;	// 格子中心的腐蚀浓度
+	uint32_t m_corruptionVersion;	// 上次采样时的腐蚀场版本号
+	bool m_hasCorruption;	// 是否采样过腐蚀场
+};
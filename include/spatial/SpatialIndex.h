@@ -0,0 +1,280 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+#include "ecs/Entity.h"
+
+// 前向声明
+class World;
+
+/// @brief 空间索引 - 基于XZ平面均匀网格的实体位置索引
+/// @details 每帧由 SpatialIndexSystem 重建一次，为能力、AI等系统提供近邻与范围查询。
+/// 
+/// 设计思路：
+/// 1. 网格坐标经哈希映射到固定数量的桶，世界范围无需预先确定
+/// 2. 重建时使用计数排序，同一桶内的条目在内存中连续存放
+/// 3. k近邻查询按网格环由近及远展开，用有界最大堆保存当前最优的k个结果
+/// 4. 条目携带标签位掩码，查询可按标签过滤，也可传入组件谓词
+/// 
+/// 为何这样做：
+/// - 重建为O(N)，查询只访问目标附近的少量格子
+/// - 避免每次查询对全部实体排序（O(N log N)）
+/// - 标签过滤无需在查询中反复访问组件哈希表
+class SpatialIndex
+{
+public:
+	/// @brief 实体标签
+	/// @details 重建时根据组件计算，用于快速过滤查询结果
+	enum Tag : uint32_t
+	{
+		TagNone = 0,
+		TagPlayer = 1u << 0,	// 玩家
+		TagEnemy = 1u << 1,		// 敌人
+		TagCorruptionSource = 1u << 2,	// 腐蚀源
+		TagDistortion = 1u << 3	// 空间扭曲
+	};
+
+	/// @brief 索引条目
+	/// @details 保存实体指针、位置与标签，slot 为实体在 World::getEntities() 中的下标
+	struct Entry
+	{
+		Entity* entity;	// 实体指针
+		glm::vec3 position;	// 重建时的位置
+		uint32_t tags;	// 标签位掩码
+		int slot;	// 实体在世界实体数组中的下标
+		int cellX;	// 所在网格X坐标
+		int cellZ;	// 所在网格Z坐标
+	};
+
+	/// @brief 查询过滤条件
+	/// @details requireTags 中的所有位都必须存在，excludeTags 中的任意位都不能存在
+	struct Filter
+	{
+		uint32_t requireTags = TagNone;	// 必须拥有的标签
+		uint32_t excludeTags = TagNone;	// 必须不拥有的标签
+		const Entity* exclude = nullptr;	// 排除的实体（通常是查询者自身）
+		float maxDistance = std::numeric_limits<float>::max();	// 最大查询距离
+
+		/// @brief 检查条目是否满足标签条件
+		/// @param entry [IN] 索引条目
+		/// @return 满足返回true
+		bool accepts(const Entry& entry) const
+		{
+			return (entry.tags & requireTags) == requireTags
+				&& (entry.tags & excludeTags) == 0
+				&& entry.entity != exclude;
+		}
+	};
+
+	/// @brief 查询结果
+	/// @details 按距离从近到远排列
+	struct Neighbor
+	{
+		Entity* entity;	// 实体指针
+		float distanceSq;	// 距离平方
+		int entry;	// 在 getEntries() 中的下标
+	};
+
+public:
+	/// @brief 构造函数
+	/// @details 设置网格尺寸和哈希桶数量
+	/// @param cellSize [IN] 网格边长（世界单位）
+	/// @param bucketCount [IN] 哈希桶数量，必须是2的幂
+	explicit SpatialIndex(float cellSize = 4.0f, int bucketCount = 4096);
+
+	/// @brief 重建索引
+	/// @details 收集所有拥有 Transform 组件的实体，按网格桶进行计数排序
+	/// @param world [IN] 当前游戏世界
+	void rebuild(World& world);
+
+	/// @brief 查询k个最近的实体
+	/// @details 仅按标签过滤
+	/// @param position [IN] 查询位置
+	/// @param k [IN] 最多返回的数量
+	/// @param filter [IN] 过滤条件
+	/// @param out [OUT] 查询结果，按距离升序
+	/// @return 找到的数量
+	size_t kNearest(const glm::vec3& position, size_t k, const Filter& filter, std::vector<Neighbor>& out) const
+	{
+		return kNearest(position, k, filter, [](const Entry&) { return true; }, out);
+	}
+
+	/// @brief 查询k个最近的实体
+	/// @details 按网格环由近及远展开，当下一环的最小可能距离超过堆顶时提前结束
+	/// @tparam Pred [IN] 谓词类型，签名为 bool(const Entry&)
+	/// @param position [IN] 查询位置
+	/// @param k [IN] 最多返回的数量
+	/// @param filter [IN] 过滤条件
+	/// @param pred [IN] 额外谓词，用于按组件过滤
+	/// @param out [OUT] 查询结果，按距离升序
+	/// @return 找到的数量
+	template <typename Pred>
+	size_t kNearest(const glm::vec3& position, size_t k, const Filter& filter, Pred&& pred, std::vector<Neighbor>& out) const;
+
+	/// @brief 查询k个拥有指定组件的最近实体
+	/// @tparam T [IN] 组件类型
+	/// @param position [IN] 查询位置
+	/// @param k [IN] 最多返回的数量
+	/// @param filter [IN] 过滤条件
+	/// @param out [OUT] 查询结果，按距离升序
+	/// @return 找到的数量
+	template <typename T>
+	size_t kNearestWith(const glm::vec3& position, size_t k, const Filter& filter, std::vector<Neighbor>& out) const
+	{
+		return kNearest(position, k, filter, [](const Entry& e) { return e.entity->hasComponent<T>(); }, out);
+	}
+
+	/// @brief 遍历半径内的实体
+	/// @details 只访问与查询圆包围盒相交的格子
+	/// @tparam Fn [IN] 回调类型，签名为 void(const Entry&, float distanceSq)
+	/// @param position [IN] 查询中心
+	/// @param radius [IN] 查询半径
+	/// @param filter [IN] 过滤条件（maxDistance 被忽略）
+	/// @param fn [IN] 回调
+	template <typename Fn>
+	void forEachInRadius(const glm::vec3& position, float radius, const Filter& filter, Fn&& fn) const
+	{
+		if (m_entries.empty()) return;
+		const float radiusSq = radius * radius;
+		const int x0 = std::max(cellCoord(position.x - radius), m_minCellX);
+		const int x1 = std::min(cellCoord(position.x + radius), m_maxCellX);
+		const int z0 = std::max(cellCoord(position.z - radius), m_minCellZ);
+		const int z1 = std::min(cellCoord(position.z + radius), m_maxCellZ);
+		for (int z = z0; z <= z1; ++z) {
+			for (int x = x0; x <= x1; ++x) {
+				forEachInCell(x, z, [&](int entryIndex) {
+					const Entry& e = m_entries[entryIndex];
+					if (!filter.accepts(e)) return;
+					glm::vec3 d = e.position - position;
+					float distSq = glm::dot(d, d);
+					if (distSq <= radiusSq) fn(e, distSq);
+				});
+			}
+		}
+	}
+
+	/// @brief 获取所有条目
+	/// @details 条目按网格桶排列
+	/// @return 条目数组
+	const std::vector<Entry>& getEntries() const { return m_entries; }
+
+	/// @brief 获取网格边长
+	/// @return 网格边长
+	float getCellSize() const { return m_cellSize; }
+
+private:
+	/// @brief 计算世界坐标所在的网格坐标
+	/// @param v [IN] 世界坐标分量
+	/// @return 网格坐标
+	int cellCoord(float v) const { return static_cast<int>(std::floor(v * m_invCellSize)); }
+
+	/// @brief 计算网格的哈希桶
+	/// @param cx [IN] 网格X坐标
+	/// @param cz [IN] 网格Z坐标
+	/// @return 桶下标
+	int bucketOf(int cx, int cz) const
+	{
+		uint32_t h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cz) * 19349663u;
+		return static_cast<int>(h & static_cast<uint32_t>(m_bucketCount - 1));
+	}
+
+	/// @brief 遍历一个网格内的条目
+	/// @tparam Fn [IN] 回调类型，签名为 void(int entryIndex)
+	/// @param cx [IN] 网格X坐标
+	/// @param cz [IN] 网格Z坐标
+	/// @param fn [IN] 回调
+	template <typename Fn>
+	void forEachInCell(int cx, int cz, Fn&& fn) const
+	{
+		int bucket = bucketOf(cx, cz);
+		for (int i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i) {
+			const Entry& e = m_entries[i];
+			if (e.cellX == cx && e.cellZ == cz)	// 哈希冲突时跳过其他格子的条目
+				fn(i);
+		}
+	}
+
+private:
+	float m_cellSize;	// 网格边长
+	float m_invCellSize;	// 网格边长倒数
+	int m_bucketCount;	// 哈希桶数量
+
+	std::vector<Entry> m_entries;	// 按桶排序的条目
+	std::vector<int> m_bucketStart;	// 每个桶在条目数组中的起始位置（长度为桶数+1）
+	std::vector<Entry> m_unsorted;	// 重建时的临时条目，复用以避免每帧分配
+	std::vector<int> m_cursor;	// 重建时每个桶的写入位置
+
+	int m_minCellX, m_maxCellX;	// 已占用网格的X范围
+	int m_minCellZ, m_maxCellZ;	// 已占用网格的Z范围
+};
+
+template <typename Pred>
+size_t SpatialIndex::kNearest(const glm::vec3& position, size_t k, const Filter& filter, Pred&& pred, std::vector<Neighbor>& out) const
+{
+	out.clear();
+	if (k == 0 || m_entries.empty()) return 0;
+
+	const float maxDistSq = filter.maxDistance * filter.maxDistance;	// 默认值平方后为inf，不限制距离
+	auto farther = [](const Neighbor& a, const Neighbor& b) { return a.distanceSq < b.distanceSq; };
+
+	const int cx = cellCoord(position.x);
+	const int cz = cellCoord(position.z);
+
+	// 查询点到所在格子边界的最短距离，用于估算每一环的最小距离
+	const float fx = position.x - cx * m_cellSize;
+	const float fz = position.z - cz * m_cellSize;
+	const float edge = std::min(std::min(fx, m_cellSize - fx), std::min(fz, m_cellSize - fz));
+
+	// 超出已占用范围的环不可能再有条目
+	const int maxRing = std::max(std::max(std::abs(cx - m_minCellX), std::abs(cx - m_maxCellX)),
+		std::max(std::abs(cz - m_minCellZ), std::abs(cz - m_maxCellZ)));
+
+	auto visit = [&](int entryIndex) {
+		const Entry& e = m_entries[entryIndex];
+		if (!filter.accepts(e)) return;
+		glm::vec3 d = e.position - position;
+		float distSq = glm::dot(d, d);
+		if (distSq > maxDistSq) return;
+		if (out.size() == k && distSq >= out.front().distanceSq) return;
+		if (!pred(e)) return;
+
+		if (out.size() == k) {
+			std::pop_heap(out.begin(), out.end(), farther);
+			out.pop_back();
+		}
+		out.push_back({ e.entity, distSq, entryIndex });
+		std::push_heap(out.begin(), out.end(), farther);
+	};
+
+	for (int ring = 0; ring <= maxRing; ++ring) {
+		if (ring > 0) {
+			float ringMin = (ring - 1) * m_cellSize + edge;
+			float ringMinSq = ringMin * ringMin;
+			if (ringMinSq > maxDistSq) break;
+			if (out.size() == k && ringMinSq >= out.front().distanceSq) break;
+		}
+
+		if (ring == 0) {
+			forEachInCell(cx, cz, visit);
+			continue;
+		}
+		// 按环的四条边遍历，只访问已占用范围内的格子
+		const int x0 = std::max(cx - ring, m_minCellX), x1 = std::min(cx + ring, m_maxCellX);
+		const int z0 = std::max(cz - ring + 1, m_minCellZ), z1 = std::min(cz + ring - 1, m_maxCellZ);
+		for (int x = x0; x <= x1; ++x) {
+			if (cz - ring >= m_minCellZ) forEachInCell(x, cz - ring, visit);
+			if (cz + ring <= m_maxCellZ) forEachInCell(x, cz + ring, visit);
+		}
+		for (int z = z0; z <= z1; ++z) {
+			if (cx - ring >= m_minCellX) forEachInCell(cx - ring, z, visit);
+			if (cx + ring <= m_maxCellX) forEachInCell(cx + ring, z, visit);
+		}
+	}
+
+	std::sort_heap(out.begin(), out.end(), farther);
+	return out.size();
+}
@@ -1,24 +1,63 @@
 #pragma once
 #include "ecs/System.h"
 #include "components/AI.h"
+#include "ai/BehaviorTree.h"
+#include "ai/Perception.h"
+#include "ai/Utility.h"
+
+#include <vector>
+#include <glm/glm.hpp>
 
 // 前向声明
 class Entity;
+struct Transform;
+struct Velocity;
+struct MovementProperties;
+struct Health;
+struct Attack;
+struct CombatInput;
+class FlowField;
+class Pathfinder;
+class NavGrid;
+class JobSystem;
+class InfluenceMap;
 
 /// @brief AI系统 - 管理所有AI实体的行为
 /// @details 该系统负责更新AI实体的状态和行为，包括空闲、巡逻、追逐和攻击等状态。
 /// 
 /// 设计思路：
 /// 1. 每个AI实体都有一个AI组件，包含当前状态和相关参数。
-/// 2. 系统在每帧更新时遍历所有AI实体，根据其状态调用相应的行为方法。
-/// 3. 行为方法实现具体的逻辑，如移动、攻击等。
+/// 2. 每帧把需要更新的实体按状态分到空闲、巡逻、追逐、攻击四个桶，组件只在入桶时获取一次。
+/// 3. 每个桶用一个紧凑循环处理，状态切换先记录下来，帧末统一应用，实体在下一帧进入新桶。
+/// 4. 按与玩家的距离分为近、中、远三档细节层次，中远档每N帧才更新一次，
+///    跳过的时间累积后一次性传入；每档内部轮流更新，把工作量均摊到各帧。
+/// 5. 追逐时能直接看到玩家就直线逼近，视线被挡住时才沿共享流场绕行，流场不可用时仍直线逼近。
+/// 6. 巡逻时向寻路服务异步请求通往巡逻点的路径，结果返回前先直线前进。
+/// 7. 带 Behavior 组件的实体单独成桶，执行数据驱动的行为树，叶子复用状态机的移动和攻击逻辑。
+/// 8. 每帧开头由感知阶段批量计算所有实体到玩家的距离、方向和可见性，
+///    细节层次分档和各个行为阶段都只读取感知结果；玩家实体的位置会被缓存，不必每帧线性查找。
+/// 9. 是否追逐、攻击或休整由效用评估器决定：距离、生命值、腐蚀浓度、同伴密度等输入经响应曲线打分，
+///    所有入桶实体一次批量评估，各状态只负责执行和按计时在空闲与巡逻之间切换。
 /// 
 /// 为何这样做：
 /// - 将AI逻辑集中在一个系统中，便于管理和扩展。
-/// - 通过状态机模式实现不同状态的行为，增强代码可读性和可维护性。
-/// - 支持多种AI行为，便于未来添加新功能或修改现有逻辑。
+/// - 同一个循环里的实体执行相同的分支，分支预测稳定，距离和计时可以向量化计算。
+/// - 空闲实体只需累加计时并比较距离，几乎没有开销。
+/// - 远处的敌人不需要每帧决策，细节层次让每帧的AI开销有上限，近处敌人仍然及时响应。
+/// - 新敌人类型通过行为树文件定义，同样享受细节层次和分桶处理。
 class AISystem : public System {
 public:
+    /// @brief 构造函数
+    /// @param flowField [IN] 指向玩家的流场，可为空
+    /// @param pathfinder [IN] 寻路服务，可为空
+    /// @param behaviorTrees [IN] 行为树库，可为空
+    /// @param navGrid [IN] 用于视线检查的导航网格，可为空
+    /// @param jobSystem [IN] 用于并行计算感知和效用的任务系统，可为空
+    /// @param influenceMap [IN] 影响力图，提供效用评估的腐蚀和密度输入，可为空
+    AISystem(const FlowField* flowField = nullptr, Pathfinder* pathfinder = nullptr,
+        const BehaviorTreeLibrary* behaviorTrees = nullptr, const NavGrid* navGrid = nullptr,
+        JobSystem* jobSystem = nullptr, const InfluenceMap* influenceMap = nullptr);
+
     /// @brief 更新系统状态
     /// @details 每帧调用一次，处理符合条件的实体和组件
     /// @param world [IN] 当前游戏世界
@@ -26,36 +65,184 @@ public:
     virtual void update(World& world, float deltaTime) override;
 
 private:
-    /// @brief 更新AI状态
-	/// @details 根据实体的AI组件状态，调用相应的行为方法
-	/// @param entity [IN] 当前实体
-	/// @param player [IN] 玩家实体，用于追逐和攻击逻辑
-	/// @param deltaTime [IN] 时间增量
-    void updateAI(Entity* entity, Entity* player, float deltaTime);
+    /// @brief 细节层次档位
+    enum LodTier {
+        LodNear,    // 近处：每帧更新
+        LodMid,     // 中距离：每隔几帧更新
+        LodFar,     // 远处：粗略更新
+        LodTierCount
+    };
+
+    /// @brief 效用评估的输入
+    enum UtilityInput {
+        InputChaseRatio,    // 距离 / 追逐范围
+        InputAttackRatio,   // 距离 / 攻击距离
+        InputVisible,       // 能否看到玩家（0或1）
+        InputHealth,        // 生命值比例
+        InputCorruption,    // 所在位置的腐蚀浓度
+        InputCrowd,         // 所在位置的同伴密度
+        UtilityInputCount
+    };
+
+    /// @brief 效用评估的候选行动
+    enum UtilityAction {
+        ActionRest,         // 休整：空闲或巡逻
+        ActionChase,        // 追逐
+        ActionAttack,       // 攻击
+        UtilityActionCount
+    };
+
+    /// @brief 同一状态的实体数据（SoA）
+    struct StateBucket {
+        std::vector<Entity*> entities;                  // 实体
+        std::vector<AI*> ais;                           // AI组件
+        std::vector<Transform*> transforms;             // 变换组件
+        std::vector<Velocity*> velocities;              // 速度组件
+        std::vector<MovementProperties*> movements;     // 移动属性组件
+        std::vector<float> deltaTimes;                  // 本次更新的时间增量（含跳帧累积）
+        std::vector<float> stateTimes;                  // 状态持续时间
+        std::vector<uint32_t> agents;                   // 在感知数组中的下标
+
+        /// @brief 清空桶
+        void clear();
+    };
+
+    /// @brief 延迟到帧末应用的状态切换
+    struct Transition {
+        AI* ai;                 // AI组件
+        Velocity* velocity;     // 速度组件
+        AIState state;          // 目标状态
+    };
+
+    /// @brief 查找玩家实体并记录本帧玩家信息
+    /// @details 优先检查上一帧缓存的位置，玩家被移动或销毁时才重新查找
+    /// @param world [IN] 当前游戏世界
+    void findPlayer(World& world);
+
+    /// @brief 根据感知结果计算实体所在的细节层次档位
+    /// @param agent [IN] 实体在感知数组中的下标
+    /// @return 档位
+    LodTier classify(uint32_t agent) const;
+
+    /// @brief 用累积的时间把实体放入对应状态的桶
+    /// @details 被同化的实体在这里处理，不进入任何桶
+    /// @param agent [IN] 实体在感知数组中的下标
+    void gather(uint32_t agent);
+
+    /// @brief 填写实体的效用评估输入和当前行动
+    /// @param entity [IN] 当前实体
+    /// @param ai [IN] AI组件
+    /// @param agent [IN] 实体在感知数组中的下标
+    void fillUtilityInputs(Entity* entity, const AI* ai, uint32_t agent);
+
+    /// @brief 推进桶内实体的状态计时
+    /// @param bucket [IN/OUT] 状态桶
+    void prepare(StateBucket& bucket);
 
     /// @brief 空闲状态行为
-	/// @details 实体在空闲状态下的行为逻辑，如随机移动或等待
-	/// @param entity [IN] 当前实体
-	/// @param deltaTime [IN] 时间增量
-    void idleBehavior(Entity* entity, float deltaTime);
+    /// @details 空闲时间结束转为巡逻，看到玩家转为追逐
+    void updateIdle();
 
     /// @brief 巡逻状态行为
-	/// @details 实体在巡逻状态下的行为逻辑，如沿路径移动
-	/// @param entity [IN] 当前实体
-	/// @param deltaTime [IN] 时间增量
-    void patrolBehavior(Entity* entity, float deltaTime);
+    /// @details 沿巡逻点移动，巡逻时间结束转为空闲，看到玩家转为追逐
+    void updatePatrol();
 
     /// @brief 追逐状态行为
-	/// @details 实体在追逐状态下的行为逻辑，如向玩家移动
-	/// @param entity [IN] 当前实体
-	/// @param player [IN] 玩家实体，用于追逐逻辑
-	/// @param deltaTime [IN] 时间增量
-    void chaseBehavior(Entity* entity, Entity* player, float deltaTime);
+    /// @details 向玩家移动，接近后转为攻击，玩家太远转回巡逻
+    void updateChase();
+
+    /// @brief 沿巡逻点移动一步
+    /// @param bucket [IN/OUT] 实体所在的桶
+    /// @param i [IN] 实体在桶中的下标
+    /// @return 没有巡逻点时返回false
+    bool patrolStep(StateBucket& bucket, size_t i);
+
+    /// @brief 向玩家移动一步，看得见玩家时直线逼近，否则沿流场
+    /// @param bucket [IN/OUT] 实体所在的桶
+    /// @param i [IN] 实体在桶中的下标
+    void chaseStep(StateBucket& bucket, size_t i);
+
+    /// @brief 按给定方向和速度移动，并平滑转向
+    /// @param bucket [IN/OUT] 实体所在的桶
+    /// @param i [IN] 实体在桶中的下标
+    /// @param direction [IN] 单位方向
+    /// @param speed [IN] 基础移动速度
+    void moveToward(StateBucket& bucket, size_t i, const glm::vec3& direction, float speed);
+
+    /// @brief 原地停止
+    /// @param bucket [IN/OUT] 实体所在的桶
+    /// @param i [IN] 实体在桶中的下标
+    void stop(StateBucket& bucket, size_t i);
+
+    /// @brief 获取巡逻时下一步要去的位置
+    /// @details 必要时发起或取回寻路请求，路径不可用时直接返回巡逻点
+    /// @param ai [IN/OUT] AI组件
+    /// @param position [IN] 当前位置
+    /// @param target [IN] 当前巡逻点
+    /// @return 下一个路径点
+    glm::vec3 nextPatrolWaypoint(AI* ai, const glm::vec3& position, const glm::vec3& target);
+
+    /// @brief 放弃当前路径及进行中的寻路请求
+    /// @param ai [IN/OUT] AI组件
+    void resetPath(AI* ai);
 
     /// @brief 攻击状态行为
-	/// @details 实体在攻击状态下的行为逻辑，如执行攻击动作
-	/// @param entity [IN] 当前实体
-	/// @param player [IN] 玩家实体，用于攻击逻辑
-	/// @param deltaTime [IN] 时间增量
-    void attackBehavior(Entity* entity, Entity* player, float deltaTime);
-};
\ No newline at end of file
+    /// @details 冷却结束且面向玩家时发起攻击，玩家离开攻击范围转为追逐
+    void updateAttack();
+
+    /// @brief 冷却结束且面向玩家时攻击，否则转向玩家
+    /// @param bucket [IN/OUT] 实体所在的桶
+    /// @param i [IN] 实体在桶中的下标
+    /// @param attack [IN/OUT] 攻击组件
+    /// @param combat [IN/OUT] 战斗输入组件
+    /// @return 本次是否发起了攻击
+    bool attackStep(StateBucket& bucket, size_t i, Attack* attack, CombatInput* combat);
+
+    /// @brief 执行行为树桶内每个实体的行为树
+    void updateBehaviors();
+
+    /// @brief 执行行为树叶子节点
+    /// @param i [IN] 实体在行为树桶中的下标
+    /// @param node [IN] 叶子节点
+    /// @param slot [IN/OUT] 节点的黑板槽位，可为空
+    /// @param resumed [IN] 是否从上次运行中的状态继续
+    /// @return 节点执行结果
+    BehaviorStatus runLeaf(size_t i, const BehaviorTree::Node& node, float* slot, bool resumed);
+
+    /// @brief 记录状态切换
+    /// @param bucket [IN] 实体所在的桶
+    /// @param i [IN] 实体在桶中的下标
+    /// @param state [IN] 目标状态
+    void requestTransition(const StateBucket& bucket, size_t i, AIState state);
+
+    /// @brief 应用本帧记录的所有状态切换
+    void applyTransitions();
+
+private:
+    std::vector<Entity*> m_agents;                 // 本帧登记到感知阶段的实体
+    Perception m_perception;                       // 感知结果，与 m_agents 一一对应
+    UtilityEvaluator m_utility;                    // 效用评估，与 m_agents 一一对应
+    std::vector<uint32_t> m_tiers[LodTierCount];   // 每档本帧的实体（感知下标）
+    size_t m_cursors[LodTierCount] = {};           // 每档轮询的起始位置
+
+    StateBucket m_idle;     // 空闲桶
+    StateBucket m_patrol;   // 巡逻桶
+    StateBucket m_chase;    // 追逐桶
+    StateBucket m_attack;   // 攻击桶
+    StateBucket m_behavior; // 行为树桶
+    std::vector<Behavior*> m_behaviors;     // 行为树桶对应的行为组件
+    std::vector<Transition> m_transitions;  // 帧末应用的状态切换
+
+    const FlowField* m_pFlowField;          // 流场
+    Pathfinder* m_pPathfinder;              // 寻路服务
+    const BehaviorTreeLibrary* m_pBehaviorTrees;    // 行为树库
+    JobSystem* m_pJobSystem;                // 任务系统
+    const InfluenceMap* m_pInfluenceMap;    // 影响力图
+
+    // 本帧玩家信息
+    Entity* m_pPlayer = nullptr;            // 玩家实体
+    Health* m_pPlayerHealth = nullptr;      // 玩家生命值
+    glm::vec3 m_playerPosition = glm::vec3(0.0f);   // 玩家位置
+    int m_playerId = -1;                    // 缓存的玩家实体ID
+    size_t m_playerSlot = 0;                // 缓存的玩家实体在实体数组中的位置
+};
@@ -4,9 +4,15 @@
 #include "components/DarkEnergy.h"
 #include "components/Corruption.h"
 #include "components/Transform.h"
+#include "ability/EffectVM.h"
 
 // 前向声明
 class Entity;
+class SpatialIndex;
+class CorruptionDiffusion;
+class DamageQueue;
+class ProjectilePool;
+class EffectLibrary;
 
 /// @brief 能力系统 - 管理界痕能力的激活和效果
 /// @details 处理能力的激活、效果应用和冷却逻辑
@@ -15,14 +21,50 @@ class Entity;
 /// 1. 处理能力的激活请求
 /// 2. 消耗暗能量并应用能力效果
 /// 3. 增加腐蚀度作为风险代价
+/// 4. 每种能力的名称、消耗、冷却、腐蚀系数和效果程序名集中在一张按能力类型下标排列的常量表中
+/// 5. 冷却记录结束时刻，与系统自己的时钟比较，不逐帧递减
+/// 6. 能力效果是从数据文件编译的效果程序，同一帧同一能力的施放收集成批，交给效果虚拟机一起执行
 /// 
 /// 为何这样做：
 /// - 实现游戏核心玩法机制
 /// - 统一管理能力逻辑
 /// - 平衡能力收益与风险
+/// - 新增能力只需在表中加一行，表的长度和顺序在编译期检查
+/// - 处理请求只有数组下标和位运算，没有哈希查找
+/// - 调整能力效果只需修改数据文件，施放过程不分配内存
 class AbilitySystem : public System
 {
 public:
+	/// @brief 能力定义
+	struct AbilityDef
+	{
+		AbilityType type;	// 能力类型，必须与在表中的下标一致
+		const char* name;	// 名称，用于日志
+		float cost;	// 暗能量消耗
+		float cooldown;	// 冷却时间（秒）
+		float corruptionFactor;	// 每点消耗增加的腐蚀度
+		const char* script;	// 效果程序名称
+	};
+
+	/// @brief 获取能力定义
+	/// @param type [IN] 能力类型
+	/// @return 能力定义
+	static constexpr const AbilityDef& getAbility(AbilityType type) { return s_abilities[abilityIndex(type)]; }
+
+	/// @brief 构造函数
+	/// @details 保存效果作用的共享服务，并把能力表中的效果程序名称解析为程序ID
+	/// @param spatialIndex [IN] 空间索引
+	/// @param corruptionDiffusion [IN] 腐蚀扩散场
+	/// @param damageQueue [IN] 伤害队列
+	/// @param projectiles [IN] 投射物池
+	/// @param effects [IN] 能力效果库
+	AbilitySystem(SpatialIndex* spatialIndex, CorruptionDiffusion* corruptionDiffusion,
+		DamageQueue* damageQueue, ProjectilePool* projectiles, const EffectLibrary* effects);
+
+	/// @brief 析构函数
+	/// @details 把效果指令的耗时统计写入日志
+	~AbilitySystem();
+
     /// @brief 更新系统状态
     /// @details 每帧调用一次，处理符合条件的实体和组件
     /// @param world [IN] 当前游戏世界
@@ -37,39 +79,31 @@ public:
 	bool activateAbility(Entity* entity, AbilityType type);
 
 private:
-	/// @brief 应用感知能力效果
-	/// @details 显示隐藏元素并消耗暗能量
-	/// @param entity [IN] 实体
-	/// @return 是否成功应用效果
-	bool applyPerception(Entity* entity);
-	/// @brief 应用操控能力效果
-	/// @details 移动物体并消耗暗能量
-	/// @param entity [IN] 实体
-	/// @return 是否成功应用效果
-	bool applyManipulation(Entity* entity);
-	/// @brief 应用扭曲能力效果
-	/// @details 改变重力并消耗暗能量
-	/// @param entity [IN] 实体
-	/// @return 是否成功应用效果
-	bool applyDistortion(Entity* entity);
-	/// @brief 应用同化能力效果
-	/// @details 控制敌人并消耗暗能量
+	/// @brief 检查并扣除施放消耗
 	/// @param entity [IN] 实体
-	/// @return 是否成功应用效果
-	bool applyAssimilation(Entity* entity);
-	/// @brief 应用净化能力效果
-	/// @details 减少腐蚀并消耗暗能量
+	/// @param ability [IN] 能力定义
+	/// @return 是否可以施放
+	bool payCost(Entity* entity, const AbilityDef& ability);
+
+	/// @brief 执行一种能力已收集的所有施放
+	/// @param index [IN] 能力下标
+	void flush(size_t index);
+
+	/// @brief 根据效果结果结算一次施放
+	/// @details 成功时设置冷却并增加腐蚀度
 	/// @param entity [IN] 实体
-	/// @return 是否成功应用效果
-	bool applyPurification(Entity* entity);
-	/// @brief 将能力类型转换为字符串
-	/// @details 用于调试和日志输出
-	/// @param type [IN] 能力类型
-	/// @return 能力类型字符串表示
-	std::string abilityTypeToString(AbilityType type) const;
-	/// @brief 获取能力冷却时间
-	/// @details 根据能力类型返回冷却时间
-	/// @param type [IN] 能力类型
-	/// @return 冷却时间（秒）
-	float getCooldownDuration(AbilityType type) const;
+	/// @param ability [IN] 能力定义
+	/// @param success [IN] 效果是否成功
+	void finishCast(Entity* entity, const AbilityDef& ability, bool success);
+
+private:
+	static const AbilityDef s_abilities[ABILITY_COUNT];	// 能力表，按能力类型下标排列
+
+	const EffectLibrary* m_pEffects;	// 能力效果库
+	EffectVM m_vm;	// 效果虚拟机
+	int m_programs[ABILITY_COUNT];	// 每种能力的效果程序ID，-1 表示缺失
+	Entity* m_batches[ABILITY_COUNT][EffectVM::MaxBatch];	// 每种能力本帧收集的施法者
+	int m_batchSizes[ABILITY_COUNT];	// 每种能力已收集的施放数
+	bool m_results[EffectVM::MaxBatch];	// 效果执行结果
+	float m_time;	// 系统时钟，冷却结束时刻以此为准
 };
\ No newline at end of file
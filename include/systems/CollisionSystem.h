@@ -0,0 +1,160 @@
+#pragma once
+#include "ecs/System.h"
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// 前向声明
+class Entity;
+struct Transform;
+struct Velocity;
+struct Collider;
+
+/// @brief 碰撞系统 - 检测实体间的碰撞并把它们推开
+/// @details 在移动系统之后运行，读取移动系统写入的位置和速度，修正互相重叠的实体位置。
+/// 
+/// 设计思路：
+/// 1. 粗检测：把碰撞体按XZ网格做计数排序，只检查相邻格子
+/// 2. 细检测：竖直胶囊体之间的最短距离（球体视为退化的胶囊体）
+/// 3. 求解：多次迭代按质量倒数分配位置修正
+/// 4. 休眠：通过接触关系求出连通的岛，整座岛都静止足够久才一起休眠
+/// 5. 碰撞体表常驻：新实体按ID从实体数组尾部发现，销毁由世界的销毁监听通知，
+///    每帧只为清醒实体收集数据和构建网格；休眠实体放在数据数组前部并有单独的静态网格，
+///    只在有实体入睡、被唤醒或被销毁时重建，平时每帧只通过缓存的组件指针检查是否需要唤醒
+/// 
+/// 为何这样做：
+/// - 追逐玩家的敌人不再互相穿透
+/// - 粗检测把配对数量从 O(N²) 降到 O(N)
+/// - 休眠实体不查找组件、不参与网格构建，也不互相生成配对，静止敌群每帧只剩唤醒检查
+class CollisionSystem : public System
+{
+public:
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，处理所有拥有 Transform 和 Collider 组件的实体
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+	/// @brief 实体被销毁时移出碰撞体表
+	/// @details 由世界的销毁监听调用，不是碰撞体的实体直接忽略
+	/// @param entity [IN] 被销毁的实体ID
+	void removeEntity(int entity);
+
+private:
+	/// @brief 常驻碰撞体表中的一项
+	/// @details 组件指针在实体存活期间保持有效，transform 为空表示实体已销毁、等待从列表中移除
+	struct Body
+	{
+		Transform* transform;	// 变换组件
+		Velocity* velocity;	// 速度组件（可能为空）
+		Collider* collider;	// 碰撞体组件
+	};
+
+	/// @brief 粗检测网格
+	/// @details 按桶计数排序的数据下标
+	struct Grid
+	{
+		float cellSize = 1.0f;	// 网格边长
+		float maxRadius = 0.0f;	// 网格中最大的碰撞体半径
+		uint32_t bucketMask = 0;	// 桶数量减一
+		std::vector<int> bucketStart;	// 每个桶的起始位置
+		std::vector<int> sorted;	// 按桶排序的数据下标
+	};
+
+	/// @brief 接触信息
+	struct Contact
+	{
+		int a;	// 碰撞体A下标
+		int b;	// 碰撞体B下标
+	};
+
+	/// @brief 把上次更新之后加入世界的碰撞体加入常驻表
+	/// @details 实体按ID递增存放，只需从数组尾部向前找到上次见过的ID
+	/// @param world [IN] 当前游戏世界
+	void addNewBodies(World& world);
+
+	/// @brief 整理清醒和休眠列表，唤醒开始移动或被移动的休眠实体
+	void updateBodyLists();
+
+	/// @brief 重建数据数组前部的休眠实体数据和静态网格
+	void rebuildStatic();
+
+	/// @brief 在数据数组后部收集清醒实体的数据
+	void gatherAwake();
+
+	/// @brief 把 [begin, end) 范围的数据构建成粗检测网格
+	/// @param grid [OUT] 网格
+	/// @param begin [IN] 起始数据下标
+	/// @param end [IN] 结束数据下标
+	void buildGrid(Grid& grid, int begin, int end);
+
+	/// @brief 释放碰撞体表中的一项
+	/// @param body [IN] 碰撞体表下标
+	void releaseBody(int body);
+
+	/// @brief 生成可能重叠的配对
+	void findContacts();
+
+	/// @brief 迭代推开重叠的实体
+	void solveContacts();
+
+	/// @brief 更新休眠计时并按岛进入休眠
+	/// @param deltaTime [IN] 时间增量
+	void updateSleeping(float deltaTime);
+
+	/// @brief 计算两个碰撞体的分离向量
+	/// @details 返回值为需要把B沿法线推开的距离，小于等于0表示未重叠
+	/// @param a [IN] 碰撞体A下标
+	/// @param b [IN] 碰撞体B下标
+	/// @param nx [OUT] 法线X分量（从A指向B）
+	/// @param ny [OUT] 法线Y分量
+	/// @param nz [OUT] 法线Z分量
+	/// @return 穿透深度
+	float penetration(int a, int b, float& nx, float& ny, float& nz) const;
+
+	/// @brief 并查集查找
+	/// @param i [IN] 碰撞体下标
+	/// @return 所在岛的代表下标
+	int findIsland(int i);
+
+	/// @brief 计算网格的哈希桶
+	static int bucketOf(const Grid& grid, int cx, int cz)
+	{
+		uint32_t h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cz) * 19349663u;
+		return static_cast<int>(h & grid.bucketMask);
+	}
+
+private:
+	// 常驻碰撞体表
+	std::vector<Body> m_bodies;	// 碰撞体表
+	std::vector<int> m_freeBodies;	// 空闲的表项
+	std::unordered_map<int, int> m_bodyOfEntity;	// 实体ID -> 表项，只在实体加入和销毁时查找
+	std::vector<int> m_awakeBodies;	// 清醒的表项
+	std::vector<int> m_sleepingBodies;	// 休眠的表项，前 m_staticCount 个与数据数组前部一一对应
+	int m_lastEntityId = -1;	// 已经检查过的最大实体ID
+	bool m_staticDirty = false;	// 休眠集合是否变化，需要重建静态数据
+	int m_staticCount = 0;	// 数据数组前部的休眠实体数
+
+	// 碰撞体数据（SoA），[0, m_staticCount) 为休眠实体，之后为本帧的清醒实体
+	std::vector<Transform*> m_transforms;	// 变换组件
+	std::vector<Velocity*> m_velocities;	// 速度组件（可能为空）
+	std::vector<Collider*> m_colliders;	// 碰撞体组件
+	std::vector<float> m_x, m_y, m_z;	// 位置
+	std::vector<float> m_radius;	// 半径
+	std::vector<float> m_segment;	// 胶囊中心线长度
+	std::vector<float> m_inverseMass;	// 质量倒数（休眠中视为0）
+	std::vector<float> m_correction;	// 本帧累计位置修正量
+	std::vector<uint8_t> m_awake;	// 是否清醒
+	std::vector<int> m_woken;	// 本帧被挤压唤醒的休眠实体数据下标
+
+	// 粗检测网格
+	Grid m_dynamicGrid;	// 清醒实体的网格，每帧重建
+	Grid m_staticGrid;	// 休眠实体的网格，休眠集合变化时重建
+	std::vector<int> m_cellX, m_cellZ;	// 每个碰撞体在所属网格中的坐标
+	std::vector<int> m_cursor;	// 计数排序写入位置
+
+	std::vector<Contact> m_contacts;	// 本帧接触对
+	std::vector<int> m_islandParent;	// 并查集父节点
+	std::vector<float> m_islandTimer;	// 每座岛的最短静止时间
+};
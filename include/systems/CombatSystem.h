@@ -3,20 +3,28 @@
 
 // 前向声明
 class Entity;
+class SpatialIndex;
+class DamageQueue;
 
 /// @brief 战斗系统 - 处理实体之间的战斗逻辑
 /// @details 该系统负责处理实体之间的攻击、伤害计算和区域伤害等逻辑。
 /// 
 /// 设计思路：
-/// 1. 实体之间的攻击通过调用 `applyDamage` 方法实现，计算伤害并应用到目标实体上。
-/// 2. 区域伤害通过 `applyAreaDamage` 方法实现，影响指定半径内的所有实体。
-/// 3. 系统在每帧更新时检查实体状态，处理战斗相关的逻辑。
+/// 1. 实体之间的攻击通过调用 `applyDamage` 方法实现，向伤害队列追加伤害事件。
+/// 2. 区域伤害通过 `applyAreaDamage` 方法实现，用空间索引找出半径内的实体并追加事件。
+/// 3. 每帧最后统一结算伤害队列，包括其他系统追加的事件。
 /// 
 /// 为何这样做：
 /// - 将战斗逻辑集中在一个系统中，便于管理和扩展。
 /// - 使用方法分离攻击和区域伤害逻辑，提高代码的可读性和可维护性。
+/// - 伤害只追加不立即生效，同一目标的多次命中在结算时合并处理。
 class CombatSystem : public System {
 public:
+	/// @brief 构造函数
+	/// @param spatialIndex [IN] 空间索引，用于查找区域伤害的目标
+	/// @param damageQueue [IN] 伤害队列
+	CombatSystem(const SpatialIndex* spatialIndex, DamageQueue* damageQueue);
+
 	/// @brief 更新系统状态
 	/// @details 每帧调用一次，处理符合条件的实体和组件
 	/// @param world [IN] 当前游戏世界
@@ -24,16 +32,20 @@ public:
     void update(World& world, float deltaTime) override;
 
 private:
-	/// @brief 应用伤害到目标实体
-	/// @details 计算伤害并更新目标实体的生命值
+	/// @brief 对目标实体造成伤害
+	/// @details 追加一个物理伤害事件，帧末结算
 	/// @param attacker [IN] 攻击者实体
 	/// @param target [IN] 目标实体
 	/// @param damage [IN] 伤害值
     void applyDamage(Entity* attacker, Entity* target, float damage);
-	/// @brief 应用区域伤害到指定半径内的所有实体
-	/// @details 计算区域内所有实体的伤害并更新其生命值
+	/// @brief 对指定半径内的所有实体造成伤害
+	/// @details 为半径内的每个实体追加一个裂隙伤害事件，帧末结算
 	/// @param source [IN] 伤害源实体
 	/// @param radius [IN] 伤害半径
 	/// @param damage [IN] 伤害值
     void applyAreaDamage(Entity* source, float radius, float damage);
+
+private:
+	const SpatialIndex* m_pSpatialIndex;	// 空间索引
+	DamageQueue* m_pDamageQueue;	// 伤害队列
 };
\ No newline at end of file
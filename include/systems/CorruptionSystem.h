@@ -2,8 +2,13 @@
 #include "ecs/System.h"
 #include "components/Corruption.h"
 
+#include <vector>
+#include <cstdint>
+
 // 前向声明
 class Entity;
+struct Health;
+struct StatModifiers;
 
 /// @brief 腐蚀系统 - 管理腐蚀度的影响和效果
 /// @details 该系统处理实体的腐蚀度变化，应用相应的效果，并可能触发其他事件或状态变化。
@@ -11,12 +16,16 @@ class Entity;
 /// 设计思路：
 /// 1. 更新腐蚀效果
 /// 2. 应用腐蚀阶段变化
-/// 3. 处理腐蚀相关事件
+/// 3. 处理腐蚀相关事件：阶段变化由腐蚀组件在写入腐蚀度时追加到系统持有的事件队列，系统每帧只处理队列
+/// 4. 腐蚀效果按固定间隔结算：先把腐蚀度、阈值和生命值收集到连续数组，
+///    再用SIMD内核一次算出所有实体的阶段、生命流失和属性修正系数，只把有变化的实体写回
+/// 5. 带腐蚀组件的实体及其组件指针缓存在成员表中，只在实体数量或最新实体ID变化时重建
 /// 
 /// 为何这样做：
 /// - 实现游戏核心风险机制
 /// - 统一管理腐蚀效果逻辑
 /// - 为视觉效果提供依据
+/// - 各阶段效果改为无分支的选择，内核不再按阶段跳转，也不再反复查询组件
 class CorruptionSystem : public System
 {
 public:
@@ -29,30 +38,62 @@ public:
 private:
 	/// @brief 处理实体的腐蚀阶段变化
 	/// @details 根据实体的腐蚀度变化，打印日志
-	/// @param entity [IN] 系统中的实体
-	/// @param newStage [IN] 新的腐蚀阶段
-	void onStageChanged(Entity* entity, Corruption::Stage newStage);
+	/// @param event [IN] 阶段变化事件
+	void onStageChanged(const Corruption::StageChanged& event);
 
-	/// @brief 更新腐蚀效果
-	/// @details 处理实体的腐蚀度变化和效果应用
-	/// @param entity [IN] 系统中的实体
-	/// @param deltaTime [IN] 时间增量
-	void updateCorruptionEffects(Entity* entity, float deltaTime);
-	/// @brief 应用低腐蚀阶段变化
-	/// @details 处理低腐蚀阶段的效果应用
-	/// @param entity [IN] 系统中的实体
-	void applyLowCorruptionEffects(Entity* entity);
-	/// @brief 应用中腐蚀阶段变化
-	/// @details 处理中腐蚀阶段的效果应用
-	/// @param entity [IN] 系统中的实体
-	void applyMediumCorruptionEffects(Entity* entity);
-	/// @brief 应用高腐蚀阶段变化
-	/// @details 处理高腐蚀阶段的效果应用
-	/// @param entity [IN] 系统中的实体
-	void applyHighCorruptionEffects(Entity* entity);
-	/// @brief 处理危险腐蚀阶段变化
-	/// @details 处理危险腐蚀阶段的效果应用
-	/// @param entity [IN] 系统中的实体
-	void applyCriticalCorruptionEffects(Entity* entity);
+	/// @brief 实体集合变化时重建成员表，并把新成员的腐蚀组件绑定到阶段事件队列
+	/// @details 组件只在创建实体时添加，实体只追加到末尾且ID递增，
+	/// 因此实体数量和最后一个实体的ID不变时成员表仍然有效
+	/// @param world [IN] 当前游戏世界
+	void refreshMembers(World& world);
+
+	/// @brief 把所有成员的腐蚀数据收集到结算数组
+	void gather();
+
+	/// @brief 结算内核
+	/// @details 对已收集的所有实体计算阶段、扣除高腐蚀阶段的生命值，并算出属性修正系数
+	void runKernel();
+
+	/// @brief 把内核结果写回组件
+	/// @details 只访问内核标记为生命值或修正系数有变化的实体
+	void scatter();
+
+	/// @brief 设置腐蚀对属性的修正
+	/// @details 通过属性修正施加，由属性系统在数值变化时写回，不再每次从头重算
+	/// @param member [IN] 成员下标
+	/// @param maxHealthScale [IN] 最大生命值系数
+	/// @param recoveryScale [IN] 能量恢复速率系数
+	void setCorruptionModifiers(size_t member, float maxHealthScale, float recoveryScale);
+	/// @brief 撤销腐蚀对属性的修正
+	/// @param member [IN] 成员下标
+	void clearCorruptionModifiers(size_t member);
+
+private:
+	EventQueue<Corruption::StageChanged> m_stageEvents;	// 阶段变化事件，成员的腐蚀组件绑定到这里
+	float m_effectTimer = 0.0f;	// 距上次结算的时间
+	float m_lossOfControlTimer = 0.0f;	// 能力失控效果的计时
+
+	// 成员表，按实体顺序排列
+	size_t m_worldEntityCount = 0;	// 重建时世界中的实体数
+	int m_lastEntityId = -1;	// 重建时最后一个实体的ID
+	std::vector<Entity*> m_entities;	// 实体
+	std::vector<Corruption*> m_corruptions;	// 腐蚀组件
+	std::vector<Health*> m_healths;	// 生命值组件，缺少生命值或暗能量时为空
+	std::vector<StatModifiers*> m_modifiers;	// 属性修正组件，第一次施加修正时添加
 
+	// 结算数组，与成员表一一对应，长度补齐到4的倍数
+	std::vector<float> m_corruption;	// 腐蚀度
+	std::vector<float> m_lowThreshold;	// 低腐蚀阈值
+	std::vector<float> m_mediumThreshold;	// 中腐蚀阈值
+	std::vector<float> m_highThreshold;	// 高腐蚀阈值
+	std::vector<float> m_health;	// 当前生命值
+	std::vector<float> m_baseMaxHealth;	// 基础最大生命值
+	std::vector<float> m_hasVitals;	// 同时拥有生命值和暗能量时为1
+	std::vector<float> m_stage;	// 结算出的阶段
+	std::vector<float> m_maxHealthScale;	// 最大生命值修正系数
+	std::vector<float> m_recoveryScale;	// 能量恢复速率修正系数
+	std::vector<float> m_appliedHealthScale;	// 上次施加的最大生命值修正系数，-1 表示尚未施加
+	std::vector<float> m_appliedRecoveryScale;	// 上次施加的能量恢复速率修正系数
+	std::vector<uint8_t> m_changed;	// 每组4个实体中需要写回的位掩码
+	int m_mediumCount = 0;	// 本次结算处于中腐蚀阶段的实体数
 };
\ No newline at end of file
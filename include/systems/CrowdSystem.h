@@ -0,0 +1,84 @@
+#pragma once
+#include "ecs/System.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// 前向声明
+class SpatialIndex;
+class JobSystem;
+class Entity;
+struct Velocity;
+
+/// @brief 群体转向系统 - 在AI期望速度的基础上加入分离、对齐和避让
+/// @details 在AI系统之后运行，读取 AI::desiredVelocity，把修正后的速度写入 Velocity::linear。
+/// 
+/// 设计思路：
+/// 1. 同一网格内的敌人共用一次空间索引查询得到的候选列表，用SIMD计算到全部候选的距离，
+///    取最近的K个存入定长的SoA槽位，不足K个的槽位用掩码屏蔽
+/// 2. 分离：距离越近推力越大；对齐：趋向邻居的平均速度；避让：按相对速度预测最近接近点，提前错开
+/// 3. 邻居查询和转向计算按块分给任务系统并行执行，核心计算一次处理4个邻居
+/// 4. 修正后的速度不超过期望速度的大小
+/// 
+/// 为何这样做：
+/// - 追逐同一目标的敌人不再挤成一个点，形成自然的包围
+/// - 邻居数量有上限，单个实体的开销固定，大规模群体的帧开销可控
+/// - 以期望速度为输入，跳帧更新的AI不会把上一帧的修正量越积越大
+class CrowdSystem : public System
+{
+public:
+	/// @brief 构造函数
+	/// @param spatialIndex [IN] 空间索引
+	/// @param jobSystem [IN] 任务系统，可为空
+	CrowdSystem(const SpatialIndex* spatialIndex, JobSystem* jobSystem);
+
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，修正所有移动中敌人的速度
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	/// @brief 邻居查询的临时数据（每个并行块一份）
+	struct NeighborScratch
+	{
+		std::vector<float> x, z;	// 候选位置
+		std::vector<int> entries;	// 候选的空间索引条目下标
+		std::vector<float> distSq;	// 到候选的距离平方
+		std::vector<std::pair<float, int>> hits;	// 半径内最近的候选，按距离升序
+	};
+
+	/// @brief 收集同一网格内一段实体的邻居到SoA槽位
+	/// @param begin [IN] 起始下标
+	/// @param end [IN] 结束下标（不含）
+	/// @param scratch [IN/OUT] 临时数据
+	void gatherNeighbors(int begin, int end, NeighborScratch& scratch);
+
+	/// @brief 计算一段实体的转向速度
+	/// @param begin [IN] 起始下标
+	/// @param end [IN] 结束下标（不含）
+	void steer(int begin, int end);
+
+private:
+	const SpatialIndex* m_pSpatialIndex;	// 空间索引
+	JobSystem* m_pJobSystem;	// 任务系统
+
+	// 空间索引条目对应的数据（按条目下标）
+	std::vector<float> m_entryVelX, m_entryVelZ;	// 期望速度
+	std::vector<Velocity*> m_entryVelocities;	// 速度组件
+	std::vector<std::pair<uint64_t, int>> m_order;	// 移动中敌人的（网格键, 条目下标），按网格排序
+
+	// 移动中的敌人（SoA）
+	std::vector<Entity*> m_agents;	// 实体
+	std::vector<int> m_agentEntries;	// 空间索引条目下标
+	std::vector<Velocity*> m_velocities;	// 速度组件
+	std::vector<float> m_posX, m_posZ;	// 位置
+	std::vector<float> m_desiredX, m_desiredZ;	// 期望速度
+	std::vector<int> m_cellStarts;	// 同一网格内连续实体段的起始下标（末尾为实体总数）
+
+	// 邻居槽位（每个敌人K个，SoA）
+	std::vector<float> m_nbrX, m_nbrZ;	// 邻居相对位置
+	std::vector<float> m_nbrVelX, m_nbrVelZ;	// 邻居速度
+	std::vector<float> m_nbrMask;	// 槽位有效为1，否则为0
+};
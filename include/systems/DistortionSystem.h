@@ -0,0 +1,36 @@
+#pragma once
+#include "ecs/System.h"
+
+// 前向声明
+class SpatialIndex;
+class DistortionEffects;
+
+/// @brief 扭曲系统 - 每帧解析空间扭曲区域对实体的影响
+/// @details 该系统在空间索引重建之后、移动系统之前运行，把重力偏移和时间膨胀解析为逐实体数据。
+/// 
+/// 设计思路：
+/// 1. 扭曲效果数据由应用程序持有，移动系统只读
+/// 2. 本系统只负责每帧调用一次解析
+/// 
+/// 为何这样做：
+/// - 区域重叠判定集中在一处完成
+/// - 移动系统保持简单的线性遍历
+class DistortionSystem : public System
+{
+public:
+	/// @brief 构造函数
+	/// @details 保存解析所需的空间索引和输出的扭曲效果
+	/// @param spatialIndex [IN] 空间索引
+	/// @param distortionEffects [IN] 扭曲效果
+	DistortionSystem(const SpatialIndex* spatialIndex, DistortionEffects* distortionEffects);
+
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，解析扭曲效果
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	const SpatialIndex* m_pSpatialIndex;	// 空间索引
+	DistortionEffects* m_pDistortionEffects;	// 扭曲效果
+};
@@ -4,6 +4,14 @@
 
 #include <glm/glm.hpp>
 
+// 前向声明
+class CorruptionField;
+class CorruptionDiffusion;
+class JobSystem;
+class InfluenceMap;
+class EnemyPool;
+class Random;
+
 /// @brief 环境系统 - 管理游戏世界的环境事件和效果
 /// @details 该系统负责处理腐蚀源和暗蚀潮汐等环境机制
 /// 
@@ -11,15 +19,23 @@
 /// 1. 通过定时器触发暗蚀潮汐事件，增加游戏的挑战性和紧迫感。
 /// 2. 允许玩家在特定位置生成腐蚀源，影响周围环境和生物。
 /// 3. 使用实体组件系统（ECS）架构，便于扩展和维护。
+/// 4. 潮汐生成的敌人先排队，每帧最多从敌人池启用固定数量，大规模潮汐分摊到多帧。
 /// 
 /// 为何这样做：
 /// - 环境事件可以增加游戏的动态性和不可预测性，提升玩家体验。
 /// - 通过ECS架构，可以轻松添加新环境效果或修改现有逻辑，而无需重构整个系统。
+/// - 数百个敌人同时涌入时单帧开销有上限，不会出现卡顿。
 class EnvironmentSystem : public System {
 public:
 	/// @brief 构造函数
 	/// @details 初始化环境系统，设置必要的参数和状态
-    EnvironmentSystem();
+	/// @param corruptionField [IN] 腐蚀场，腐蚀源写入、实体从中采样
+	/// @param corruptionDiffusion [IN] 腐蚀扩散场，腐蚀源注入、实体从中采样
+	/// @param jobSystem [IN] 任务系统，用于并行推进扩散模拟
+	/// @param influenceMap [IN] 影响力图，用于挑选刷怪位置，可为空
+	/// @param enemyPool [IN] 敌人池，为空时直接创建敌人
+    EnvironmentSystem(CorruptionField* corruptionField, CorruptionDiffusion* corruptionDiffusion, JobSystem* jobSystem,
+        const InfluenceMap* influenceMap = nullptr, EnemyPool* enemyPool = nullptr);
 
     /// @brief 更新系统状态
     /// @details 每帧调用一次，处理符合条件的实体和组件
@@ -41,7 +57,9 @@ public:
 	/// @param duration [IN] 暗蚀潮汐持续时间（秒）
 	/// @param powerMultiplier [IN] 暗蚀潮汐的强度倍率
 	/// @param spawnRate [IN] 生物生成速率（每秒生成多少生物）
-    void spawnDarkTide(World& world, float duration = 30.0f, float powerMultiplier = 1.5f, float spawnRate = 2.0f);
+	/// @param waveSize [IN] 本次潮汐生成的暗蚀生物数，按每帧预算分批加入世界
+    void spawnDarkTide(World& world, float duration = 30.0f, float powerMultiplier = 1.5f, float spawnRate = 2.0f,
+        int waveSize = 5);
 
 	/// @brief 生成空间扭曲效果
 	/// @details 该方法在指定位置生成空间扭曲效果，影响周围实体的运动和行为。
@@ -55,6 +73,23 @@ public:
         float radius, float strength, float duration);
 
 private:
+	/// @brief 挑选刷怪位置
+	/// @details 随机取若干候选点，选腐蚀浓、远离玩家威胁、敌人稀少的一个；没有影响力图时直接随机
+	/// @param random [IN/OUT] 本帧环境系统的随机数流
+	/// @return 刷怪位置
+    glm::vec3 pickSpawnPosition(Random& random) const;
+
+	/// @brief 按每帧预算生成排队的暗蚀生物
+	/// @param world [IN] 游戏世界
+    void spawnPendingEnemies(World& world);
+
+private:
+    CorruptionField* m_pCorruptionField;    // 腐蚀场
+    CorruptionDiffusion* m_pCorruptionDiffusion;    // 腐蚀扩散场
+    JobSystem* m_pJobSystem;    // 任务系统
+    const InfluenceMap* m_pInfluenceMap;    // 影响力图
+    EnemyPool* m_pEnemyPool;    // 敌人池
+    int m_pendingSpawns;    // 等待生成的暗蚀生物数
     float m_darkTideTimer;               // 暗蚀潮汐计时器
     const float m_darkTideInterval;     // 暗蚀潮汐间隔时间（秒）
 };
\ No newline at end of file
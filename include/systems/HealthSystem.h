@@ -0,0 +1,44 @@
+#pragma once
+#include "ecs/System.h"
+#include "components/HealthStore.h"
+
+#include <vector>
+
+// 前向声明
+class Entity;
+
+/// @brief 生命值系统 - 帧末统一夹紧生命值并处理死亡
+/// @details 在其他系统都更新之后，对世界的生命值存储做一次SIMD扫描：
+/// 把生命值夹紧到 [0, 最大值]，找出本帧新死亡的实体，记录死亡事件并标记销毁。
+///
+/// 设计思路：
+/// 1. 伤害结算、腐蚀流失等所有路径只写生命值，死亡判断只在这里进行
+/// 2. 扫描按4个槽位一组，夹紧和“已死且未上报”的判断都是无分支的向量运算，
+///    只有掩码非零的组才逐个取出实体
+/// 3. 上报后槽位标记为已上报，实体在帧末销毁前不会被再次上报；生命值恢复为正数时清除标记
+///
+/// 为何这样做：
+/// - 死亡处理只有一处，新增的伤害来源不可能漏掉死亡判断
+/// - 存活实体的开销只是连续数组上的几条向量指令
+class HealthSystem : public System
+{
+public:
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，需在所有修改生命值的系统之后
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+	/// @brief 获取本帧的死亡事件
+	const std::vector<DeathEvent>& getDeaths() const { return m_deaths; }
+
+private:
+	/// @brief 死亡扫描内核
+	/// @details 夹紧所有槽位的生命值，把新死亡的槽位所属实体压入死亡列表
+	/// @param store [IN/OUT] 生命值存储
+	void sweep(HealthStore& store);
+
+private:
+	std::vector<DeathEvent> m_deaths;	// 本帧的死亡事件
+	std::vector<Entity*> m_dead;	// 本帧新死亡的实体
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include "ecs/System.h"
+
+// 前向声明
+class SpatialIndex;
+class CorruptionField;
+class InfluenceMap;
+
+/// @brief 影响力系统 - 每帧增量更新影响力图
+/// @details 该系统在空间索引重建之后运行，把敌人、玩家和腐蚀场的变化写入影响力图。
+/// 
+/// 设计思路：
+/// 1. 影响力图由应用程序持有，AI系统和环境系统只读采样
+/// 2. 本系统只负责驱动更新，具体的增量和衰减逻辑在影响力图内部
+/// 
+/// 为何这样做：
+/// - 保证同一帧内所有读取方看到一致的战术信息
+/// - 复用空间索引已经整理好的位置和标签，不再遍历组件
+class InfluenceSystem : public System
+{
+public:
+	/// @brief 构造函数
+	/// @param spatialIndex [IN] 空间索引
+	/// @param corruptionField [IN] 腐蚀场，可为空
+	/// @param influenceMap [IN] 影响力图
+	InfluenceSystem(const SpatialIndex* spatialIndex, const CorruptionField* corruptionField, InfluenceMap* influenceMap);
+
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，增量更新影响力图
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	const SpatialIndex* m_pSpatialIndex;	// 空间索引
+	const CorruptionField* m_pCorruptionField;	// 腐蚀场
+	InfluenceMap* m_pInfluenceMap;	// 影响力图
+};
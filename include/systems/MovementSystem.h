@@ -1,12 +1,16 @@
 #pragma once
 #include "ecs/System.h"
 
+// 前向声明
+class DistortionEffects;
+
 /// @brief 移动系统 - 根据速度更新位置
 /// @details 该系统处理所有具有位置和速度组件的实体，更新它们的位置
 /// 
 /// 设计思路：
 /// 1. 遍历所有拥有Transform和Velocity组件的实体
 /// 2. 根据速度和时间更新位置
+/// 3. 按实体下标读取扭曲系统解析出的时间缩放和重力牵引
 /// 
 /// 为何这样做：
 /// - 分离运动计算逻辑
@@ -14,9 +18,17 @@
 class MovementSystem : public System
 {
 public:
+	/// @brief 构造函数
+	/// @details 保存空间扭曲效果，为空时不受扭曲影响
+	/// @param distortionEffects [IN] 空间扭曲效果
+	MovementSystem(const DistortionEffects* distortionEffects);
+
 	/// @brief 更新系统状态
 	/// @details 每帧调用一次，处理符合条件的实体和组件
 	/// @param world [IN] 当前游戏世界
 	/// @param deltaTime [IN] 时间增量
 	virtual void update(World& world, float deltaTime) override;
-};
\ No newline at end of file
+
+private:
+	const DistortionEffects* m_pDistortionEffects;	// 空间扭曲效果
+};
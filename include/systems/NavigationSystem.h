@@ -0,0 +1,39 @@
+#pragma once
+#include "ecs/System.h"
+
+// 前向声明
+class FlowField;
+class Pathfinder;
+class JobSystem;
+
+/// @brief 导航系统 - 维护指向玩家的共享流场并推进寻路请求
+/// @details 该系统每帧把玩家位置交给流场，由流场决定是否需要重新积分；再推进寻路服务的下一批搜索。
+/// 
+/// 设计思路：
+/// 1. 流场和寻路服务由应用程序持有，AI系统查询
+/// 2. 积分和搜索提交到任务系统，不阻塞主线程
+/// 
+/// 为何这样做：
+/// - 所有追逐者共享一次积分结果
+/// - 玩家停留在同一格子时没有额外开销
+/// - 寻路请求分批跨帧完成，每帧开销有上限
+class NavigationSystem : public System
+{
+public:
+	/// @brief 构造函数
+	/// @param flowField [IN] 流场
+	/// @param pathfinder [IN] 寻路服务
+	/// @param jobSystem [IN] 任务系统，可为空
+	NavigationSystem(FlowField* flowField, Pathfinder* pathfinder, JobSystem* jobSystem);
+
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，用玩家位置更新流场
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	FlowField* m_pFlowField;	// 流场
+	Pathfinder* m_pPathfinder;	// 寻路服务
+	JobSystem* m_pJobSystem;	// 任务系统
+};
@@ -10,6 +10,7 @@
 
 // 前向声明
 class Entity;
+class ProjectilePool;
 
 /// @brief 玩家控制系统 - 处理玩家输入并控制角色
 /// @details 该系统监听玩家输入并更新玩家实体的位置和状态。
@@ -28,7 +29,8 @@ public:
 	/// @brief 构造函数
 	/// @details 初始化移动状态和速度
 	/// @param inputMap [IN] 输入映射，用于处理键盘输入
-	PlayerControlSystem(InputMap* inputMap);
+	/// @param projectiles [IN] 投射物池，远程攻击的投射物发射到这里，可为空
+	PlayerControlSystem(InputMap* inputMap, ProjectilePool* projectiles);
 
 	/// @brief 更新系统状态
 	/// @details 每帧调用一次，处理符合条件的实体和组件
@@ -47,6 +49,13 @@ private:
 	/// @param player [IN] 玩家实体
 	/// @param deltaTime [IN] 时间增量
 	void handleMovement(Entity* player, float deltaTime);
+	/// @brief 处理远程攻击
+	/// @details 按住远程攻击键时按固定间隔沿玩家朝向发射投射物
+	/// @param player [IN] 玩家实体
+	/// @param deltaTime [IN] 时间增量
+	void handleRangedAttack(Entity* player, float deltaTime);
 private:
 	InputMap* m_pInputMap;	// 输入映射，用于处理玩家输入
+	ProjectilePool* m_pProjectiles;	// 投射物池
+	float m_rangedTimer;	// 距离上次发射的时间
 };
\ No newline at end of file
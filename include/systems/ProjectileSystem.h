@@ -0,0 +1,55 @@
+#pragma once
+#include "ecs/System.h"
+
+#include <vector>
+
+// 前向声明
+class SpatialIndex;
+class DamageQueue;
+class ProjectilePool;
+class JobSystem;
+
+/// @brief 投射物系统 - 检测投射物命中、推进投射物并把命中转成伤害事件
+/// @details 该系统在战斗系统之前运行，命中产生的伤害与近战伤害一起在帧末结算。
+/// 
+/// 设计思路：
+/// 1. 每个投射物把本帧的移动看作一条线段，用空间索引找出线段附近的目标
+/// 2. 对每个候选做扫掠球与目标竖直圆柱的相交测试，取最早的命中，快速的投射物也不会穿过目标
+/// 3. 检测阶段只读空间索引和组件，结果写入按投射物下标预分配的数组，数量较多时分块并行
+/// 4. 积分之后倒序遍历一次，命中的追加伤害事件，命中或到期的从池中移除
+/// 
+/// 为何这样做：
+/// - 连续碰撞检测与帧率和速度无关，弹幕再快也能命中
+/// - 检测阶段不修改共享状态，可以安全并行；伤害队列只在单线程中追加
+/// - 所有缓冲在构造时按池容量分配，运行中不分配内存
+class ProjectileSystem : public System
+{
+public:
+	/// @brief 构造函数
+	/// @param spatialIndex [IN] 空间索引
+	/// @param damageQueue [IN] 伤害队列
+	/// @param projectiles [IN] 投射物池
+	/// @param jobSystem [IN] 任务系统，可为空
+	ProjectileSystem(const SpatialIndex* spatialIndex, DamageQueue* damageQueue, ProjectilePool* projectiles, JobSystem* jobSystem);
+
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，检测命中、积分并移除命中或到期的投射物
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	/// @brief 检测 [begin, end) 区间内投射物本帧的命中
+	/// @param begin [IN] 起始下标
+	/// @param end [IN] 结束下标
+	/// @param deltaTime [IN] 时间增量
+	void sweep(size_t begin, size_t end, float deltaTime);
+
+private:
+	const SpatialIndex* m_pSpatialIndex;	// 空间索引
+	DamageQueue* m_pDamageQueue;	// 伤害队列
+	ProjectilePool* m_pProjectiles;	// 投射物池
+	JobSystem* m_pJobSystem;	// 任务系统
+
+	std::vector<int> m_hitTargets;	// 每个投射物本帧命中的实体ID，-1为未命中
+};
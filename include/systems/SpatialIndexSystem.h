@@ -0,0 +1,33 @@
+#pragma once
+#include "ecs/System.h"
+
+// 前向声明
+class SpatialIndex;
+
+/// @brief 空间索引系统 - 每帧重建空间索引
+/// @details 该系统在每帧开始时根据实体位置重建空间索引，供后续系统查询。
+/// 
+/// 设计思路：
+/// 1. 空间索引由应用程序持有，多个系统共享
+/// 2. 本系统只负责在每帧开始时重建一次
+/// 
+/// 为何这样做：
+/// - 保证同一帧内所有系统看到一致的空间数据
+/// - 避免各系统各自遍历全部实体
+class SpatialIndexSystem : public System
+{
+public:
+	/// @brief 构造函数
+	/// @details 保存需要维护的空间索引
+	/// @param spatialIndex [IN] 空间索引
+	SpatialIndexSystem(SpatialIndex* spatialIndex);
+
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，重建空间索引
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	SpatialIndex* m_pSpatialIndex;	// 空间索引
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include "ecs/System.h"
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <glm/glm.hpp>
+
+// 前向声明
+class Entity;
+class Pathfinder;
+class EnemyPool;
+class Mesh;
+struct Squad;
+struct Transform;
+struct Velocity;
+
+/// @brief 小队系统 - 把远处的敌人聚合成小队，玩家接近时再拆回个体
+/// @details 暗蚀潮汐不断生成敌人，远处的敌人按区域合并成一个小队实体整体移动，
+/// 玩家进入拆分距离后按记录的偏移和生命值重建每个成员。
+/// 
+/// 设计思路：
+/// 1. 合并和拆分每隔一段时间检查一次，小队的移动每帧更新
+/// 2. 合并候选按所在的粗网格格子排序，同一格子里的敌人并入已有小队或组成新小队
+/// 3. 只合并空闲或巡逻中、未被同化、不由行为树控制的普通敌人，交战中的敌人保持个体
+/// 4. 合并距离等于拆分距离加上成员的最大偏移，拆分后重建的成员不会被立即重新合并
+/// 5. 拆分时收回小队的网格，之后组建小队时复用，不在运行中重复创建网格
+/// 
+/// 为何这样做：
+/// - 远处敌人的个体行为玩家看不到，聚合后AI、群体转向和碰撞的开销随小队数量增长
+/// - 成员的偏移和生命值被完整保留，拆分后玩家看到的仍是原来那群敌人
+class SquadSystem : public System
+{
+public:
+	/// @brief 构造函数
+	/// @param pathfinder [IN] 寻路服务，合并时取消成员进行中的请求，可为空
+	/// @param enemyPool [IN] 敌人池，拆分时从中启用成员，为空时直接创建
+	explicit SquadSystem(Pathfinder* pathfinder = nullptr, EnemyPool* enemyPool = nullptr);
+
+	/// @brief 析构函数
+	/// @details 释放收回的网格
+	~SquadSystem();
+
+	/// @brief 更新系统状态
+	/// @details 每帧移动小队，定期检查合并和拆分
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	/// @brief 沿巡逻路点移动小队
+	/// @details 到达当前路点后在组建位置附近随机取下一个路点
+	/// @param world [IN] 当前游戏世界
+	/// @param entity [IN] 小队实体
+	/// @param squad [IN/OUT] 小队组件
+	/// @param transform [IN] 小队变换
+	/// @param velocity [OUT] 小队速度
+	void moveSquad(World& world, Entity& entity, Squad& squad, const Transform& transform, Velocity& velocity);
+
+	/// @brief 拆分小队，按偏移和生命值重建成员
+	/// @param world [IN] 当前游戏世界
+	/// @param squad [IN] 小队实体
+	void split(World& world, Entity* squad);
+
+	/// @brief 合并同一格子里的候选敌人
+	/// @param world [IN] 当前游戏世界
+	/// @return 被合并的敌人数量
+	size_t mergeCandidates(World& world);
+
+	/// @brief 把敌人并入小队并销毁该敌人
+	/// @param squad [IN] 小队实体
+	/// @param enemy [IN] 被合并的敌人
+	void absorb(Entity* squad, Entity* enemy);
+
+	/// @brief 计算位置所在的粗网格格子键
+	/// @param position [IN] 世界坐标
+	/// @return 格子键
+	static uint64_t cellKey(const glm::vec3& position);
+
+private:
+	Pathfinder* m_pPathfinder;	// 寻路服务
+	EnemyPool* m_pEnemyPool;	// 敌人池
+	float m_timer;	// 距离上次检查的时间
+
+	std::vector<Entity*> m_toSplit;	// 本次需要拆分的小队
+	std::vector<std::pair<uint64_t, Entity*>> m_candidates;	// 合并候选（格子键，敌人）
+	std::vector<std::pair<uint64_t, Entity*>> m_squads;	// 现有小队（格子键，小队）
+	std::vector<std::unique_ptr<Mesh>> m_meshes;	// 已拆分小队收回的网格
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include "ecs/System.h"
+
+// 前向声明
+class Entity;
+struct StatModifiers;
+
+/// @brief 属性系统 - 让限时修正自行到期，并在修正集合变化时写回派生属性
+/// @details 其他系统只负责设置或移除 StatModifiers 中的修正，本系统把变化的属性重新作用到对应组件上。
+/// 
+/// 设计思路：
+/// 1. 只有存在限时修正的实体才推进时钟、检查到期
+/// 2. 只有修正集合变化过的属性才重新计算并写回 Health::max、DarkEnergy::recoveryRate
+/// 3. 腐蚀强度的基础值每帧都在增长，由环境系统每帧直接读取折叠结果，本系统不写回
+/// 
+/// 为何这样做：
+/// - 派生值不再每帧从头重算，修正不变时每个实体只剩一次位掩码判断
+/// - 效果的施加方不需要关心修正何时结束、如何恢复原值
+class StatSystem : public System
+{
+public:
+	/// @brief 更新系统状态
+	/// @details 每帧调用一次，处理修正到期并写回变化的派生属性
+	/// @param world [IN] 当前游戏世界
+	/// @param deltaTime [IN] 时间增量
+	virtual void update(World& world, float deltaTime) override;
+
+private:
+	/// @brief 把变化的派生属性写回组件
+	/// @param entity [IN] 实体
+	/// @param modifiers [IN] 实体的属性修正
+	void writeBack(Entity* entity, StatModifiers* modifiers);
+};
@@ -0,0 +1,4 @@
+# 同化：控制附近最近的3个敌人6秒
+targets = nearest enemy 10 3    # 半径 数量
+require targets
+assimilate targets 6
@@ -0,0 +1,4 @@
+# 扭曲：反转自身重力，额外承受腐蚀，并向四周释放裂隙碎片
+flipGravity
+corrupt 5
+projectiles 16 20 6 360     # 数量 速度 伤害 扇形角度
@@ -0,0 +1,5 @@
+# 操控：把近处的敌人推开并造成少量伤害
+targets = radius enemy 8
+require targets
+push targets 4
+damage targets 5 physical
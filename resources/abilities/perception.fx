@@ -0,0 +1,4 @@
+# 感知：标记周围的敌人，8秒内最大生命值降低10%
+targets = radius enemy 25
+require targets             # 范围内没有敌人时施放失败
+modify targets maxHealth mul 0.9 8
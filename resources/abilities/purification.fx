@@ -0,0 +1,3 @@
+# 净化：降低自身腐蚀度，并清除周围已蔓延的腐蚀
+corrupt -15
+cleanse 6 5                 # 半径 每格移除量
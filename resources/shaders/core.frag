@@ -7,6 +7,7 @@ in vec2 TexCoords;
 in vec3 Color;
 
 uniform float time;
+uniform float corruption;   // 所处位置的腐蚀强度（0~1）
 
 void main() {
     // 基础颜色
@@ -23,6 +24,9 @@ void main() {
     // 最终颜色
     vec3 result = (ambient + diffuse) * baseColor;
     
+    // 腐蚀区域内偏向暗紫色
+    result = mix(result, vec3(0.35, 0.05, 0.45), clamp(corruption, 0.0, 1.0) * 0.6);
+    
     // 添加脉动效果（用于测试）
     float pulse = (sin(time * 2.0) + 1.0) * 0.1 + 0.8;
     result *= pulse;
@@ -0,0 +1,308 @@
+#include "ability/EffectProgram.h"
+#include "combat/DamageQueue.h"
+#include "components/StatModifiers.h"
+#include "core/Logger.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+	/// @brief 语句描述
+	/// @details 操作数类型依次填入指令的 a..e 字段（赋值语句的目标寄存器占用 a）：
+	/// S 集合寄存器，N 数值寄存器或字面量，g 目标标签，t 伤害类型，s 属性，o 修正运算
+	struct StatementInfo
+	{
+		const char* name;	// 文本中的名称
+		EffectOp op;	// 操作码
+		char result;	// 赋值结果类型：S 集合，N 数值，0 不是赋值表达式
+		const char* operands;	// 操作数类型
+	};
+
+	const StatementInfo STATEMENT_INFOS[] = {
+		{ "add",			EffectOp::Add,			'N', "NN" },
+		{ "mul",			EffectOp::Mul,			'N', "NN" },
+		{ "count",			EffectOp::SetSize,		'N', "S" },
+		{ "radius",			EffectOp::QueryRadius,	'S', "gN" },
+		{ "nearest",		EffectOp::QueryNearest,	'S', "gNN" },
+		{ "require",		EffectOp::Require,		0, "S" },
+		{ "damage",			EffectOp::Damage,		0, "SNt" },
+		{ "modify",			EffectOp::Modify,		0, "SsoNN" },
+		{ "assimilate",		EffectOp::Assimilate,	0, "SN" },
+		{ "push",			EffectOp::Push,			0, "SN" },
+		{ "projectiles",	EffectOp::Projectiles,	0, "NNNN" },
+		{ "corrupt",		EffectOp::Corrupt,		0, "N" },
+		{ "cleanse",		EffectOp::Cleanse,		0, "NN" },
+		{ "flipGravity",	EffectOp::FlipGravity,	0, "" },
+	};
+
+	/// @brief 关键字及其取值
+	struct Keyword
+	{
+		char kind;	// 操作数类型
+		const char* name;	// 文本中的名称
+		uint8_t value;	// 写入指令的值
+	};
+
+	const Keyword KEYWORDS[] = {
+		{ 'g', "any",				EffectProgram::TargetAny },
+		{ 'g', "enemy",				EffectProgram::TargetEnemy },
+		{ 'g', "player",			EffectProgram::TargetPlayer },
+		{ 't', "physical",			static_cast<uint8_t>(DamageType::Physical) },
+		{ 't', "rift",				static_cast<uint8_t>(DamageType::Rift) },
+		{ 't', "corruption",		static_cast<uint8_t>(DamageType::Corruption) },
+		{ 's', "maxHealth",			StatModifiers::MaxHealth },
+		{ 's', "energyRecovery",	StatModifiers::EnergyRecovery },
+		{ 's', "corruptionPower",	StatModifiers::CorruptionPower },
+		{ 'o', "add",				StatModifiers::Add },
+		{ 'o', "mul",				StatModifiers::Multiply },
+		{ 'o', "override",			StatModifiers::Override },
+	};
+
+	const StatementInfo* findStatement(const std::string& name)
+	{
+		for (const StatementInfo& info : STATEMENT_INFOS) {
+			if (name == info.name) return &info;
+		}
+		return nullptr;
+	}
+
+	const Keyword* findKeyword(char kind, const std::string& name)
+	{
+		for (const Keyword& keyword : KEYWORDS) {
+			if (keyword.kind == kind && name == keyword.name) return &keyword;
+		}
+		return nullptr;
+	}
+
+	bool parseNumber(const std::string& token, float& value)
+	{
+		char* endPtr = nullptr;
+		value = std::strtof(token.c_str(), &endPtr);
+		return endPtr != token.c_str() && *endPtr == '\0';
+	}
+
+	/// @brief 编译时的寄存器分配
+	struct Registers
+	{
+		std::unordered_map<std::string, uint8_t> sets;	// 集合寄存器名称 -> 编号
+		std::unordered_map<std::string, uint8_t> numbers;	// 数值寄存器名称 -> 编号
+		int setCount = 1;	// 已分配的集合寄存器数（0号为 self）
+		int numberCount = 0;	// 已分配的数值寄存器数
+	};
+}
+
+bool EffectProgram::compile(const std::string& name, const std::string& source, std::string& error)
+{
+	m_name = name;
+	m_code.clear();
+	m_constants.clear();
+
+	Registers registers;
+	registers.sets["self"] = SelfSet;
+	std::vector<Instruction> prologue;	// 装入常量的指令
+	std::vector<Instruction> body;	// 语句对应的指令
+
+	// 操作数中的字面量分配一个只读的数值寄存器并在开头装入，相同的值共用
+	auto constantRegister = [&](float value, uint8_t& reg) {
+		for (const Instruction& load : prologue) {
+			if (m_constants[load.b] == value) {
+				reg = load.a;
+				return true;
+			}
+		}
+		if (registers.numberCount >= NumberRegisters) return false;
+		reg = static_cast<uint8_t>(registers.numberCount++);
+		prologue.push_back(Instruction{ EffectOp::LoadConst, reg, static_cast<uint8_t>(m_constants.size()), 0, 0, 0, 0 });
+		m_constants.push_back(value);
+		return true;
+	};
+
+	std::istringstream lines(source);
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(lines, line)) {
+		++lineNumber;
+		const std::string where = name + ":" + std::to_string(lineNumber) + ": ";
+
+		// 去掉注释并切分单词
+		std::istringstream stream(line.substr(0, line.find('#')));
+		std::vector<std::string> tokens;
+		std::string token;
+		while (stream >> token) tokens.push_back(token);
+		if (tokens.empty()) continue;	// 空行
+
+		// 赋值语句：名称 = 表达式
+		std::string target;
+		size_t first = 0;
+		if (tokens.size() >= 2 && tokens[1] == "=") {
+			target = tokens[0];
+			first = 2;
+			if (tokens.size() < 3) {
+				error = where + "赋值缺少表达式";
+				return false;
+			}
+			if (target == "self") {
+				error = where + "self 不能被赋值";
+				return false;
+			}
+		}
+
+		Instruction instruction{ EffectOp::Count, 0, 0, 0, 0, 0, 0 };
+		uint8_t* fields[5] = { &instruction.a, &instruction.b, &instruction.c, &instruction.d, &instruction.e };
+		int field = 0;
+
+		const StatementInfo* info = findStatement(tokens[first]);
+		float literal = 0.0f;
+		char result = 0;
+		const char* operands = "";
+		size_t operandBegin = first + 1;
+		if (!target.empty() && tokens.size() == 3 && parseNumber(tokens[2], literal)) {
+			// 名称 = 字面量
+			instruction.op = EffectOp::LoadConst;
+			result = 'N';
+			instruction.b = static_cast<uint8_t>(m_constants.size());
+			m_constants.push_back(literal);
+			operandBegin = tokens.size();
+		}
+		else if (!info) {
+			error = where + "未知语句 " + tokens[first];
+			return false;
+		}
+		else {
+			if (target.empty() != (info->result == 0)) {
+				error = where + tokens[first] + (info->result ? " 必须赋值给寄存器" : " 不产生结果，不能赋值");
+				return false;
+			}
+			instruction.op = info->op;
+			result = info->result;
+			operands = info->operands;
+		}
+
+		// 目标寄存器占用 a 字段
+		if (result) {
+			auto& names = result == 'S' ? registers.sets : registers.numbers;
+			auto& other = result == 'S' ? registers.numbers : registers.sets;
+			if (other.count(target)) {
+				error = where + target + " 已被用作另一种寄存器";
+				return false;
+			}
+			auto it = names.find(target);
+			if (it == names.end()) {
+				int& count = result == 'S' ? registers.setCount : registers.numberCount;
+				if (count >= (result == 'S' ? SetRegisters : NumberRegisters)) {
+					error = where + "寄存器不足";
+					return false;
+				}
+				it = names.emplace(target, static_cast<uint8_t>(count++)).first;
+			}
+			*fields[field++] = it->second;
+		}
+
+		// 依次解析操作数
+		const size_t operandCount = std::strlen(operands);
+		if (tokens.size() - operandBegin != operandCount && instruction.op != EffectOp::LoadConst) {
+			error = where + tokens[first] + " 需要 " + std::to_string(operandCount) + " 个参数";
+			return false;
+		}
+		for (size_t k = 0; k < operandCount; ++k) {
+			const std::string& operand = tokens[operandBegin + k];
+			const char kind = operands[k];
+			uint8_t value = 0;
+			if (kind == 'S') {
+				auto it = registers.sets.find(operand);
+				if (it == registers.sets.end()) {
+					error = where + operand + " 不是已定义的目标集合";
+					return false;
+				}
+				value = it->second;
+			}
+			else if (kind == 'N') {
+				float number = 0.0f;
+				if (parseNumber(operand, number)) {
+					if (!constantRegister(number, value)) {
+						error = where + "寄存器不足";
+						return false;
+					}
+				}
+				else {
+					auto it = registers.numbers.find(operand);
+					if (it == registers.numbers.end()) {
+						error = where + operand + " 不是已定义的数值";
+						return false;
+					}
+					value = it->second;
+				}
+			}
+			else {
+				const Keyword* keyword = findKeyword(kind, operand);
+				if (!keyword) {
+					error = where + "无效的参数 " + operand;
+					return false;
+				}
+				value = keyword->value;
+			}
+			*fields[field++] = value;
+		}
+
+		body.push_back(instruction);
+	}
+
+	// 常量装入指令放在最前面
+	m_code = prologue;
+	m_code.insert(m_code.end(), body.begin(), body.end());
+
+	if (body.empty()) {
+		error = name + ": 程序为空";
+		return false;
+	}
+	if (m_code.size() > static_cast<size_t>(MaxInstructions)) {
+		error = name + ": 指令过多";
+		return false;
+	}
+	return true;
+}
+
+int EffectLibrary::load(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file) {
+		Logger::instance()->log("无法打开能力效果文件: " + path, Logger::LogLevel::ERROR);
+		return -1;
+	}
+	std::stringstream content;
+	content << file.rdbuf();
+
+	// 名称取文件名（不含目录和扩展名）
+	size_t begin = path.find_last_of("/\\");
+	begin = begin == std::string::npos ? 0 : begin + 1;
+	size_t end = path.find_last_of('.');
+	if (end == std::string::npos || end < begin) end = path.size();
+
+	return loadFromSource(path.substr(begin, end - begin), content.str());
+}
+
+int EffectLibrary::loadFromSource(const std::string& name, const std::string& source)
+{
+	EffectProgram program;
+	std::string error;
+	if (!program.compile(name, source, error)) {
+		Logger::instance()->log("能力效果编译失败: " + error, Logger::LogLevel::ERROR);
+		return -1;
+	}
+
+	Logger::instance()->log("能力效果加载完成: " + name + "，指令数: " + std::to_string(program.getCode().size()));
+	m_programs.push_back(std::move(program));
+	return static_cast<int>(m_programs.size()) - 1;
+}
+
+int EffectLibrary::find(const std::string& name) const
+{
+	for (size_t i = 0; i < m_programs.size(); ++i) {
+		if (m_programs[i].getName() == name) return static_cast<int>(i);
+	}
+	return -1;
+}
@@ -0,0 +1,258 @@
+#include "ability/EffectVM.h"
+#include "ecs/Entity.h"
+#include "components/Transform.h"
+#include "components/Corruption.h"
+#include "components/StatModifiers.h"
+#include "components/AI.h"
+#include "components/Velocity.h"
+#include "combat/DamageQueue.h"
+#include "combat/ProjectilePool.h"
+#include "spatial/CorruptionDiffusion.h"
+#include "core/Logger.h"
+
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+/// @brief 能力投射物的碰撞半径、存活时间和发射高度
+const float EFFECT_PROJECTILE_RADIUS = 0.15f;
+const float EFFECT_PROJECTILE_LIFETIME = 2.0f;
+const float EFFECT_PROJECTILE_HEIGHT = 1.0f;
+
+/// @brief 单次施放最多发射的投射物数
+const int EFFECT_MAX_PROJECTILES = 256;
+
+/// @brief 操作码名称，用于统计日志
+const char* const EFFECT_OP_NAMES[] = {
+	"LoadConst", "Add", "Mul", "SetSize", "QueryRadius", "QueryNearest", "Require",
+	"Damage", "Modify", "Assimilate", "Push", "Projectiles", "Corrupt", "Cleanse", "FlipGravity"
+};
+static_assert(sizeof(EFFECT_OP_NAMES) / sizeof(EFFECT_OP_NAMES[0]) == static_cast<size_t>(EffectOp::Count),
+	"每个操作码都需要名称");
+
+EffectVM::EffectVM(const Context& context)
+	: m_context(context), m_count(0), m_targets(TargetCapacity, nullptr), m_targetCount(0)
+{
+	m_neighbors.reserve(MaxNearest);
+	resetStats();
+}
+
+void EffectVM::run(const EffectProgram& program, Entity* const* casters, int count, uint32_t modifierSource, bool* results)
+{
+	m_count = std::min(count, static_cast<int>(MaxBatch));
+	m_targetCount = 0;
+
+	// 1. 读取施法者的位置和朝向，self 集合指向施法者本身
+	for (int i = 0; i < m_count; ++i) {
+		Entity* caster = casters[i];
+		auto* transform = caster ? caster->getComponent<Transform>() : nullptr;
+		m_casters[i] = caster;
+		m_alive[i] = transform != nullptr;	// 所有效果都以施法者位置为准，没有变换时直接失败
+		m_positions[i] = transform ? transform->position : glm::vec3(0.0f);
+
+		glm::vec3 forward = transform ? glm::vec3(transform->forward.x, 0.0f, transform->forward.z) : glm::vec3(0.0f);
+		m_forwards[i] = glm::dot(forward, forward) > 1e-6f ? glm::normalize(forward) : glm::vec3(0.0f, 0.0f, -1.0f);
+
+		const uint32_t begin = static_cast<uint32_t>(m_targetCount);
+		if (m_alive[i]) pushTarget(caster);
+		for (int s = 0; s < EffectProgram::SetRegisters; ++s) {
+			m_sets[s][i] = Span{ begin, begin };
+		}
+		m_sets[EffectProgram::SelfSet][i].end = static_cast<uint32_t>(m_targetCount);
+	}
+
+	// 2. 逐条执行并统计耗时
+	for (const EffectProgram::Instruction& instruction : program.getCode()) {
+		int alive = 0;
+		for (int i = 0; i < m_count; ++i) alive += m_alive[i] ? 1 : 0;
+		if (alive == 0) break;
+
+		const auto start = std::chrono::steady_clock::now();
+		execute(instruction, program, modifierSource);
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+
+		OpStats& stats = m_stats[static_cast<int>(instruction.op)];
+		stats.executions += alive;
+		stats.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	}
+
+	for (int i = 0; i < m_count; ++i) {
+		results[i] = m_alive[i];
+	}
+}
+
+void EffectVM::execute(const EffectProgram::Instruction& instruction, const EffectProgram& program, uint32_t modifierSource)
+{
+	const uint8_t a = instruction.a, b = instruction.b, c = instruction.c, d = instruction.d, e = instruction.e;
+
+	for (int i = 0; i < m_count; ++i) {
+		if (!m_alive[i]) continue;
+		Entity* caster = m_casters[i];
+
+		switch (instruction.op) {
+		case EffectOp::LoadConst:
+			m_numbers[a][i] = program.getConstants()[b];
+			break;
+
+		case EffectOp::Add:
+			m_numbers[a][i] = m_numbers[b][i] + m_numbers[c][i];
+			break;
+
+		case EffectOp::Mul:
+			m_numbers[a][i] = m_numbers[b][i] * m_numbers[c][i];
+			break;
+
+		case EffectOp::SetSize:
+			m_numbers[a][i] = static_cast<float>(m_sets[b][i].end - m_sets[b][i].begin);
+			break;
+
+		case EffectOp::QueryRadius: {
+			Span span{ static_cast<uint32_t>(m_targetCount), static_cast<uint32_t>(m_targetCount) };
+			if (m_context.spatialIndex) {
+				m_context.spatialIndex->forEachInRadius(m_positions[i], m_numbers[c][i], makeFilter(b, i),
+					[&](const SpatialIndex::Entry& entry, float) { pushTarget(entry.entity); });
+			}
+			span.end = static_cast<uint32_t>(m_targetCount);
+			m_sets[a][i] = span;
+			break;
+		}
+
+		case EffectOp::QueryNearest: {
+			Span span{ static_cast<uint32_t>(m_targetCount), static_cast<uint32_t>(m_targetCount) };
+			const size_t k = std::min(static_cast<size_t>(std::max(m_numbers[d][i], 0.0f)), MaxNearest);
+			if (m_context.spatialIndex) {
+				SpatialIndex::Filter filter = makeFilter(b, i);
+				filter.maxDistance = m_numbers[c][i];
+				m_context.spatialIndex->kNearest(m_positions[i], k, filter, m_neighbors);
+				for (const SpatialIndex::Neighbor& neighbor : m_neighbors) {
+					if (!pushTarget(neighbor.entity)) break;
+				}
+			}
+			span.end = static_cast<uint32_t>(m_targetCount);
+			m_sets[a][i] = span;
+			break;
+		}
+
+		case EffectOp::Require:
+			if (m_sets[a][i].begin == m_sets[a][i].end) m_alive[i] = false;
+			break;
+
+		case EffectOp::Damage:
+			if (!m_context.damageQueue) break;
+			for (uint32_t t = m_sets[a][i].begin; t < m_sets[a][i].end; ++t) {
+				m_context.damageQueue->push(caster->getId(), m_targets[t]->getId(), m_numbers[b][i], static_cast<DamageType>(c));
+			}
+			break;
+
+		case EffectOp::Modify:
+			for (uint32_t t = m_sets[a][i].begin; t < m_sets[a][i].end; ++t) {
+				if (auto* modifiers = m_targets[t]->getComponent<StatModifiers>()) {
+					modifiers->set(static_cast<StatModifiers::Stat>(b), static_cast<StatModifiers::Op>(c),
+						m_numbers[d][i], modifierSource, m_numbers[e][i]);
+				}
+			}
+			break;
+
+		case EffectOp::Assimilate:
+			for (uint32_t t = m_sets[a][i].begin; t < m_sets[a][i].end; ++t) {
+				auto* ai = m_targets[t]->getComponent<AI>();
+				if (!ai) continue;
+				ai->assimilatedTime = m_numbers[b][i];
+				ai->state = AIState::Idle;
+				ai->stateTime = 0.0f;
+				ai->desiredVelocity = glm::vec3(0.0f);
+				if (auto* velocity = m_targets[t]->getComponent<Velocity>()) {
+					velocity->linear = glm::vec3(0.0f);
+				}
+			}
+			break;
+
+		case EffectOp::Push:
+			for (uint32_t t = m_sets[a][i].begin; t < m_sets[a][i].end; ++t) {
+				auto* transform = m_targets[t]->getComponent<Transform>();
+				if (!transform || m_targets[t] == caster) continue;
+				glm::vec3 away = transform->position - m_positions[i];
+				away.y = 0.0f;
+				const float lengthSq = glm::dot(away, away);
+				away = lengthSq > 1e-6f ? away / std::sqrt(lengthSq) : m_forwards[i];
+				transform->position += away * m_numbers[b][i];
+			}
+			break;
+
+		case EffectOp::Projectiles: {
+			if (!m_context.projectiles) break;
+			const int count = std::min(static_cast<int>(std::max(m_numbers[a][i], 0.0f)), EFFECT_MAX_PROJECTILES);
+			const float arc = glm::radians(m_numbers[d][i]);
+			const float step = count > 1 ? arc / (arc >= glm::radians(360.0f) ? count : count - 1) : 0.0f;
+			const float start = count > 1 ? -0.5f * step * (arc >= glm::radians(360.0f) ? count : count - 1) : 0.0f;
+			const glm::vec3& forward = m_forwards[i];
+			const glm::vec3 origin = m_positions[i] + glm::vec3(0.0f, EFFECT_PROJECTILE_HEIGHT, 0.0f);
+			for (int k = 0; k < count; ++k) {
+				// 绕Y轴旋转水平朝向
+				const float angle = start + step * k;
+				const float cs = std::cos(angle), sn = std::sin(angle);
+				const glm::vec3 direction(forward.x * cs - forward.z * sn, 0.0f, forward.x * sn + forward.z * cs);
+				if (!m_context.projectiles->spawn(origin, direction * m_numbers[b][i], EFFECT_PROJECTILE_RADIUS, m_numbers[c][i],
+					EFFECT_PROJECTILE_LIFETIME, caster->getId(), SpatialIndex::TagEnemy)) break;
+			}
+			break;
+		}
+
+		case EffectOp::Corrupt:
+			if (auto* corruption = caster->getComponent<Corruption>()) {
+				corruption->add(m_numbers[a][i]);
+			}
+			break;
+
+		case EffectOp::Cleanse:
+			if (m_context.corruptionDiffusion) {
+				m_context.corruptionDiffusion->remove(m_positions[i], m_numbers[a][i], m_numbers[b][i]);
+			}
+			break;
+
+		case EffectOp::FlipGravity:
+			if (auto* transform = caster->getComponent<Transform>()) {
+				transform->gravityDirection *= -1.0f;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+bool EffectVM::pushTarget(Entity* entity)
+{
+	if (m_targetCount >= TargetCapacity) return false;
+	m_targets[m_targetCount++] = entity;
+	return true;
+}
+
+SpatialIndex::Filter EffectVM::makeFilter(uint8_t tag, int cast) const
+{
+	SpatialIndex::Filter filter;
+	filter.exclude = m_casters[cast];
+	if (tag == EffectProgram::TargetEnemy) filter.requireTags = SpatialIndex::TagEnemy;
+	else if (tag == EffectProgram::TargetPlayer) filter.requireTags = SpatialIndex::TagPlayer;
+	return filter;
+}
+
+void EffectVM::resetStats()
+{
+	for (OpStats& stats : m_stats) {
+		stats = OpStats{ 0, 0 };
+	}
+}
+
+void EffectVM::logStats() const
+{
+	for (int op = 0; op < static_cast<int>(EffectOp::Count); ++op) {
+		const OpStats& stats = m_stats[op];
+		if (stats.executions == 0) continue;
+		Logger::instance()->log(std::string("能力效果指令 ") + EFFECT_OP_NAMES[op] +
+			" 执行: " + std::to_string(stats.executions) +
+			" 总耗时: " + std::to_string(stats.nanoseconds / 1000) + "us" +
+			" 平均: " + std::to_string(stats.nanoseconds / stats.executions) + "ns");
+	}
+}
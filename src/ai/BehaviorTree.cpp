@@ -0,0 +1,206 @@
+#include "ai/BehaviorTree.h"
+#include "core/Logger.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+
+namespace
+{
+	/// @brief 节点描述
+	struct OpInfo
+	{
+		const char* name;	// 文本中的名称
+		BehaviorOp op;	// 操作码
+		int minParams;	// 最少参数个数
+		int maxParams;	// 最多参数个数
+		bool needsSlot;	// 是否需要黑板槽位
+	};
+
+	const OpInfo OP_INFOS[] = {
+		{ "selector",		BehaviorOp::Selector,		0, 0, false },
+		{ "sequence",		BehaviorOp::Sequence,		0, 0, false },
+		{ "invert",			BehaviorOp::Invert,			0, 0, false },
+		{ "inRange",		BehaviorOp::InRange,		1, 1, false },
+		{ "healthBelow",	BehaviorOp::HealthBelow,	1, 1, false },
+		{ "idle",			BehaviorOp::Idle,			1, 1, true },
+		{ "patrol",			BehaviorOp::Patrol,			1, 2, true },
+		{ "chase",			BehaviorOp::Chase,			2, 2, false },
+		{ "attack",			BehaviorOp::Attack,			0, 0, false },
+		{ "flee",			BehaviorOp::Flee,			1, 1, false },
+	};
+
+	const OpInfo* findOp(const std::string& name)
+	{
+		for (const OpInfo& info : OP_INFOS) {
+			if (name == info.name) return &info;
+		}
+		return nullptr;
+	}
+
+	bool isComposite(BehaviorOp op)
+	{
+		return op <= BehaviorOp::Invert;
+	}
+}
+
+bool BehaviorTree::compile(const std::string& name, const std::string& source, std::string& error)
+{
+	m_name = name;
+	m_nodes.clear();
+
+	std::vector<std::pair<int, uint16_t>> stack;	// （缩进, 节点下标）
+	std::vector<int> lineNumbers;	// 每个节点所在行号，用于报错
+	int slots = 0;
+
+	std::istringstream lines(source);
+	std::string line;
+	int lineNumber = 0;
+	while (std::getline(lines, line)) {
+		++lineNumber;
+		const std::string where = name + ":" + std::to_string(lineNumber) + ": ";
+
+		// 去掉注释，计算缩进（制表符按4个空格）
+		line = line.substr(0, line.find('#'));
+		int indent = 0;
+		size_t pos = 0;
+		for (; pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'); ++pos) {
+			indent += line[pos] == '\t' ? 4 : 1;
+		}
+		std::istringstream tokens(line.substr(pos));
+		std::string opName;
+		if (!(tokens >> opName)) continue;	// 空行
+
+		const OpInfo* info = findOp(opName);
+		if (!info) {
+			error = where + "未知节点 " + opName;
+			return false;
+		}
+
+		Node node{ info->op, 0xFF, Behavior::NoNode, 0, 0, { 0.0f, 0.0f } };
+		int paramCount = 0;
+		std::string token;
+		while (tokens >> token) {
+			if (paramCount >= info->maxParams) {
+				error = where + opName + " 参数过多";
+				return false;
+			}
+			char* endPtr = nullptr;
+			node.params[paramCount++] = std::strtof(token.c_str(), &endPtr);
+			if (*endPtr != '\0') {
+				error = where + "无效的参数 " + token;
+				return false;
+			}
+		}
+		if (paramCount < info->minParams) {
+			error = where + opName + " 参数不足";
+			return false;
+		}
+		if (info->op == BehaviorOp::Patrol && paramCount < 2) {
+			node.params[1] = -1.0f;	// 不检查玩家距离
+		}
+
+		// 根据缩进找到父节点
+		while (!stack.empty() && stack.back().first >= indent) {
+			stack.pop_back();
+		}
+		if (stack.empty()) {
+			if (!m_nodes.empty()) {
+				error = where + "只能有一个根节点";
+				return false;
+			}
+		}
+		else {
+			const uint16_t parent = stack.back().second;
+			if (!isComposite(m_nodes[parent].op)) {
+				error = where + "叶子节点不能有子节点";
+				return false;
+			}
+			node.parent = parent;
+		}
+
+		if (info->needsSlot) {
+			if (slots >= Behavior::BlackboardSize) {
+				error = where + "黑板槽位不足";
+				return false;
+			}
+			node.slot = static_cast<uint8_t>(slots++);
+		}
+		if (m_nodes.size() >= Behavior::NoNode) {
+			error = where + "节点过多";
+			return false;
+		}
+
+		stack.push_back({ indent, static_cast<uint16_t>(m_nodes.size()) });
+		m_nodes.push_back(node);
+		lineNumbers.push_back(lineNumber);
+	}
+
+	if (m_nodes.empty()) {
+		error = name + ": 行为树为空";
+		return false;
+	}
+
+	// 计算子树结束位置，并检查组合节点的子节点数量
+	for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; --i) {
+		uint16_t end = static_cast<uint16_t>(i + 1);
+		int children = 0;
+		while (end < m_nodes.size() && m_nodes[end].parent == i) {
+			end = m_nodes[end].end;
+			++children;
+		}
+		m_nodes[i].end = end;
+
+		const std::string where = name + ":" + std::to_string(lineNumbers[i]) + ": ";
+		if (isComposite(m_nodes[i].op) && children == 0) {
+			error = where + "组合节点没有子节点";
+			return false;
+		}
+		if (m_nodes[i].op == BehaviorOp::Invert && children != 1) {
+			error = where + "invert 只能有一个子节点";
+			return false;
+		}
+	}
+	return true;
+}
+
+int BehaviorTreeLibrary::load(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file) {
+		Logger::instance()->log("无法打开行为树文件: " + path, Logger::LogLevel::ERROR);
+		return -1;
+	}
+	std::stringstream content;
+	content << file.rdbuf();
+
+	// 名称取文件名（不含目录和扩展名）
+	size_t begin = path.find_last_of("/\\");
+	begin = begin == std::string::npos ? 0 : begin + 1;
+	size_t end = path.find_last_of('.');
+	if (end == std::string::npos || end < begin) end = path.size();
+
+	return loadFromSource(path.substr(begin, end - begin), content.str());
+}
+
+int BehaviorTreeLibrary::loadFromSource(const std::string& name, const std::string& source)
+{
+	BehaviorTree tree;
+	std::string error;
+	if (!tree.compile(name, source, error)) {
+		Logger::instance()->log("行为树编译失败: " + error, Logger::LogLevel::ERROR);
+		return -1;
+	}
+
+	Logger::instance()->log("行为树加载完成: " + name + "，节点数: " + std::to_string(tree.getNodes().size()));
+	m_trees.push_back(std::move(tree));
+	return static_cast<int>(m_trees.size()) - 1;
+}
+
+int BehaviorTreeLibrary::find(const std::string& name) const
+{
+	for (size_t i = 0; i < m_trees.size(); ++i) {
+		if (m_trees[i].getName() == name) return static_cast<int>(i);
+	}
+	return -1;
+}
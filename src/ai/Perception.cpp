@@ -0,0 +1,121 @@
+#include "ai/Perception.h"
+#include "navigation/NavGrid.h"
+#include "core/JobSystem.h"
+#include "core/Simd.h"
+
+#include <cfloat>
+#include <algorithm>
+
+/// @brief 超过该数量才分发给任务系统
+const size_t PERCEPTION_PARALLEL_THRESHOLD = 1024;
+
+/// @brief 每个任务块包含的4元组数量
+const int PERCEPTION_GRAIN = 64;
+
+Perception::Perception(const NavGrid* navGrid)
+	: m_pNavGrid(navGrid), m_count(0), m_target(0.0f)
+{
+}
+
+void Perception::clear()
+{
+	m_count = 0;
+	m_posX.clear();
+	m_posY.clear();
+	m_posZ.clear();
+	m_sightRange.clear();
+	m_attackRange.clear();
+	m_chaseRange.clear();
+}
+
+uint32_t Perception::add(const glm::vec3& position, float sightRange, float attackRange, float chaseRange)
+{
+	m_posX.push_back(position.x);
+	m_posY.push_back(position.y);
+	m_posZ.push_back(position.z);
+	m_sightRange.push_back(sightRange);
+	m_attackRange.push_back(attackRange);
+	m_chaseRange.push_back(chaseRange);
+	return static_cast<uint32_t>(m_count++);
+}
+
+void Perception::update(const glm::vec3* target, JobSystem* jobSystem)
+{
+	// 补齐到4的倍数，补齐部分的结果不会被读取
+	const size_t padded = (m_count + 3) & ~static_cast<size_t>(3);
+	m_posX.resize(padded, 0.0f);
+	m_posY.resize(padded, 0.0f);
+	m_posZ.resize(padded, 0.0f);
+	m_sightRange.resize(padded, 0.0f);
+	m_attackRange.resize(padded, 0.0f);
+	m_chaseRange.resize(padded, 0.0f);
+	m_distance.resize(padded);
+	m_dirX.resize(padded);
+	m_dirY.resize(padded);
+	m_dirZ.resize(padded);
+	m_flags.resize(padded);
+
+	// 没有目标时视为无限远
+	if (!target) {
+		std::fill(m_distance.begin(), m_distance.end(), FLT_MAX);
+		std::fill(m_dirX.begin(), m_dirX.end(), 0.0f);
+		std::fill(m_dirY.begin(), m_dirY.end(), 0.0f);
+		std::fill(m_dirZ.begin(), m_dirZ.end(), 0.0f);
+		std::fill(m_flags.begin(), m_flags.end(), 0);
+		return;
+	}
+
+	m_target = *target;
+	const int blocks = static_cast<int>(padded / 4);
+	if (jobSystem && m_count >= PERCEPTION_PARALLEL_THRESHOLD) {
+		jobSystem->parallelFor(blocks, PERCEPTION_GRAIN, [this](int begin, int end) {
+			compute(static_cast<size_t>(begin) * 4, static_cast<size_t>(end) * 4);
+		});
+	}
+	else {
+		compute(0, padded);
+	}
+}
+
+void Perception::compute(size_t begin, size_t end)
+{
+	const simd::float4 targetX(m_target.x);
+	const simd::float4 targetY(m_target.y);
+	const simd::float4 targetZ(m_target.z);
+	const simd::float4 zero(0.0f);
+	const simd::float4 one(1.0f);
+
+	for (size_t i = begin; i < end; i += 4) {
+		// 1. 距离和单位方向
+		const simd::float4 dx = targetX - simd::load(&m_posX[i]);
+		const simd::float4 dy = targetY - simd::load(&m_posY[i]);
+		const simd::float4 dz = targetZ - simd::load(&m_posZ[i]);
+		const simd::float4 distance = simd::sqrt(dx * dx + dy * dy + dz * dz);
+		const simd::float4 invDistance = simd::select(simd::cmpgt(distance, zero), one / distance, zero);
+		simd::store(&m_distance[i], distance);
+		simd::store(&m_dirX[i], dx * invDistance);
+		simd::store(&m_dirY[i], dy * invDistance);
+		simd::store(&m_dirZ[i], dz * invDistance);
+
+		// 2. 范围判断，每种判断得到4位掩码
+		const int inSight = simd::movemask(simd::cmple(distance, simd::load(&m_sightRange[i])));
+		const int inAttack = simd::movemask(simd::cmplt(distance, simd::load(&m_attackRange[i])));
+		const int inChase = simd::movemask(simd::cmple(distance, simd::load(&m_chaseRange[i])));
+
+		// 3. 拼装标志位，视野内的实体再检查视线
+		for (int lane = 0; lane < 4; ++lane) {
+			const int bit = 1 << lane;
+			uint8_t flags = HasTarget;
+			if (inAttack & bit) flags |= InAttackRange;
+			if (inChase & bit) flags |= InChaseRange;
+			if (inSight & bit) {
+				flags |= InSight;
+				const size_t k = i + lane;
+				if (!m_pNavGrid || m_pNavGrid->hasLineOfSight(glm::vec3(m_posX[k], m_posY[k], m_posZ[k]), m_target)) {
+					flags |= LineOfSight;
+				}
+			}
+			m_flags[i + lane] = flags;
+		}
+	}
+}
@@ -0,0 +1,126 @@
+#include "ai/Utility.h"
+#include "core/JobSystem.h"
+
+#include <algorithm>
+
+/// @brief 超过该数量才分发给任务系统
+const size_t UTILITY_PARALLEL_THRESHOLD = 1024;
+
+/// @brief 每个任务块包含的4元组数量
+const int UTILITY_GRAIN = 64;
+
+ResponseCurve::ResponseCurve(std::initializer_list<glm::vec2> points)
+	: m_segments(0), m_y0(points.size() > 0 ? points.begin()->y : 0.0f), m_x{}, m_invSpan{}, m_deltaY{}
+{
+	const glm::vec2* previous = nullptr;
+	for (const glm::vec2& point : points) {
+		if (previous && m_segments < MaxPoints - 1 && point.x > previous->x) {
+			m_x[m_segments] = previous->x;
+			m_invSpan[m_segments] = 1.0f / (point.x - previous->x);
+			m_deltaY[m_segments] = point.y - previous->y;
+			++m_segments;
+		}
+		previous = &point;
+	}
+}
+
+float ResponseCurve::evaluate(float x) const
+{
+	float y = m_y0;
+	for (int k = 0; k < m_segments; ++k) {
+		const float t = (x - m_x[k]) * m_invSpan[k];
+		y += std::min(std::max(t, 0.0f), 1.0f) * m_deltaY[k];
+	}
+	return y;
+}
+
+simd::float4 ResponseCurve::evaluate(const simd::float4& x) const
+{
+	const simd::float4 zero(0.0f);
+	const simd::float4 one(1.0f);
+	simd::float4 y(m_y0);
+	for (int k = 0; k < m_segments; ++k) {
+		const simd::float4 t = (x - simd::float4(m_x[k])) * simd::float4(m_invSpan[k]);
+		y = y + simd::min(simd::max(t, zero), one) * simd::float4(m_deltaY[k]);
+	}
+	return y;
+}
+
+UtilityEvaluator::UtilityEvaluator(int inputCount, int actionCount, float hysteresis)
+	: m_inputCount(inputCount), m_actionCount(actionCount), m_hysteresis(hysteresis), m_count(0),
+	m_inputs(inputCount)
+{
+}
+
+void UtilityEvaluator::addConsideration(int action, int input, const ResponseCurve& curve)
+{
+	// 保持按行动排序，计算时同一行动的考量连续处理
+	auto it = std::upper_bound(m_considerations.begin(), m_considerations.end(), action,
+		[](int a, const Consideration& c) { return a < c.action; });
+	m_considerations.insert(it, Consideration{ action, input, curve });
+}
+
+void UtilityEvaluator::resize(size_t count)
+{
+	m_count = count;
+	const size_t padded = (count + 3) & ~static_cast<size_t>(3);
+	for (auto& input : m_inputs) {
+		input.assign(padded, 0.0f);
+	}
+	m_current.assign(padded, 0.0f);
+	m_best.resize(padded);
+}
+
+void UtilityEvaluator::evaluate(JobSystem* jobSystem)
+{
+	const size_t padded = m_current.size();
+	const int blocks = static_cast<int>(padded / 4);
+	if (jobSystem && m_count >= UTILITY_PARALLEL_THRESHOLD) {
+		jobSystem->parallelFor(blocks, UTILITY_GRAIN, [this](int begin, int end) {
+			compute(static_cast<size_t>(begin) * 4, static_cast<size_t>(end) * 4);
+		});
+	}
+	else {
+		compute(0, padded);
+	}
+}
+
+void UtilityEvaluator::compute(size_t begin, size_t end)
+{
+	const simd::float4 zero(0.0f);
+	const simd::float4 one(1.0f);
+	const simd::float4 half(0.5f);
+	const simd::float4 hysteresis(m_hysteresis);
+	float best[4];
+
+	for (size_t i = begin; i < end; i += 4) {
+		const simd::float4 current = simd::load(&m_current[i]);
+		simd::float4 bestScore(-1.0f);
+		simd::float4 bestAction(0.0f);
+
+		size_t c = 0;
+		for (int action = 0; action < m_actionCount; ++action) {
+			// 1. 累乘该行动所有考量的曲线值
+			simd::float4 score = one;
+			for (; c < m_considerations.size() && m_considerations[c].action == action; ++c) {
+				const Consideration& consideration = m_considerations[c];
+				score = score * consideration.curve.evaluate(simd::load(&m_inputs[consideration.input][i]));
+			}
+
+			// 2. 当前行动加上滞后量
+			const simd::float4 a(static_cast<float>(action));
+			const simd::float4 isCurrent = simd::cmpgt(current, a - half) & simd::cmplt(current, a + half);
+			score = score + simd::select(isCurrent, hysteresis, zero);
+
+			// 3. 严格大于才替换，得分相同时保留靠前的行动
+			const simd::float4 better = simd::cmpgt(score, bestScore);
+			bestScore = simd::select(better, score, bestScore);
+			bestAction = simd::select(better, a, bestAction);
+		}
+
+		simd::store(best, bestAction);
+		for (int lane = 0; lane < 4; ++lane) {
+			m_best[i + lane] = static_cast<uint8_t>(best[lane]);
+		}
+	}
+}
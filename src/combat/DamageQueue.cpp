@@ -0,0 +1,45 @@
+#include "combat/DamageQueue.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "components/Health.h"
+#include "components/Resistance.h"
+
+#include <algorithm>
+
+void DamageQueue::resolve(World& world)
+{
+	if (m_events.empty()) return;
+
+	// 1. 按目标ID排序，同一目标内保持追加顺序，最后一个事件即最后一击
+	std::stable_sort(m_events.begin(), m_events.end(), [](const DamageEvent& a, const DamageEvent& b) {
+		return a.target < b.target;
+	});
+
+	// 2. 实体按ID递增存放，与排好序的事件归并
+	const auto& entities = world.getEntities();
+	size_t cursor = 0;
+	for (size_t begin = 0; begin < m_events.size();) {
+		const int target = m_events[begin].target;
+		size_t end = begin;
+		while (end < m_events.size() && m_events[end].target == target) ++end;
+
+		while (cursor < entities.size() && entities[cursor]->getId() < target) ++cursor;
+		if (cursor == entities.size()) break;
+
+		Entity* entity = entities[cursor].get();
+		auto* health = entity->getId() == target ? entity->getComponent<Health>() : nullptr;
+		if (health) {
+			// 3. 累加减免后的伤害，只修改一次生命值
+			const auto* resistance = entity->getComponent<Resistance>();
+			float total = 0.0f;
+			for (size_t i = begin; i < end; ++i) {
+				const float resist = resistance ? resistance->values[static_cast<int>(m_events[i].type)] : 0.0f;
+				total += m_events[i].amount * (1.0f - std::min(std::max(resist, 0.0f), 1.0f));
+			}
+			// 4. 最后一个事件的攻击者记为最后一击，死亡由生命值系统在帧末统一判断
+			health->damage(total, m_events[end - 1].attacker);
+		}
+		begin = end;
+	}
+	m_events.clear();
+}
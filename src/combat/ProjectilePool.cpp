@@ -0,0 +1,94 @@
+#include "combat/ProjectilePool.h"
+#include "core/JobSystem.h"
+#include "core/Simd.h"
+
+/// @brief 超过该数量才分发给任务系统
+const size_t PROJECTILE_PARALLEL_THRESHOLD = 4096;
+
+/// @brief 每个任务块包含的4元组数量
+const int PROJECTILE_INTEGRATE_GRAIN = 256;
+
+ProjectilePool::ProjectilePool(size_t capacity)
+	: m_capacity(capacity), m_count(0)
+{
+	const size_t padded = (capacity + 3) & ~static_cast<size_t>(3);
+	m_posX.resize(padded, 0.0f);
+	m_posY.resize(padded, 0.0f);
+	m_posZ.resize(padded, 0.0f);
+	m_velX.resize(padded, 0.0f);
+	m_velY.resize(padded, 0.0f);
+	m_velZ.resize(padded, 0.0f);
+	m_lifetime.resize(padded, 0.0f);
+	m_radius.resize(padded, 0.0f);
+	m_damage.resize(padded, 0.0f);
+	m_owner.resize(padded, -1);
+	m_targetTags.resize(padded, 0);
+	m_type.resize(padded, DamageType::Physical);
+}
+
+bool ProjectilePool::spawn(const glm::vec3& position, const glm::vec3& velocity, float radius, float damage, float lifetime,
+	int owner, uint32_t targetTags, DamageType type)
+{
+	if (m_count >= m_capacity) return false;
+
+	const size_t i = m_count++;
+	m_posX[i] = position.x;
+	m_posY[i] = position.y;
+	m_posZ[i] = position.z;
+	m_velX[i] = velocity.x;
+	m_velY[i] = velocity.y;
+	m_velZ[i] = velocity.z;
+	m_lifetime[i] = lifetime;
+	m_radius[i] = radius;
+	m_damage[i] = damage;
+	m_owner[i] = owner;
+	m_targetTags[i] = targetTags;
+	m_type[i] = type;
+	return true;
+}
+
+void ProjectilePool::despawn(size_t i)
+{
+	if (i >= m_count) return;
+
+	const size_t last = --m_count;
+	if (i == last) return;
+
+	m_posX[i] = m_posX[last];
+	m_posY[i] = m_posY[last];
+	m_posZ[i] = m_posZ[last];
+	m_velX[i] = m_velX[last];
+	m_velY[i] = m_velY[last];
+	m_velZ[i] = m_velZ[last];
+	m_lifetime[i] = m_lifetime[last];
+	m_radius[i] = m_radius[last];
+	m_damage[i] = m_damage[last];
+	m_owner[i] = m_owner[last];
+	m_targetTags[i] = m_targetTags[last];
+	m_type[i] = m_type[last];
+}
+
+void ProjectilePool::integrate(float deltaTime, JobSystem* jobSystem)
+{
+	const size_t padded = (m_count + 3) & ~static_cast<size_t>(3);
+	const int blocks = static_cast<int>(padded / 4);
+	if (jobSystem && m_count >= PROJECTILE_PARALLEL_THRESHOLD) {
+		jobSystem->parallelFor(blocks, PROJECTILE_INTEGRATE_GRAIN, [this, deltaTime](int begin, int end) {
+			integrateRange(static_cast<size_t>(begin) * 4, static_cast<size_t>(end) * 4, deltaTime);
+		});
+	}
+	else {
+		integrateRange(0, padded, deltaTime);
+	}
+}
+
+void ProjectilePool::integrateRange(size_t begin, size_t end, float deltaTime)
+{
+	const simd::float4 dt(deltaTime);
+	for (size_t i = begin; i < end; i += 4) {
+		simd::store(&m_posX[i], simd::load(&m_posX[i]) + simd::load(&m_velX[i]) * dt);
+		simd::store(&m_posY[i], simd::load(&m_posY[i]) + simd::load(&m_velY[i]) * dt);
+		simd::store(&m_posZ[i], simd::load(&m_posZ[i]) + simd::load(&m_velZ[i]) * dt);
+		simd::store(&m_lifetime[i], simd::load(&m_lifetime[i]) - dt);
+	}
+}
@@ -2,6 +2,7 @@
 #include "core/InputMap.h"
 #include "core/Logger.h"
 #include "ecs/World.h"
+#include "components/AI.h"
 #include "systems/PlayerControlSystem.h"
 #include "systems/AbilitySystem.h"
 #include "systems/CorruptionSystem.h"
@@ -10,9 +11,41 @@
 #include "systems/AISystem.h"
 #include "systems/CombatSystem.h"
 #include "systems/CameraSystem.h"
+#include "systems/SpatialIndexSystem.h"
+#include "systems/InfluenceSystem.h"
+#include "systems/DistortionSystem.h"
+#include "systems/CollisionSystem.h"
+#include "systems/NavigationSystem.h"
+#include "systems/CrowdSystem.h"
+#include "systems/SquadSystem.h"
+#include "systems/StatSystem.h"
+#include "systems/ProjectileSystem.h"
+#include "systems/HealthSystem.h"
+#include "spatial/SpatialIndex.h"
+#include "spatial/CorruptionField.h"
+#include "spatial/CorruptionDiffusion.h"
+#include "spatial/DistortionEffects.h"
+#include "spatial/InfluenceMap.h"
+#include "navigation/NavGrid.h"
+#include "navigation/FlowField.h"
+#include "navigation/Pathfinder.h"
+#include "ai/BehaviorTree.h"
+#include "ability/EffectProgram.h"
+#include "core/JobSystem.h"
+#include "combat/DamageQueue.h"
+#include "combat/ProjectilePool.h"
 #include "render/RenderSystem.h"
 #include "prefabs/PlayerPrefab.h"
 #include "prefabs/EnemyPrefab.h"
+#include "prefabs/EnemyPool.h"
+
+/// @brief 敌人池预先创建的暗蚀生物数
+/// @details 覆盖多次暗蚀潮汐叠加后的敌人数量，超出时退回即时创建
+const size_t ENEMY_POOL_SIZE = 512;
+
+/// @brief 世界的随机种子
+/// @details 固定种子使刷怪等随机结果可以复现
+const uint64_t WORLD_SEED = 0x4E44443Dull;
 
 Application::Application(const std::string title, int width, int height)
 	: m_pWindow(nullptr),
@@ -86,6 +119,23 @@ bool Application::initialize()
 	initOpenGLState();
 
 	m_pInputMap = std::make_unique<InputMap>(); // 创建输入映射实例
+	m_pSpatialIndex = std::make_unique<SpatialIndex>(); // 创建空间索引实例
+	m_pJobSystem = std::make_unique<JobSystem>(); // 创建任务系统实例
+	m_pCorruptionField = std::make_unique<CorruptionField>(); // 创建腐蚀场实例
+	m_pCorruptionDiffusion = std::make_unique<CorruptionDiffusion>(); // 创建腐蚀扩散场实例
+	m_pDistortionEffects = std::make_unique<DistortionEffects>(); // 创建空间扭曲效果实例
+	m_pInfluenceMap = std::make_unique<InfluenceMap>(); // 创建影响力图实例
+	m_pDamageQueue = std::make_unique<DamageQueue>(); // 创建伤害队列实例
+	m_pProjectiles = std::make_unique<ProjectilePool>(); // 创建投射物池实例
+	m_pNavGrid = std::make_unique<NavGrid>(); // 创建导航网格实例
+	m_pFlowField = std::make_unique<FlowField>(m_pNavGrid.get()); // 创建流场实例
+	m_pPathfinder = std::make_unique<Pathfinder>(m_pNavGrid.get()); // 创建寻路服务实例
+	m_pBehaviorTrees = std::make_unique<BehaviorTreeLibrary>(); // 创建行为树库实例
+	m_pBehaviorTrees->load("resources/ai/stalker.bt"); // 加载腐化潜行者的行为树
+	m_pEffects = std::make_unique<EffectLibrary>(); // 创建能力效果库实例
+	for (const char* effect : { "perception", "manipulation", "distortion", "assimilation", "purification" }) {
+		m_pEffects->load(std::string("resources/abilities/") + effect + ".fx"); // 加载能力效果程序
+	}
 	m_pInputMap.get()->addActionListener(InputMap::ExitGame, [this]() {
 		m_bIsRunning = false; // 按下ESC键退出
 		m_pLogger->log("按下ESC键，退出游戏");
@@ -114,6 +164,23 @@ void Application::initOpenGLState()
 void Application::run()
 {
 	World world;	// 创建ECS世界
+	world.setSeed(WORLD_SEED);	// 设置随机种子
+	// 销毁AI实体时取消其进行中的寻路请求，否则请求会一直留在寻路服务中
+	Pathfinder* pathfinder = m_pPathfinder.get();
+	world.addDestroyListener([pathfinder](Entity& entity) {
+		auto* ai = entity.getComponent<AI>();
+		if (!ai || ai->pathRequest == 0) return;
+		pathfinder->cancel(ai->pathRequest);
+		ai->pathRequest = 0;
+	});
+	// 销毁敌人时移出影响力图的密度计数
+	InfluenceMap* influenceMap = m_pInfluenceMap.get();
+	world.addDestroyListener([influenceMap](Entity& entity) {
+		influenceMap->removeEntity(entity.getId());
+	});
+
+	EnemyPool enemyPool(world);	// 创建敌人池，销毁的暗蚀生物回到池中
+	enemyPool.prewarm(ENEMY_POOL_SIZE);	// 加载阶段完成组件和网格的创建
 	float deltaTime = 0.0f; // 帧时间初始化为0
 
 	m_pLogger->log("开始游戏主循环");
@@ -122,19 +189,34 @@ void Application::run()
 	Prefab::createPlayer(world);
 
 	// 创建初始环境
-	auto& envSystem = std::make_unique<EnvironmentSystem>();
+	auto& envSystem = std::make_unique<EnvironmentSystem>(m_pCorruptionField.get(), m_pCorruptionDiffusion.get(), m_pJobSystem.get(), m_pInfluenceMap.get(), &enemyPool);
 	envSystem->spawnCorruptionSource(world, glm::vec3(10.0f, 0.0f, 10.0f), 15.0f, 8.0f);
 	envSystem->spawnCorruptionSource(world, glm::vec3(-10.0f, 0.0f, -10.0f), 12.0f, 6.0f);
 
-	world.addSystem(std::make_unique<MovementSystem>()); // 添加移动系统到ECS世界
+	world.addSystem(std::make_unique<SpatialIndexSystem>(m_pSpatialIndex.get())); // 添加空间索引系统到ECS世界（需最先更新）
+	world.addSystem(std::make_unique<InfluenceSystem>(m_pSpatialIndex.get(), m_pCorruptionField.get(), m_pInfluenceMap.get())); // 添加影响力系统到ECS世界（需在空间索引系统之后）
+	world.addSystem(std::make_unique<DistortionSystem>(m_pSpatialIndex.get(), m_pDistortionEffects.get())); // 添加扭曲系统到ECS世界
+	world.addSystem(std::make_unique<MovementSystem>(m_pDistortionEffects.get())); // 添加移动系统到ECS世界
+	auto collisionSystem = std::make_unique<CollisionSystem>();
+	CollisionSystem* collision = collisionSystem.get();
+	world.addDestroyListener([collision](Entity& entity) {
+		collision->removeEntity(entity.getId());	// 销毁的碰撞体移出常驻碰撞体表
+	});
+	world.addSystem(std::move(collisionSystem)); // 添加碰撞系统到ECS世界（需在移动系统之后）
 	world.addSystem(std::make_unique<CameraSystem>(m_pInputMap.get())); // 添加相机系统到ECS世界
-	world.addSystem(std::make_unique<PlayerControlSystem>(m_pInputMap.get())); // 添加玩家控制系统到ECS世界
-	world.addSystem(std::make_unique<AbilitySystem>()); // 添加能力系统到ECS世界
+	world.addSystem(std::make_unique<PlayerControlSystem>(m_pInputMap.get(), m_pProjectiles.get())); // 添加玩家控制系统到ECS世界
+	world.addSystem(std::make_unique<AbilitySystem>(m_pSpatialIndex.get(), m_pCorruptionDiffusion.get(), m_pDamageQueue.get(), m_pProjectiles.get(), m_pEffects.get())); // 添加能力系统到ECS世界
 	world.addSystem(std::make_unique<CorruptionSystem>()); // 添加腐化系统到ECS世界
-	world.addSystem(std::make_unique<CombatSystem>()); // 添加战斗系统到ECS世界
-	world.addSystem(std::make_unique<AISystem>()); // 添加AI系统到ECS世界
+	world.addSystem(std::make_unique<StatSystem>()); // 添加属性系统到ECS世界（需在腐化系统之后）
+	world.addSystem(std::make_unique<ProjectileSystem>(m_pSpatialIndex.get(), m_pDamageQueue.get(), m_pProjectiles.get(), m_pJobSystem.get())); // 添加投射物系统到ECS世界（需在战斗系统结算伤害之前）
+	world.addSystem(std::make_unique<CombatSystem>(m_pSpatialIndex.get(), m_pDamageQueue.get())); // 添加战斗系统到ECS世界
+	world.addSystem(std::make_unique<NavigationSystem>(m_pFlowField.get(), m_pPathfinder.get(), m_pJobSystem.get())); // 添加导航系统到ECS世界
+	world.addSystem(std::make_unique<AISystem>(m_pFlowField.get(), m_pPathfinder.get(), m_pBehaviorTrees.get(), m_pNavGrid.get(), m_pJobSystem.get(), m_pInfluenceMap.get())); // 添加AI系统到ECS世界
+	world.addSystem(std::make_unique<CrowdSystem>(m_pSpatialIndex.get(), m_pJobSystem.get())); // 添加群体转向系统到ECS世界（需在AI系统之后）
 	world.addSystem(std::move(envSystem)); // 添加环境系统到ECS世界
-	world.addSystem(std::make_unique<RenderSystem>()); // 添加渲染系统到ECS世界
+	world.addSystem(std::make_unique<SquadSystem>(m_pPathfinder.get(), &enemyPool)); // 添加小队系统到ECS世界（需在环境系统生成敌人之后）
+	world.addSystem(std::make_unique<HealthSystem>()); // 添加生命值系统到ECS世界（需在所有修改生命值的系统之后）
+	world.addSystem(std::make_unique<RenderSystem>(m_pCorruptionField.get(), m_pProjectiles.get())); // 添加渲染系统到ECS世界
 
 	// 创建测试敌人
 	Prefab::createDarkCreature(world, glm::vec3(10.0f, 0.0f, 0.0f));
@@ -147,6 +229,9 @@ void Application::run()
 	auto& entity3 = Prefab::createDarkCreature(world, glm::vec3(0.0f, 0.0f, -10.0f));
 	if(auto* meshRenderer = entity3.getComponent<MeshRenderer>())
 		meshRenderer->mesh->updateColor(glm::vec3(0.8f, 0.2f, 0.5f)); // 设置敌人颜色为暗粉色
+	auto& stalker = Prefab::createCorruptedStalker(world, glm::vec3(15.0f, 0.0f, -15.0f), m_pBehaviorTrees->find("stalker"));
+	if(auto* meshRenderer = stalker.getComponent<MeshRenderer>())
+		meshRenderer->mesh->updateColor(glm::vec3(0.3f, 0.8f, 0.3f)); // 设置敌人颜色为腐化绿色
 
 	m_frameTimer.start(); // 启动帧计时器
 
@@ -20,6 +20,7 @@ InputMap::InputMap()
     bindKey(SDLK_5, Ability5);
 
     bindMouse(1, AttackPrimary);
+    bindMouse(3, AttackRanged);
 }
 
 void InputMap::bindKey(SDL_Keycode key, Action action, StateType state)
@@ -0,0 +1,113 @@
+#include "core/JobSystem.h"
+
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned int workerCount)
+	: m_bStopping(false)
+{
+	if (workerCount == 0) {
+		unsigned int hardware = std::thread::hardware_concurrency();
+		workerCount = hardware > 1 ? hardware - 1 : 0;
+	}
+
+	m_workers.reserve(workerCount);
+	for (unsigned int i = 0; i < workerCount; ++i) {
+		m_workers.emplace_back(&JobSystem::workerLoop, this);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_bStopping = true;
+	}
+	m_condition.notify_all();
+
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+}
+
+void JobSystem::parallelFor(int count, int grain, const std::function<void(int, int)>& fn)
+{
+	if (count <= 0) return;
+	grain = std::max(1, grain);
+	const int chunkCount = (count + grain - 1) / grain;
+
+	// 只有一块或没有工作线程时直接执行
+	if (chunkCount == 1 || m_workers.empty()) {
+		fn(0, count);
+		return;
+	}
+
+	// 共享状态由所有参与者持有，避免晚启动的线程访问已失效的栈变量
+	struct State
+	{
+		std::atomic<int> nextChunk{ 0 };
+		std::atomic<int> doneChunks{ 0 };
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+	auto state = std::make_shared<State>();
+	const std::function<void(int, int)>* pFn = &fn;
+
+	auto runChunks = [state, pFn, count, grain, chunkCount]() {
+		int chunk;
+		while ((chunk = state->nextChunk.fetch_add(1)) < chunkCount) {
+			int begin = chunk * grain;
+			(*pFn)(begin, std::min(begin + grain, count));
+			if (state->doneChunks.fetch_add(1) + 1 == chunkCount) {
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->finished.notify_all();
+			}
+		}
+	};
+
+	// 通知工作线程参与，调用线程同时执行
+	int helpers = std::min(static_cast<int>(m_workers.size()), chunkCount - 1);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (int i = 0; i < helpers; ++i) {
+			m_jobs.emplace_back(runChunks);
+		}
+	}
+	m_condition.notify_all();
+
+	runChunks();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [&state, chunkCount]() { return state->doneChunks.load() == chunkCount; });
+}
+
+void JobSystem::submit(std::function<void()> job)
+{
+	if (m_workers.empty()) {
+		job();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.emplace_back(std::move(job));
+	}
+	m_condition.notify_one();
+}
+
+void JobSystem::workerLoop()
+{
+	for (;;) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_bStopping || !m_jobs.empty(); });
+			if (m_bStopping && m_jobs.empty()) return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+		job();
+	}
+}
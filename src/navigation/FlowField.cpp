@@ -0,0 +1,163 @@
+#include "navigation/FlowField.h"
+#include "navigation/NavGrid.h"
+#include "core/JobSystem.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+/// @brief 八方向邻居偏移，前四个为直行，后四个为斜行
+const int NEIGHBOR_DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+const int NEIGHBOR_DZ[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+const float NEIGHBOR_COST[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+FlowField::FlowField(const NavGrid* grid)
+	: m_pGrid(grid), m_width(grid->getWidth()), m_height(grid->getHeight()),
+	m_hasField(false), m_pending(false), m_building(false)
+{
+}
+
+FlowField::~FlowField()
+{
+	while (m_building.load(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
+}
+
+void FlowField::update(const glm::vec3& goal, JobSystem* jobSystem)
+{
+	collect();
+	if (m_pending) return;	// 上一次积分尚未完成
+
+	int goalX, goalZ;
+	if (!m_pGrid->worldToCell(goal, goalX, goalZ)) return;
+
+	const uint32_t version = m_pGrid->getVersion();
+	if (m_hasField && m_front.goalX == goalX && m_front.goalZ == goalZ && m_front.gridVersion == version) return;
+
+	// 准备后台缓冲区并发起积分
+	m_back.blocked = m_pGrid->getBlocked();
+	m_back.goalX = goalX;
+	m_back.goalZ = goalZ;
+	m_back.gridVersion = version;
+	m_pending = true;
+	m_building.store(true, std::memory_order_release);
+
+	auto job = [this]() {
+		integrate(m_back);
+		m_building.store(false, std::memory_order_release);
+	};
+	if (jobSystem) {
+		jobSystem->submit(job);
+	}
+	else {
+		job();
+	}
+
+	collect();	// 同步执行时立即生效
+}
+
+void FlowField::collect()
+{
+	if (!m_pending || m_building.load(std::memory_order_acquire)) return;
+
+	std::swap(m_front, m_back);
+	m_hasField = true;
+	m_pending = false;
+}
+
+bool FlowField::getDirection(const glm::vec3& position, glm::vec3& direction) const
+{
+	if (!m_hasField) return false;
+
+	int index = cellIndex(position);
+	if (index < 0) return false;
+
+	uint8_t dir = m_front.directions[index];
+	if (dir == NoDirection) return false;
+
+	direction = glm::vec3(static_cast<float>(NEIGHBOR_DX[dir]), 0.0f, static_cast<float>(NEIGHBOR_DZ[dir]));
+	if (dir >= 4) direction *= 0.70710678f;
+	return true;
+}
+
+float FlowField::getDistance(const glm::vec3& position) const
+{
+	if (!m_hasField) return -1.0f;
+
+	int index = cellIndex(position);
+	if (index < 0 || m_front.costs[index] == FLT_MAX) return -1.0f;
+	return m_front.costs[index] * m_pGrid->getCellSize();
+}
+
+int FlowField::cellIndex(const glm::vec3& position) const
+{
+	int x, z;
+	if (!m_pGrid->worldToCell(position, x, z)) return -1;
+	return z * m_width + x;
+}
+
+void FlowField::integrate(Layer& layer)
+{
+	const int count = m_width * m_height;
+	layer.costs.assign(count, FLT_MAX);
+	layer.directions.assign(count, NoDirection);
+
+	auto passable = [&](int x, int z) {
+		return x >= 0 && z >= 0 && x < m_width && z < m_height && !layer.blocked[z * m_width + x];
+	};
+	// 斜向移动时两侧的直行格子都必须可通行
+	auto canStep = [&](int x, int z, int d) {
+		int nx = x + NEIGHBOR_DX[d];
+		int nz = z + NEIGHBOR_DZ[d];
+		if (!passable(nx, nz)) return false;
+		return d < 4 || (passable(nx, z) && passable(x, nz));
+	};
+
+	// 1. Dijkstra：从目标格子向外积分代价
+	const int goal = layer.goalZ * m_width + layer.goalX;
+	layer.costs[goal] = 0.0f;
+	m_open.clear();
+	m_open.push_back({ 0.0f, goal });
+	std::greater<std::pair<float, int>> compare;
+
+	while (!m_open.empty()) {
+		std::pop_heap(m_open.begin(), m_open.end(), compare);
+		auto [cost, index] = m_open.back();
+		m_open.pop_back();
+		if (cost > layer.costs[index]) continue;	// 过期的队列项
+
+		const int x = index % m_width;
+		const int z = index / m_width;
+		for (int d = 0; d < 8; ++d) {
+			if (!canStep(x, z, d)) continue;
+			const int neighbor = index + NEIGHBOR_DZ[d] * m_width + NEIGHBOR_DX[d];
+			const float next = cost + NEIGHBOR_COST[d];
+			if (next < layer.costs[neighbor]) {
+				layer.costs[neighbor] = next;
+				m_open.push_back({ next, neighbor });
+				std::push_heap(m_open.begin(), m_open.end(), compare);
+			}
+		}
+	}
+
+	// 2. 每个格子指向代价最低的可达邻居
+	for (int z = 0; z < m_height; ++z) {
+		for (int x = 0; x < m_width; ++x) {
+			const int index = z * m_width + x;
+			if (index == goal || layer.costs[index] == FLT_MAX) continue;
+
+			float best = layer.costs[index];
+			for (int d = 0; d < 8; ++d) {
+				if (!canStep(x, z, d)) continue;
+				const float cost = layer.costs[index + NEIGHBOR_DZ[d] * m_width + NEIGHBOR_DX[d]];
+				if (cost < best) {
+					best = cost;
+					layer.directions[index] = static_cast<uint8_t>(d);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#include "navigation/NavGrid.h"
+
+#include <cmath>
+#include <cfloat>
+#include <cstdlib>
+
+NavGrid::NavGrid(int width, int height, float cellSize, const glm::vec2& origin)
+	: m_width(width), m_height(height), m_cellSize(cellSize), m_invCellSize(1.0f / cellSize),
+	m_origin(origin), m_blocked(static_cast<size_t>(width) * height, 0), m_version(0)
+{
+}
+
+bool NavGrid::worldToCell(const glm::vec3& position, int& x, int& z) const
+{
+	x = static_cast<int>(std::floor((position.x - m_origin.x) * m_invCellSize));
+	z = static_cast<int>(std::floor((position.z - m_origin.y) * m_invCellSize));
+	return x >= 0 && z >= 0 && x < m_width && z < m_height;
+}
+
+glm::vec3 NavGrid::cellCenter(int x, int z) const
+{
+	return glm::vec3(m_origin.x + (x + 0.5f) * m_cellSize, 0.0f, m_origin.y + (z + 0.5f) * m_cellSize);
+}
+
+bool NavGrid::isBlocked(int x, int z) const
+{
+	if (x < 0 || z < 0 || x >= m_width || z >= m_height) return true;
+	return m_blocked[static_cast<size_t>(z) * m_width + x] != 0;
+}
+
+void NavGrid::setBlocked(int x, int z, bool blocked)
+{
+	if (x < 0 || z < 0 || x >= m_width || z >= m_height) return;
+
+	uint8_t& cell = m_blocked[static_cast<size_t>(z) * m_width + x];
+	if ((cell != 0) == blocked) return;
+	cell = blocked ? 1 : 0;
+	++m_version;
+}
+
+bool NavGrid::hasLineOfSight(const glm::vec3& from, const glm::vec3& to) const
+{
+	const float fx = (from.x - m_origin.x) * m_invCellSize;
+	const float fz = (from.z - m_origin.y) * m_invCellSize;
+	const float tx = (to.x - m_origin.x) * m_invCellSize;
+	const float tz = (to.z - m_origin.y) * m_invCellSize;
+
+	int x = static_cast<int>(std::floor(fx));
+	int z = static_cast<int>(std::floor(fz));
+	const int endX = static_cast<int>(std::floor(tx));
+	const int endZ = static_cast<int>(std::floor(tz));
+
+	// 每个方向跨过一整格所需的参数增量，以及到下一条格线的参数
+	const float dx = tx - fx;
+	const float dz = tz - fz;
+	const int stepX = dx > 0.0f ? 1 : -1;
+	const int stepZ = dz > 0.0f ? 1 : -1;
+	const float deltaX = dx != 0.0f ? std::abs(1.0f / dx) : FLT_MAX;
+	const float deltaZ = dz != 0.0f ? std::abs(1.0f / dz) : FLT_MAX;
+	float nextX = dx != 0.0f ? (dx > 0.0f ? (x + 1 - fx) : (fx - x)) * deltaX : FLT_MAX;
+	float nextZ = dz != 0.0f ? (dz > 0.0f ? (z + 1 - fz) : (fz - z)) * deltaZ : FLT_MAX;
+
+	const int steps = std::abs(endX - x) + std::abs(endZ - z);
+	for (int i = 0; i <= steps; ++i) {
+		if (x >= 0 && z >= 0 && x < m_width && z < m_height &&
+			m_blocked[static_cast<size_t>(z) * m_width + x] != 0) {
+			return false;
+		}
+		if (nextX < nextZ) {
+			nextX += deltaX;
+			x += stepX;
+		}
+		else {
+			nextZ += deltaZ;
+			z += stepZ;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,252 @@
+#include "navigation/Pathfinder.h"
+#include "navigation/NavGrid.h"
+#include "core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+/// @brief 每批最多处理的请求数
+const size_t MAX_SEARCHES_PER_BATCH = 8;
+
+/// @brief 单次搜索最多扩展的格子数，超出视为不可达
+const int MAX_EXPANSIONS = 8192;
+
+/// @brief 缓存条目上限，超出后清空
+const size_t MAX_CACHE_ENTRIES = 4096;
+
+/// @brief 八方向邻居偏移，前四个为直行，后四个为斜行
+const int PATH_DX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+const int PATH_DZ[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+const float PATH_COST[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+Pathfinder::Pathfinder(const NavGrid* grid)
+	: m_pGrid(grid), m_width(grid->getWidth()), m_height(grid->getHeight()),
+	m_nextId(1), m_cacheVersion(grid->getVersion()), m_batchVersion(0),
+	m_pending(false), m_running(false), m_searchStamp(0)
+{
+}
+
+Pathfinder::~Pathfinder()
+{
+	while (m_running.load(std::memory_order_acquire)) {
+		std::this_thread::yield();
+	}
+}
+
+uint32_t Pathfinder::requestPath(const glm::vec3& start, const glm::vec3& goal)
+{
+	uint32_t id = m_nextId++;
+	if (m_nextId == 0) m_nextId = 1;
+
+	Request& request = m_requests[id];
+	int sx, sz, gx, gz;
+	if (!m_pGrid->worldToCell(start, sx, sz) || !m_pGrid->worldToCell(goal, gx, gz)) {
+		request.status = Status::Failed;
+		return id;
+	}
+
+	request.start = sz * m_width + sx;
+	request.goal = gz * m_width + gx;
+	request.status = Status::Pending;
+	if (!resolveFromCache(request)) {
+		m_queue.push_back(id);
+	}
+	return id;
+}
+
+Pathfinder::Status Pathfinder::takePath(uint32_t id, std::vector<glm::vec3>& waypoints)
+{
+	auto it = m_requests.find(id);
+	if (it == m_requests.end()) return Status::Failed;
+
+	Status status = it->second.status;
+	if (status == Status::Pending) return status;
+
+	waypoints.swap(it->second.waypoints);
+	m_requests.erase(it);
+	return status;
+}
+
+void Pathfinder::cancel(uint32_t id)
+{
+	m_requests.erase(id);	// 队列中的ID在出队时跳过
+}
+
+void Pathfinder::update(JobSystem* jobSystem)
+{
+	// 导航网格变化后缓存整体失效
+	if (m_pGrid->getVersion() != m_cacheVersion) {
+		m_cache.clear();
+		m_cacheVersion = m_pGrid->getVersion();
+	}
+
+	collect();
+	if (m_pending || m_queue.empty()) return;
+
+	// 打包下一批请求
+	m_batch.clear();
+	while (!m_queue.empty() && m_batch.size() < MAX_SEARCHES_PER_BATCH) {
+		uint32_t id = m_queue.front();
+		m_queue.pop_front();
+
+		auto it = m_requests.find(id);
+		if (it == m_requests.end()) continue;	// 已取消
+		if (resolveFromCache(it->second)) continue;	// 前一批已算出相同路径
+
+		m_batch.push_back({ id, it->second.start, it->second.goal, false, {} });
+	}
+	if (m_batch.empty()) return;
+
+	if (m_batchVersion != m_cacheVersion || m_blocked.empty()) {
+		m_blocked = m_pGrid->getBlocked();
+		m_batchVersion = m_cacheVersion;
+	}
+	m_pending = true;
+	m_running.store(true, std::memory_order_release);
+
+	auto job = [this]() {
+		for (Search& search : m_batch) {
+			runSearch(search);
+		}
+		m_running.store(false, std::memory_order_release);
+	};
+	if (jobSystem) {
+		jobSystem->submit(job);
+	}
+	else {
+		job();
+	}
+}
+
+void Pathfinder::collect()
+{
+	if (!m_pending || m_running.load(std::memory_order_acquire)) return;
+	m_pending = false;
+
+	const bool stale = m_batchVersion != m_cacheVersion;
+	if (!stale && m_cache.size() + m_batch.size() > MAX_CACHE_ENTRIES) {
+		m_cache.clear();
+	}
+
+	for (Search& search : m_batch) {
+		auto it = m_requests.find(search.id);
+
+		// 搜索期间网格已变化，重新排队
+		if (stale) {
+			if (it != m_requests.end()) m_queue.push_front(search.id);
+			continue;
+		}
+
+		m_cache[cacheKey(search.start, search.goal)] = search.waypoints;
+		if (it == m_requests.end()) continue;
+		it->second.status = search.found ? Status::Ready : Status::Failed;
+		it->second.waypoints.swap(search.waypoints);
+	}
+	m_batch.clear();
+}
+
+bool Pathfinder::resolveFromCache(Request& request) const
+{
+	if (m_pGrid->getVersion() != m_cacheVersion) return false;
+
+	auto it = m_cache.find(cacheKey(request.start, request.goal));
+	if (it == m_cache.end()) return false;
+
+	request.waypoints = it->second;
+	request.status = it->second.empty() ? Status::Failed : Status::Ready;
+	return true;
+}
+
+void Pathfinder::runSearch(Search& search)
+{
+	const int count = m_width * m_height;
+	if (m_visited.size() != static_cast<size_t>(count)) {
+		m_costs.assign(count, 0.0f);
+		m_parents.assign(count, -1);
+		m_visited.assign(count, 0);
+		m_searchStamp = 0;
+	}
+	if (++m_searchStamp == 0) {	// 序号回绕时重置
+		std::fill(m_visited.begin(), m_visited.end(), 0);
+		m_searchStamp = 1;
+	}
+	const uint32_t stamp = m_searchStamp;
+
+	auto passable = [&](int x, int z) {
+		return x >= 0 && z >= 0 && x < m_width && z < m_height && !m_blocked[z * m_width + x];
+	};
+	const int goalX = search.goal % m_width;
+	const int goalZ = search.goal / m_width;
+	auto heuristic = [&](int x, int z) {	// 八方向距离
+		float dx = static_cast<float>(std::abs(x - goalX));
+		float dz = static_cast<float>(std::abs(z - goalZ));
+		return std::max(dx, dz) + 0.41421356f * std::min(dx, dz);
+	};
+
+	search.found = false;
+	search.waypoints.clear();
+	if (m_blocked[search.goal]) return;
+
+	std::greater<std::pair<float, int>> compare;
+	m_open.clear();
+	m_costs[search.start] = 0.0f;
+	m_parents[search.start] = -1;
+	m_visited[search.start] = stamp;
+	m_open.push_back({ heuristic(search.start % m_width, search.start / m_width), search.start });
+
+	int expansions = 0;
+	while (!m_open.empty() && expansions < MAX_EXPANSIONS) {
+		std::pop_heap(m_open.begin(), m_open.end(), compare);
+		auto [priority, index] = m_open.back();
+		m_open.pop_back();
+
+		const int x = index % m_width;
+		const int z = index / m_width;
+		if (priority > m_costs[index] + heuristic(x, z) + 1e-4f) continue;	// 过期的队列项
+		if (index == search.goal) {
+			search.found = true;
+			break;
+		}
+		++expansions;
+
+		for (int d = 0; d < 8; ++d) {
+			const int nx = x + PATH_DX[d];
+			const int nz = z + PATH_DZ[d];
+			if (!passable(nx, nz)) continue;
+			if (d >= 4 && (!passable(nx, z) || !passable(x, nz))) continue;	// 不穿过障碍拐角
+
+			const int neighbor = nz * m_width + nx;
+			const float cost = m_costs[index] + PATH_COST[d];
+			if (m_visited[neighbor] == stamp && cost >= m_costs[neighbor]) continue;
+
+			m_visited[neighbor] = stamp;
+			m_costs[neighbor] = cost;
+			m_parents[neighbor] = index;
+			m_open.push_back({ cost + heuristic(nx, nz), neighbor });
+			std::push_heap(m_open.begin(), m_open.end(), compare);
+		}
+	}
+	if (!search.found) return;
+
+	// 回溯格子序列（从终点到起点）
+	m_cells.clear();
+	for (int index = search.goal; index != -1; index = m_parents[index]) {
+		m_cells.push_back(index);
+	}
+	std::reverse(m_cells.begin(), m_cells.end());
+
+	// 只保留拐点和终点，起点格子不输出
+	for (size_t i = 1; i < m_cells.size(); ++i) {
+		if (i + 1 < m_cells.size()) {
+			int a = m_cells[i] - m_cells[i - 1];
+			int b = m_cells[i + 1] - m_cells[i];
+			if (a == b) continue;
+		}
+		search.waypoints.push_back(m_pGrid->cellCenter(m_cells[i] % m_width, m_cells[i] / m_width));
+	}
+	if (search.waypoints.empty()) {	// 起点和终点在同一格子
+		search.waypoints.push_back(m_pGrid->cellCenter(goalX, goalZ));
+	}
+}
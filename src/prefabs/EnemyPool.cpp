@@ -0,0 +1,62 @@
+#include "prefabs/EnemyPool.h"
+#include "prefabs/EnemyPrefab.h"
+#include "components/Pooled.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "core/Logger.h"
+
+EnemyPool::EnemyPool(World& world)
+	: m_world(world), m_created(0)
+{
+	m_world.setRecycler([this](std::unique_ptr<Entity>& entity) { recycle(entity); });
+}
+
+EnemyPool::~EnemyPool()
+{
+	m_world.setRecycler(nullptr);
+}
+
+void EnemyPool::prewarm(size_t count)
+{
+	m_available.reserve(m_available.size() + count);
+	for (size_t i = 0; i < count; ++i) {
+		m_available.push_back(create());
+	}
+	Logger::instance()->log("敌人池预热完成，可用: " + std::to_string(m_available.size()));
+}
+
+Entity& EnemyPool::acquire(const glm::vec3& position)
+{
+	std::unique_ptr<Entity> entity;
+	if (m_available.empty()) {
+		// 池耗尽时即时创建，新建的实体之后同样会回到池中
+		Logger::instance()->log("敌人池已耗尽，即时创建敌人，累计创建: " + std::to_string(m_created + 1),
+			Logger::LogLevel::WARN);
+		entity = create();
+	}
+	else {
+		entity = std::move(m_available.back());
+		m_available.pop_back();
+	}
+
+	Prefab::resetDarkCreature(*entity, position);
+	return m_world.adoptEntity(std::move(entity));
+}
+
+std::unique_ptr<Entity> EnemyPool::create()
+{
+	auto entity = std::make_unique<Entity>(-1, &m_world);
+	Prefab::addDarkCreatureComponents(*entity);
+	entity->addComponent<Pooled>();
+	++m_created;
+	return entity;
+}
+
+void EnemyPool::recycle(std::unique_ptr<Entity>& entity)
+{
+	if (!entity || !entity->hasComponent<Pooled>()) return;
+
+	// 池中的实体不渲染；进行中的寻路请求已由世界的销毁监听器取消
+	if (auto* renderer = entity->getComponent<MeshRenderer>()) renderer->visible = false;
+	m_available.push_back(std::move(entity));
+}
@@ -7,11 +7,20 @@
 #include "components/Transform.h"
 #include "components/Camera.h"
 #include "components/Player.h"
+#include "spatial/CorruptionField.h"
+#include "combat/ProjectilePool.h"
 #include "core/Logger.h"
 
 #include <glad/glad.h>
 
-RenderSystem::RenderSystem() {
+/// @brief 腐蚀着色满强度对应的腐蚀场强度
+/// @details 腐蚀场采样值除以该值后作为着色器的腐蚀着色比例
+const float CORRUPTION_TINT_SCALE = 20.0f;
+
+RenderSystem::RenderSystem(const CorruptionField* corruptionField, const ProjectilePool* projectiles)
+    : m_pCorruptionField(corruptionField), m_pProjectiles(projectiles),
+    m_projectileVertices(projectiles ? projectiles->getCapacity() * 3 : 0)
+{
     // 加载核心着色器
     m_pCoreShader = new Shader("resources/shaders/core.vert", "resources/shaders/core.frag");
 
@@ -82,11 +91,19 @@ void RenderSystem::update(World& world, float deltaTime)
             glm::mat4 model = transform->getModelMatrix();
             m_pCoreShader->setMat4("model", model);
 
+            // 根据所处位置的腐蚀强度着色
+            float corruption = m_pCorruptionField
+                ? m_pCorruptionField->sample(transform->position) / CORRUPTION_TINT_SCALE : 0.0f;
+            m_pCoreShader->setFloat("corruption", corruption);
+
             // 绘制网格
             renderer->mesh->draw();
         }
     }
 
+    // 投射物
+    drawProjectiles();
+
     // 灰色地板
     drawDebugFloor(20, 1.0f);
 
@@ -194,8 +211,52 @@ void RenderSystem::drawDebugFloor(int halfSize, float step) const
 
     glm::mat4 model = glm::mat4(1.0f);
     m_pCoreShader->setMat4("model", model);
+    m_pCoreShader->setFloat("corruption", 0.0f);
 
     glBindVertexArray(vao);
     glDrawArrays(GL_LINES, 0, (halfSize * 2 + 1) * 4);
     glBindVertexArray(0);
-}
\ No newline at end of file
+}
+
+void RenderSystem::drawProjectiles()
+{
+    if (!m_pProjectiles || m_pProjectiles->getCount() == 0) return;
+
+    static GLuint vao = 0, vbo = 0;
+    if (vao == 0)
+    {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, m_projectileVertices.size() * sizeof(float), nullptr, GL_STREAM_DRAW);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+    }
+
+    const size_t count = m_pProjectiles->getCount();
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3 position = m_pProjectiles->getPosition(i);
+        m_projectileVertices[i * 3 + 0] = position.x;
+        m_projectileVertices[i * 3 + 1] = position.y;
+        m_projectileVertices[i * 3 + 2] = position.z;
+    }
+
+    glm::mat4 model = glm::mat4(1.0f);
+    m_pCoreShader->setMat4("model", model);
+    m_pCoreShader->setFloat("corruption", 0.0f);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * 3 * sizeof(float), m_projectileVertices.data());
+
+    // 法线和颜色没有顶点数组，使用固定值
+    glVertexAttrib3f(1, 0.0f, 1.0f, 0.0f);
+    glVertexAttrib3f(3, 1.0f, 0.85f, 0.3f);
+    glPointSize(4.0f);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(count));
+    glBindVertexArray(0);
+}
@@ -0,0 +1,132 @@
+#include "spatial/CorruptionDiffusion.h"
+#include "core/JobSystem.h"
+#include "core/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// @brief 每个任务处理的行数
+/// @details 条带足够大以摊薄调度开销，又足够小以便在多个线程间均衡
+const int ROWS_PER_JOB = 32;
+
+CorruptionDiffusion::CorruptionDiffusion(int size, float cellSize, const glm::vec2& origin)
+	: m_size(size), m_cellSize(cellSize), m_invCellSize(1.0f / cellSize), m_origin(origin),
+	m_diffusionRate(0.5f), m_decayRate(0.05f),
+	m_front(static_cast<size_t>(size) * size, 0.0f), m_back(static_cast<size_t>(size) * size, 0.0f)
+{
+}
+
+void CorruptionDiffusion::setRates(float diffusionRate, float decayRate)
+{
+	m_diffusionRate = diffusionRate;
+	m_decayRate = decayRate;
+}
+
+void CorruptionDiffusion::inject(const glm::vec3& position, float radius, float amount)
+{
+	m_stamps.push_back({ position, radius, amount });
+}
+
+void CorruptionDiffusion::remove(const glm::vec3& position, float radius, float amount)
+{
+	m_stamps.push_back({ position, radius, -amount });
+}
+
+void CorruptionDiffusion::step(float deltaTime, JobSystem* jobSystem)
+{
+	applyStamps();
+
+	// 显式格式的稳定条件为 k <= 0.25
+	float k = std::min(0.25f, m_diffusionRate * deltaTime * m_invCellSize * m_invCellSize);
+	float keep = std::max(0.0f, 1.0f - m_decayRate * deltaTime);
+
+	// 边界单元固定为0，只计算内部行
+	const int rows = m_size - 2;
+	if (jobSystem) {
+		jobSystem->parallelFor(rows, ROWS_PER_JOB, [this, k, keep](int begin, int end) {
+			stepRows(begin + 1, end + 1, k, keep);
+		});
+	}
+	else {
+		stepRows(1, m_size - 1, k, keep);
+	}
+
+	std::swap(m_front, m_back);
+}
+
+float CorruptionDiffusion::sample(const glm::vec3& position) const
+{
+	// 单元值位于单元中心
+	float u = (position.x - m_origin.x) * m_invCellSize - 0.5f;
+	float v = (position.z - m_origin.y) * m_invCellSize - 0.5f;
+	if (u < 0.0f || v < 0.0f || u >= m_size - 1 || v >= m_size - 1) return 0.0f;
+
+	int x = static_cast<int>(u);
+	int z = static_cast<int>(v);
+	float fx = u - x;
+	float fz = v - z;
+
+	const float* row0 = &m_front[static_cast<size_t>(z) * m_size + x];
+	const float* row1 = row0 + m_size;
+	float top = row0[0] + (row0[1] - row0[0]) * fx;
+	float bottom = row1[0] + (row1[1] - row1[0]) * fx;
+	return top + (bottom - top) * fz;
+}
+
+void CorruptionDiffusion::applyStamps()
+{
+	for (const Stamp& stamp : m_stamps) {
+		float cx = (stamp.position.x - m_origin.x) * m_invCellSize;
+		float cz = (stamp.position.z - m_origin.y) * m_invCellSize;
+		float r = std::max(stamp.radius * m_invCellSize, 0.5f);	// 至少覆盖一个单元
+
+		int x0 = std::max(1, static_cast<int>(cx - r));
+		int x1 = std::min(m_size - 2, static_cast<int>(cx + r));
+		int z0 = std::max(1, static_cast<int>(cz - r));
+		int z1 = std::min(m_size - 2, static_cast<int>(cz + r));
+
+		for (int z = z0; z <= z1; ++z) {
+			float dz = z + 0.5f - cz;
+			float* row = &m_front[static_cast<size_t>(z) * m_size];
+			for (int x = x0; x <= x1; ++x) {
+				float dx = x + 0.5f - cx;
+				if (dx * dx + dz * dz > r * r) continue;
+				row[x] = std::max(0.0f, row[x] + stamp.amount);
+			}
+		}
+	}
+	m_stamps.clear();
+}
+
+void CorruptionDiffusion::stepRows(int rowBegin, int rowEnd, float k, float keep)
+{
+	const int n = m_size;
+	const simd::float4 vk(k);
+	const simd::float4 vKeep(keep);
+	const simd::float4 vFour(4.0f);
+
+	for (int z = rowBegin; z < rowEnd; ++z) {
+		const float* up = &m_front[static_cast<size_t>(z - 1) * n];
+		const float* mid = &m_front[static_cast<size_t>(z) * n];
+		const float* down = &m_front[static_cast<size_t>(z + 1) * n];
+		float* out = &m_back[static_cast<size_t>(z) * n];
+
+		out[0] = 0.0f;
+		int x = 1;
+		// 4路SIMD处理主体部分
+		for (; x + 4 <= n - 1; x += 4) {
+			simd::float4 c = simd::load(mid + x);
+			simd::float4 sum = simd::load(up + x) + simd::load(down + x)
+				+ simd::load(mid + x - 1) + simd::load(mid + x + 1);
+			simd::float4 next = (c + vk * (sum - vFour * c)) * vKeep;
+			simd::store(out + x, next);
+		}
+		// 剩余部分逐个处理
+		for (; x < n - 1; ++x) {
+			float c = mid[x];
+			float sum = up[x] + down[x] + mid[x - 1] + mid[x + 1];
+			out[x] = (c + k * (sum - 4.0f * c)) * keep;
+		}
+		out[n - 1] = 0.0f;
+	}
+}
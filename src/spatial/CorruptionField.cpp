@@ -0,0 +1,107 @@
+#include "spatial/CorruptionField.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// @brief 腐蚀源重新光栅化的容差
+/// @details 腐蚀源强度每帧都会缓慢增长，变化超过容差才重新光栅化
+const float POWER_TOLERANCE = 0.25f;
+const float POSITION_TOLERANCE = 0.1f;
+
+CorruptionField::CorruptionField(int width, int height, float cellSize, const glm::vec2& origin)
+	: m_width(width), m_height(height), m_cellSize(cellSize), m_invCellSize(1.0f / cellSize),
+	m_origin(origin), m_values(static_cast<size_t>(width) * height, 0.0f), m_frame(0), m_version(0)
+{
+}
+
+void CorruptionField::beginUpdate()
+{
+	++m_frame;
+}
+
+void CorruptionField::setSource(int id, const glm::vec3& position, float power, float radius)
+{
+	auto it = m_stamps.find(id);
+	if (it == m_stamps.end()) {
+		Stamp stamp{ position, power, radius, m_frame };
+		rasterize(stamp, 1.0f);
+		m_stamps.emplace(id, stamp);
+		return;
+	}
+
+	Stamp& stamp = it->second;
+	stamp.lastSeen = m_frame;
+
+	bool dirty = std::abs(stamp.power - power) > POWER_TOLERANCE
+		|| stamp.radius != radius
+		|| glm::distance(stamp.position, position) > POSITION_TOLERANCE;
+	if (!dirty) return;
+
+	rasterize(stamp, -1.0f);
+	stamp.position = position;
+	stamp.power = power;
+	stamp.radius = radius;
+	rasterize(stamp, 1.0f);
+}
+
+void CorruptionField::removeStaleSources()
+{
+	for (auto it = m_stamps.begin(); it != m_stamps.end();) {
+		if (it->second.lastSeen != m_frame) {
+			rasterize(it->second, -1.0f);
+			it = m_stamps.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+
+	// 所有腐蚀源都已移除时清零，消除反复加减带来的浮点误差
+	if (m_stamps.empty()) {
+		std::fill(m_values.begin(), m_values.end(), 0.0f);
+	}
+}
+
+float CorruptionField::sample(const glm::vec3& position) const
+{
+	float u = (position.x - m_origin.x) * m_invCellSize;
+	float v = (position.z - m_origin.y) * m_invCellSize;
+	if (u < 0.0f || v < 0.0f || u >= m_width - 1 || v >= m_height - 1) return 0.0f;
+
+	int x = static_cast<int>(u);
+	int z = static_cast<int>(v);
+	float fx = u - x;
+	float fz = v - z;
+
+	const float* row0 = &m_values[static_cast<size_t>(z) * m_width + x];
+	const float* row1 = row0 + m_width;
+	float top = row0[0] + (row0[1] - row0[0]) * fx;
+	float bottom = row1[0] + (row1[1] - row1[0]) * fx;
+	return top + (bottom - top) * fz;
+}
+
+void CorruptionField::rasterize(const Stamp& stamp, float sign)
+{
+	if (stamp.radius <= 0.0f) return;
+
+	// 计算印记覆盖的节点范围
+	int x0 = std::max(0, static_cast<int>(std::ceil((stamp.position.x - stamp.radius - m_origin.x) * m_invCellSize)));
+	int x1 = std::min(m_width - 1, static_cast<int>(std::floor((stamp.position.x + stamp.radius - m_origin.x) * m_invCellSize)));
+	int z0 = std::max(0, static_cast<int>(std::ceil((stamp.position.z - stamp.radius - m_origin.y) * m_invCellSize)));
+	int z1 = std::min(m_height - 1, static_cast<int>(std::floor((stamp.position.z + stamp.radius - m_origin.y) * m_invCellSize)));
+
+	const float invRadius = 1.0f / stamp.radius;
+	for (int z = z0; z <= z1; ++z) {
+		float dz = m_origin.y + z * m_cellSize - stamp.position.z;
+		float* row = &m_values[static_cast<size_t>(z) * m_width];
+		for (int x = x0; x <= x1; ++x) {
+			float dx = m_origin.x + x * m_cellSize - stamp.position.x;
+			float distance = std::sqrt(dx * dx + dz * dz);
+			if (distance <= stamp.radius) {
+				// 距离越近影响越大（线性衰减）
+				row[x] += sign * stamp.power * (1.0f - distance * invRadius);
+			}
+		}
+	}
+	++m_version;
+}
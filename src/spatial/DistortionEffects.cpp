@@ -0,0 +1,39 @@
+#include "spatial/DistortionEffects.h"
+#include "spatial/SpatialIndex.h"
+#include "ecs/World.h"
+#include "components/SpatialDistortion.h"
+
+/// @brief 重力偏移的牵引速度
+/// @details 强度为1的重力偏移区域对实体施加的牵引速度（单位/秒）
+const float GRAVITY_SHIFT_SPEED = 4.0f;
+
+void DistortionEffects::resolve(World& world, const SpatialIndex& spatialIndex)
+{
+	const size_t count = world.getEntities().size();
+	m_timeScales.assign(count, 1.0f);
+	m_gravities.assign(count, glm::vec3(0.0f));
+
+	for (const auto& entry : spatialIndex.getEntries()) {
+		if (!(entry.tags & SpatialIndex::TagDistortion)) continue;
+
+		auto* distortion = entry.entity->getComponent<SpatialDistortion>();
+		if (distortion->type == DistortionType::SpatialRift) continue;	// 空间裂隙由战斗系统处理
+
+		SpatialIndex::Filter filter;
+		filter.excludeTags = SpatialIndex::TagDistortion;	// 扭曲之间互不影响
+
+		if (distortion->type == DistortionType::TimeDilation) {
+			spatialIndex.forEachInRadius(distortion->center, distortion->radius, filter,
+				[this, distortion](const SpatialIndex::Entry& e, float) {
+					m_timeScales[e.slot] *= distortion->timeScale;
+				});
+		}
+		else {
+			glm::vec3 pull = distortion->gravityDirection * (distortion->strength * GRAVITY_SHIFT_SPEED);
+			spatialIndex.forEachInRadius(distortion->center, distortion->radius, filter,
+				[this, pull](const SpatialIndex::Entry& e, float) {
+					m_gravities[e.slot] += pull;
+				});
+		}
+	}
+}
@@ -0,0 +1,183 @@
+#include "spatial/InfluenceMap.h"
+#include "spatial/SpatialIndex.h"
+#include "spatial/CorruptionField.h"
+#include "ecs/Entity.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// @brief 威胁的半衰期（秒）
+const float INFLUENCE_THREAT_HALF_LIFE = 5.0f;
+
+/// @brief 玩家停留在同一格子时重新写入威胁的间隔（秒）
+const float INFLUENCE_THREAT_REFRESH = 0.25f;
+
+/// @brief 威胁的影响半径（格子数），强度从中心的1线性衰减到边缘的0
+const int INFLUENCE_THREAT_RADIUS = 3;
+
+/// @brief 四邻格子计入密度的权重
+const float INFLUENCE_CROWD_NEIGHBOR_WEIGHT = 0.5f;
+
+/// @brief 敌人尚未计入任何格子的标记，与网格外的-1区分
+const int INFLUENCE_UNTRACKED = -2;
+
+InfluenceMap::InfluenceMap(int width, int height, float cellSize, const glm::vec2& origin)
+	: m_width(width), m_height(height), m_cellSize(cellSize), m_invCellSize(1.0f / cellSize), m_origin(origin),
+	m_time(0.0f),
+	m_counts(static_cast<size_t>(width) * height, 0), m_crowd(static_cast<size_t>(width) * height, 0.0f),
+	m_dirtyMask(static_cast<size_t>(width) * height, 0),
+	m_threat(static_cast<size_t>(width) * height, 0.0f), m_threatTime(static_cast<size_t>(width) * height, 0.0f),
+	m_playerCell(-1), m_threatTimer(0.0f),
+	m_corruption(static_cast<size_t>(width) * height, 0.0f), m_corruptionVersion(0), m_hasCorruption(false)
+{
+}
+
+bool InfluenceMap::worldToCell(const glm::vec3& position, int& x, int& z) const
+{
+	x = static_cast<int>(std::floor((position.x - m_origin.x) * m_invCellSize));
+	z = static_cast<int>(std::floor((position.z - m_origin.y) * m_invCellSize));
+	return x >= 0 && z >= 0 && x < m_width && z < m_height;
+}
+
+void InfluenceMap::update(const SpatialIndex& index, const CorruptionField* corruptionField, float deltaTime)
+{
+	m_time += deltaTime;
+	m_threatTimer += deltaTime;
+
+	// 1. 敌人跨格、出现时修改计数，玩家跨格或定期刷新时写入威胁
+	for (const SpatialIndex::Entry& entry : index.getEntries()) {
+		int x, z;
+		const int cell = worldToCell(entry.position, x, z) ? z * m_width + x : -1;
+
+		if (entry.tags & SpatialIndex::TagPlayer) {
+			if (cell != m_playerCell || m_threatTimer >= INFLUENCE_THREAT_REFRESH) {
+				depositThreat(entry.position);
+				m_playerCell = cell;
+				m_threatTimer = 0.0f;
+			}
+			continue;
+		}
+		if (!(entry.tags & SpatialIndex::TagEnemy)) continue;
+
+		// 实体ID单调递增，新敌人出现时数组才会增长
+		const size_t id = static_cast<size_t>(entry.entity->getId());
+		if (id >= m_enemyCells.size()) m_enemyCells.resize(id + 1, INFLUENCE_UNTRACKED);
+		int& last = m_enemyCells[id];
+		if (last == cell) continue;
+
+		if (last != INFLUENCE_UNTRACKED) addCount(last, -1);
+		addCount(cell, 1);
+		last = cell;
+	}
+
+	// 2. 重新计算本帧跨格、出现和上一帧末被销毁的敌人影响到的格子
+	resolveDirty();
+
+	// 3. 腐蚀场变化后重新采样
+	if (corruptionField && (!m_hasCorruption || corruptionField->getVersion() != m_corruptionVersion)) {
+		for (int z = 0; z < m_height; ++z) {
+			for (int x = 0; x < m_width; ++x) {
+				const glm::vec3 center(m_origin.x + (x + 0.5f) * m_cellSize, 0.0f, m_origin.y + (z + 0.5f) * m_cellSize);
+				m_corruption[static_cast<size_t>(z) * m_width + x] = corruptionField->sample(center);
+			}
+		}
+		m_corruptionVersion = corruptionField->getVersion();
+		m_hasCorruption = true;
+	}
+}
+
+void InfluenceMap::removeEntity(int entity)
+{
+	const size_t id = static_cast<size_t>(entity);
+	if (id >= m_enemyCells.size() || m_enemyCells[id] == INFLUENCE_UNTRACKED) return;
+
+	addCount(m_enemyCells[id], -1);
+	m_enemyCells[id] = INFLUENCE_UNTRACKED;
+}
+
+float InfluenceMap::sample(Layer layer, const glm::vec3& position) const
+{
+	int x, z;
+	if (!worldToCell(position, x, z)) return 0.0f;
+
+	const int cell = z * m_width + x;
+	switch (layer) {
+	case Threat:		return decayedThreat(cell);
+	case Crowd:			return m_crowd[cell];
+	case Corruption:	return m_corruption[cell];
+	default:			return 0.0f;
+	}
+}
+
+void InfluenceMap::addCount(int cell, int delta)
+{
+	if (cell < 0) return;
+	m_counts[cell] += delta;
+
+	// 自身和四邻的平滑值都受影响
+	const int x = cell % m_width;
+	const int z = cell / m_width;
+	const int offsets[5][2] = { { 0, 0 }, { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+	for (const auto& offset : offsets) {
+		const int nx = x + offset[0];
+		const int nz = z + offset[1];
+		if (nx < 0 || nz < 0 || nx >= m_width || nz >= m_height) continue;
+
+		const int neighbor = nz * m_width + nx;
+		if (!m_dirtyMask[neighbor]) {
+			m_dirtyMask[neighbor] = 1;
+			m_dirty.push_back(neighbor);
+		}
+	}
+}
+
+void InfluenceMap::resolveDirty()
+{
+	for (int cell : m_dirty) {
+		const int x = cell % m_width;
+		const int z = cell / m_width;
+		int neighbors = 0;
+		if (x > 0) neighbors += m_counts[cell - 1];
+		if (x + 1 < m_width) neighbors += m_counts[cell + 1];
+		if (z > 0) neighbors += m_counts[cell - m_width];
+		if (z + 1 < m_height) neighbors += m_counts[cell + m_width];
+
+		m_crowd[cell] = m_counts[cell] + INFLUENCE_CROWD_NEIGHBOR_WEIGHT * neighbors;
+		m_dirtyMask[cell] = 0;
+	}
+	m_dirty.clear();
+}
+
+void InfluenceMap::depositThreat(const glm::vec3& position)
+{
+	const float fx = (position.x - m_origin.x) * m_invCellSize;
+	const float fz = (position.z - m_origin.y) * m_invCellSize;
+	const int cx = static_cast<int>(std::floor(fx));
+	const int cz = static_cast<int>(std::floor(fz));
+	const float invRadius = 1.0f / (INFLUENCE_THREAT_RADIUS + 1);
+
+	const int x0 = std::max(0, cx - INFLUENCE_THREAT_RADIUS);
+	const int x1 = std::min(m_width - 1, cx + INFLUENCE_THREAT_RADIUS);
+	const int z0 = std::max(0, cz - INFLUENCE_THREAT_RADIUS);
+	const int z1 = std::min(m_height - 1, cz + INFLUENCE_THREAT_RADIUS);
+	for (int z = z0; z <= z1; ++z) {
+		for (int x = x0; x <= x1; ++x) {
+			const float dx = x + 0.5f - fx;
+			const float dz = z + 0.5f - fz;
+			const float strength = 1.0f - std::sqrt(dx * dx + dz * dz) * invRadius;
+			if (strength <= 0.0f) continue;
+
+			// 先把旧值衰减到当前时刻，再取较大者
+			const int cell = z * m_width + x;
+			m_threat[cell] = std::max(decayedThreat(cell), strength);
+			m_threatTime[cell] = m_time;
+		}
+	}
+}
+
+float InfluenceMap::decayedThreat(int cell) const
+{
+	const float value = m_threat[cell];
+	if (value <= 0.0f) return 0.0f;
+	return value * std::exp2(-(m_time - m_threatTime[cell]) / INFLUENCE_THREAT_HALF_LIFE);
+}
@@ -0,0 +1,63 @@
+#include "spatial/SpatialIndex.h"
+#include "ecs/World.h"
+#include "components/Transform.h"
+#include "components/Player.h"
+#include "components/Enemy.h"
+#include "components/CorruptionSource.h"
+#include "components/SpatialDistortion.h"
+
+SpatialIndex::SpatialIndex(float cellSize, int bucketCount)
+	: m_cellSize(cellSize), m_invCellSize(1.0f / cellSize), m_bucketCount(bucketCount),
+	m_minCellX(0), m_maxCellX(-1), m_minCellZ(0), m_maxCellZ(-1)
+{
+	m_bucketStart.assign(m_bucketCount + 1, 0);
+}
+
+void SpatialIndex::rebuild(World& world)
+{
+	const auto& entities = world.getEntities();
+
+	// 1. 收集所有有位置的实体
+	std::vector<Entry>& unsorted = m_unsorted;
+	unsorted.clear();
+	m_minCellX = m_minCellZ = std::numeric_limits<int>::max();
+	m_maxCellX = m_maxCellZ = std::numeric_limits<int>::min();
+
+	for (size_t i = 0; i < entities.size(); ++i) {
+		Entity* entity = entities[i].get();
+		auto* transform = entity->getComponent<Transform>();
+		if (!transform) continue;
+
+		uint32_t tags = TagNone;
+		if (entity->hasComponent<Player>()) tags |= TagPlayer;
+		if (entity->hasComponent<Enemy>()) tags |= TagEnemy;
+		if (entity->hasComponent<CorruptionSource>()) tags |= TagCorruptionSource;
+		if (entity->hasComponent<SpatialDistortion>()) tags |= TagDistortion;
+
+		Entry entry{ entity, transform->position, tags, static_cast<int>(i),
+			cellCoord(transform->position.x), cellCoord(transform->position.z) };
+		m_minCellX = std::min(m_minCellX, entry.cellX);
+		m_maxCellX = std::max(m_maxCellX, entry.cellX);
+		m_minCellZ = std::min(m_minCellZ, entry.cellZ);
+		m_maxCellZ = std::max(m_maxCellZ, entry.cellZ);
+		unsorted.push_back(entry);
+	}
+
+	// 2. 统计每个桶的数量
+	std::fill(m_bucketStart.begin(), m_bucketStart.end(), 0);
+	for (const Entry& e : unsorted) {
+		++m_bucketStart[bucketOf(e.cellX, e.cellZ) + 1];
+	}
+
+	// 3. 前缀和得到每个桶的起始位置
+	for (int b = 0; b < m_bucketCount; ++b) {
+		m_bucketStart[b + 1] += m_bucketStart[b];
+	}
+
+	// 4. 按桶放置条目
+	m_entries.resize(unsorted.size());
+	m_cursor.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+	for (const Entry& e : unsorted) {
+		m_entries[m_cursor[bucketOf(e.cellX, e.cellZ)]++] = e;
+	}
+}
@@ -9,258 +9,566 @@
 #include "components/Attack.h"
 #include "components/CombatInput.h"
 #include "components/MovementProperties.h"
-#include "core/Logger.h"
+#include "components/Behavior.h"
+#include "navigation/FlowField.h"
+#include "navigation/Pathfinder.h"
+#include "core/JobSystem.h"
+#include "spatial/InfluenceMap.h"
+
+#include <cmath>
+
+/// @brief 细节层次档位的距离上限和更新周期（帧）
+/// @details 中距离仍覆盖最大追逐距离，远处的敌人不可能处于追逐或攻击状态
+const float AI_LOD_NEAR_DISTANCE = 20.0f;
+const float AI_LOD_MID_DISTANCE = 50.0f;
+const size_t AI_LOD_PERIODS[] = { 1, 4, 16 };
+
+AISystem::AISystem(const FlowField* flowField, Pathfinder* pathfinder, const BehaviorTreeLibrary* behaviorTrees,
+	const NavGrid* navGrid, JobSystem* jobSystem, const InfluenceMap* influenceMap)
+	: m_perception(navGrid), m_utility(UtilityInputCount, UtilityActionCount),
+	m_pFlowField(flowField), m_pPathfinder(pathfinder), m_pBehaviorTrees(behaviorTrees),
+	m_pJobSystem(jobSystem), m_pInfluenceMap(influenceMap)
+{
+	// 休整（空闲/巡逻）：固定的基准分，其他行动都不够好时才选择
+	m_utility.addConsideration(ActionRest, InputHealth, ResponseCurve({ { 0.0f, 0.3f } }));
+
+	// 追逐：必须在追逐范围内，贴身时让位给攻击；看不见玩家时只有正在追逐的实体会继续；重伤时放弃
+	m_utility.addConsideration(ActionChase, InputChaseRatio, ResponseCurve({ { 0.0f, 0.6f }, { 0.2f, 1.0f }, { 1.0f, 0.8f }, { 1.01f, 0.0f } }));
+	m_utility.addConsideration(ActionChase, InputVisible, ResponseCurve({ { 0.0f, 0.25f }, { 1.0f, 1.0f } }));
+	m_utility.addConsideration(ActionChase, InputHealth, ResponseCurve({ { 0.0f, 0.0f }, { 0.25f, 0.3f }, { 0.5f, 1.0f } }));
+
+	// 攻击：攻击距离内的得分是追逐最高分加滞后量的两倍以上，目标在攻击距离内时总是攻击，超出后为0
+	m_utility.addConsideration(ActionAttack, InputAttackRatio, ResponseCurve({ { 0.0f, 2.5f }, { 1.0f, 2.5f }, { 1.01f, 0.0f } }));
+
+	// 腐蚀越浓、周围同伴越多越凶猛：同样的系数作用于追逐和攻击，只影响与休整的比较，不改变追逐和攻击之间的取舍
+	for (int action : { ActionChase, ActionAttack }) {
+		m_utility.addConsideration(action, InputCorruption, ResponseCurve({ { 0.0f, 0.9f }, { 8.0f, 1.2f }, { 16.0f, 1.5f } }));
+		m_utility.addConsideration(action, InputCrowd, ResponseCurve({ { 0.0f, 0.9f }, { 3.0f, 1.1f }, { 8.0f, 1.2f } }));
+	}
+}
+
+void AISystem::StateBucket::clear()
+{
+	entities.clear();
+	ais.clear();
+	transforms.clear();
+	velocities.clear();
+	movements.clear();
+	deltaTimes.clear();
+	stateTimes.clear();
+	agents.clear();
+}
 
 void AISystem::update(World& world, float deltaTime)
 {
-	Entity* pPlayer = nullptr;
-	for (auto& entity : world.getEntities())
-	{
-		if (entity->getComponent<Player>())
-		{
-			pPlayer = entity.get();
-			break;
+	findPlayer(world);
+
+	// 所有AI实体都累积时间并登记到感知阶段
+	m_agents.clear();
+	m_perception.clear();
+	for (auto& entity : world.getEntities()) {
+		auto* ai = entity->getComponent<AI>();
+		if (!ai) continue;
+		ai->pendingDelta += deltaTime;
+
+		auto* transform = entity->getComponent<Transform>();
+		if (!transform) continue;
+		m_agents.push_back(entity.get());
+		m_perception.add(transform->position, ai->sightRange, ai->attackRange, ai->chaseRange);
+	}
+
+	// 一次性计算所有实体到玩家的距离、方向和可见性，再按距离分档
+	m_perception.update(m_pPlayer ? &m_playerPosition : nullptr, m_pJobSystem);
+	for (auto& tier : m_tiers) tier.clear();
+	for (uint32_t agent = 0; agent < m_agents.size(); ++agent) {
+		m_tiers[classify(agent)].push_back(agent);
+	}
+
+	// 每档每帧只轮询 1/周期 的实体，按状态入桶并填写效用输入
+	m_utility.resize(m_agents.size());
+	m_idle.clear();
+	m_patrol.clear();
+	m_chase.clear();
+	m_attack.clear();
+	m_behavior.clear();
+	m_behaviors.clear();
+	for (int t = 0; t < LodTierCount; ++t) {
+		std::vector<uint32_t>& tier = m_tiers[t];
+		if (tier.empty()) continue;
+
+		const size_t period = AI_LOD_PERIODS[t];
+		const size_t budget = (tier.size() + period - 1) / period;
+		size_t cursor = m_cursors[t] % tier.size();
+		for (size_t k = 0; k < budget; ++k) {
+			gather(tier[cursor]);
+			if (++cursor == tier.size()) cursor = 0;
 		}
+		m_cursors[t] = cursor;
 	}
 
-	// 更新所有AI实体
-	for (auto& entity : world.getEntities()) {
-		if (entity->getComponent<AI>()) {
-			updateAI(entity.get(), pPlayer, deltaTime);
+	// 批量选出每个实体的最优行动
+	m_utility.evaluate(m_pJobSystem);
+
+	// 逐桶处理，状态切换在帧末统一应用
+	updateIdle();
+	updatePatrol();
+	updateChase();
+	updateAttack();
+	updateBehaviors();
+	applyTransitions();
+}
+
+void AISystem::findPlayer(World& world)
+{
+	// 上一帧缓存的位置仍是同一个玩家时直接使用
+	const auto& entities = world.getEntities();
+	Entity* player = nullptr;
+	if (m_playerSlot < entities.size() && entities[m_playerSlot]->getId() == m_playerId) {
+		player = entities[m_playerSlot].get();
+	}
+	else {
+		m_playerId = -1;
+		for (size_t i = 0; i < entities.size(); ++i) {
+			if (entities[i]->getComponent<Player>()) {
+				player = entities[i].get();
+				m_playerSlot = i;
+				m_playerId = player->getId();
+				break;
+			}
 		}
 	}
+
+	m_pPlayer = nullptr;
+	m_pPlayerHealth = nullptr;
+	if (!player) return;
+
+	auto* playerTransform = player->getComponent<Transform>();
+	if (!playerTransform) return;
+	m_pPlayer = player;
+	m_pPlayerHealth = player->getComponent<Health>();
+	m_playerPosition = playerTransform->position;
 }
 
-void AISystem::updateAI(Entity* entity, Entity* player, float deltaTime)
+AISystem::LodTier AISystem::classify(uint32_t agent) const
 {
-	if (!entity) return;
+	if (!m_perception.has(agent, Perception::HasTarget)) return LodFar;
+
+	const float distance = m_perception.getDistance(agent);
+	if (distance <= AI_LOD_NEAR_DISTANCE) return LodNear;
+	if (distance <= AI_LOD_MID_DISTANCE) return LodMid;
+	return LodFar;
+}
 
+void AISystem::gather(uint32_t agent)
+{
+	Entity* entity = m_agents[agent];
 	auto* ai = entity->getComponent<AI>();
+	float deltaTime = ai->pendingDelta;
+	ai->pendingDelta = 0.0f;
+
 	auto* transform = entity->getComponent<Transform>();
 	auto* velocity = entity->getComponent<Velocity>();
-	Transform* playerTransform = nullptr;
-	float distance = 0.0f;
+	auto* movement = entity->getComponent<MovementProperties>();
+	if (!velocity || !movement) return;
+
+	// 被同化期间停止行动
+	if (ai->assimilatedTime > 0.0f) {
+		ai->assimilatedTime -= deltaTime;
+		velocity->linear = ai->desiredVelocity = glm::vec3(0.0f);
+		return;
+	}
 
+	StateBucket* bucket = &m_idle;
+	switch (ai->state) {
+	case AIState::Idle:		bucket = &m_idle;	break;
+	case AIState::Patrol:	bucket = &m_patrol;	break;
+	case AIState::Chase:	bucket = &m_chase;	break;
+	case AIState::Attack:	bucket = &m_attack;	break;
+	}
+
+	// 由行为树控制的实体单独成桶
+	auto* behavior = entity->getComponent<Behavior>();
+	if (behavior && m_pBehaviorTrees && m_pBehaviorTrees->get(behavior->tree)) {
+		bucket = &m_behavior;
+		m_behaviors.push_back(behavior);
+	}
+	else {
+		fillUtilityInputs(entity, ai, agent);
+	}
+
+	bucket->entities.push_back(entity);
+	bucket->ais.push_back(ai);
+	bucket->transforms.push_back(transform);
+	bucket->velocities.push_back(velocity);
+	bucket->movements.push_back(movement);
+	bucket->deltaTimes.push_back(deltaTime);
+	bucket->stateTimes.push_back(ai->stateTime);
+	bucket->agents.push_back(agent);
+}
+
+void AISystem::fillUtilityInputs(Entity* entity, const AI* ai, uint32_t agent)
+{
+	const float distance = m_perception.getDistance(agent);
+	auto* attack = entity->getComponent<Attack>();
+	auto* health = entity->getComponent<Health>();
+	const float attackRange = attack ? attack->range : ai->attackRange;
 
-	if (!ai || !transform || !velocity) return;
+	m_utility.getInput(InputChaseRatio)[agent] = distance / std::max(ai->chaseRange, 0.001f);
+	m_utility.getInput(InputAttackRatio)[agent] = distance / std::max(attackRange, 0.001f);
+	m_utility.getInput(InputVisible)[agent] = m_perception.has(agent, Perception::Visible) ? 1.0f : 0.0f;
+	m_utility.getInput(InputHealth)[agent] = health && health->getMax() > 0.0f ? health->getCurrent() / health->getMax() : 1.0f;
+
+	// 腐蚀浓度和同伴密度从影响力图O(1)采样
+	const glm::vec3& position = entity->getComponent<Transform>()->position;
+	m_utility.getInput(InputCorruption)[agent] = m_pInfluenceMap ? m_pInfluenceMap->sample(InfluenceMap::Corruption, position) : 0.0f;
+	m_utility.getInput(InputCrowd)[agent] = m_pInfluenceMap ? m_pInfluenceMap->sample(InfluenceMap::Crowd, position) : 0.0f;
 
-	// 状态机更新
 	switch (ai->state) {
-	case AIState::Idle:
-		idleBehavior(entity, deltaTime);
-
-		if (!player) return;
-		playerTransform = player->getComponent<Transform>();
-		if (!playerTransform) break;
-		// 计算与玩家的距离
-		distance = glm::distance(transform->position, playerTransform->position);
-
-		// 如果看到玩家，转为追击
-		if (distance <= ai->sightRange) {
-			ai->state = AIState::Chase;
-			ai->stateTimer.restart();
-			Logger::instance()->log("敌人发现玩家，开始追击");
-		}
-		break;
-
-	case AIState::Patrol:
-		patrolBehavior(entity, deltaTime);
-
-		if (!player) return;
-		playerTransform = player->getComponent<Transform>();
-		if (!playerTransform) break;
-		// 计算与玩家的距离
-		distance = glm::distance(transform->position, playerTransform->position);
-
-		// 如果看到玩家，转为追击
-		if (distance <= ai->sightRange) {
-			ai->state = AIState::Chase;
-			ai->stateTimer.restart();
-			Logger::instance()->log("敌人发现玩家，开始追击");
-		}
-		break;
+	case AIState::Chase:	m_utility.setCurrent(agent, ActionChase);	break;
+	case AIState::Attack:	m_utility.setCurrent(agent, ActionAttack);	break;
+	default:				m_utility.setCurrent(agent, ActionRest);	break;
+	}
+}
+
+void AISystem::prepare(StateBucket& bucket)
+{
+	const size_t count = bucket.entities.size();
+	const float* dt = bucket.deltaTimes.data();
+	float* stateTimes = bucket.stateTimes.data();
+
+	for (size_t i = 0; i < count; ++i) {
+		stateTimes[i] += dt[i];
+		bucket.ais[i]->stateTime = stateTimes[i];
+	}
+}
 
-	case AIState::Chase:
-		chaseBehavior(entity, player, deltaTime);
-		break;
+void AISystem::updateIdle()
+{
+	prepare(m_idle);
 
-	case AIState::Attack:
-		attackBehavior(entity, player, deltaTime);
-		break;
+	for (size_t i = 0; i < m_idle.entities.size(); ++i) {
+		const AI* ai = m_idle.ais[i];
+		const int action = m_utility.getBest(m_idle.agents[i]);
+		if (action == ActionChase) {
+			requestTransition(m_idle, i, AIState::Chase);	// 发现玩家，转为追击
+		}
+		else if (action == ActionAttack) {
+			requestTransition(m_idle, i, AIState::Attack);	// 玩家就在身边，直接攻击
+		}
+		else if (m_idle.stateTimes[i] >= ai->idleDuration) {
+			requestTransition(m_idle, i, AIState::Patrol);	// 闲置时间结束，转为巡逻
+		}
 	}
 }
 
-void AISystem::idleBehavior(Entity* entity, float deltaTime)
+void AISystem::updatePatrol()
 {
-	if (!entity) return;
+	prepare(m_patrol);
 
-	auto* ai = entity->getComponent<AI>();
-	auto* velocity = entity->getComponent<Velocity>();
-	if (!ai || !velocity) return;
+	for (size_t i = 0; i < m_patrol.entities.size(); ++i) {
+		const AI* ai = m_patrol.ais[i];
 
-	// 停止移动
-	velocity->linear = glm::vec3(0.0f);
+		// 巡逻时间结束转空闲
+		if (patrolStep(m_patrol, i) && m_patrol.stateTimes[i] >= ai->patrolDuration) {
+			requestTransition(m_patrol, i, AIState::Idle);
+		}
 
-	// 闲置时间结束后转为巡逻
-	if (ai->stateTimer.elapsed() >= ai->idleDuration) {
-		ai->state = AIState::Patrol;
-		ai->stateTimer.restart();
-		Logger::instance()->log("敌人开始巡逻");
+		// 追击或攻击得分更高时转入（覆盖转空闲）
+		const int action = m_utility.getBest(m_patrol.agents[i]);
+		if (action == ActionChase) {
+			requestTransition(m_patrol, i, AIState::Chase);
+		}
+		else if (action == ActionAttack) {
+			requestTransition(m_patrol, i, AIState::Attack);
+		}
 	}
 }
 
-void AISystem::patrolBehavior(Entity* entity, float deltaTime)
+bool AISystem::patrolStep(StateBucket& bucket, size_t i)
 {
-	if (!entity) return;
+	AI* ai = bucket.ais[i];
+	if (ai->patrolPoints.empty()) return false;
 
-	auto* ai = entity->getComponent<AI>();
-	auto* transform = entity->getComponent<Transform>();
-	auto* velocity = entity->getComponent<Velocity>();
-	auto* movementProperties = entity->getComponent<MovementProperties>();
-	if (!ai || !transform || !velocity || !movementProperties || ai->patrolPoints.empty()) return;
+	Transform* transform = bucket.transforms[i];
+	MovementProperties* movement = bucket.movements[i];
 
-	// 获取当前目标点
+	// 到达目标点，选择下一个
 	glm::vec3 target = ai->patrolPoints[ai->currentPatrolIndex];
-	float distance = glm::distance(transform->position, target);
-
-	if (distance < 0.5f) {
-		// 到达目标点，选择下一个
+	if (glm::distance(transform->position, target) < 0.5f) {
 		ai->currentPatrolIndex = (ai->currentPatrolIndex + 1) % ai->patrolPoints.size();
 		target = ai->patrolPoints[ai->currentPatrolIndex];
+		resetPath(ai);
 	}
 
 	// 计算移动方向
-	glm::vec3 direction = glm::normalize(target - transform->position);
-	movementProperties->moveSpeed = ai->patrolSpeed; // 使用巡逻速度
-	velocity->linear = direction * movementProperties->getEffectiveSpeed();
+	glm::vec3 waypoint = nextPatrolWaypoint(ai, transform->position, target);
+	glm::vec3 direction = glm::normalize(waypoint - transform->position);
+	movement->moveSpeed = ai->patrolSpeed; // 使用巡逻速度
+	bucket.velocities[i]->linear = ai->desiredVelocity = direction * movement->getEffectiveSpeed();
 
 	// 更新朝向（仅Y轴旋转）
 	transform->rotation = glm::quatLookAt(
 		glm::normalize(glm::vec3(direction.x, 0.0f, direction.z)),
 		glm::vec3(0.0f, 1.0f, 0.0f)
 	);
+	return true;
+}
+
+glm::vec3 AISystem::nextPatrolWaypoint(AI* ai, const glm::vec3& position, const glm::vec3& target)
+{
+	if (!m_pPathfinder) return target;
+
+	// 取回进行中的请求
+	if (ai->pathRequest != 0) {
+		Pathfinder::Status status = m_pPathfinder->takePath(ai->pathRequest, ai->path);
+		if (status == Pathfinder::Status::Pending) return target;	// 结果返回前先直线前进
+		ai->pathRequest = 0;
+		ai->pathIndex = 0;
+		if (status == Pathfinder::Status::Failed) {
+			ai->path.assign(1, target);	// 不可达时直线前进，不再重复请求
+		}
+		else {
+			ai->path.back() = target;	// 最后一个路径点换成准确的巡逻点
+		}
+	}
+
+	// 没有路径时发起请求
+	if (ai->path.empty()) {
+		ai->pathRequest = m_pPathfinder->requestPath(position, target);
+		return target;
+	}
 
-	// 巡逻时间结束转空闲
-	if (ai->stateTimer.elapsed() >= ai->patrolDuration) {
-		ai->state = AIState::Idle;
-		ai->stateTimer.restart();
+	// 到达路径点后前往下一个
+	while (ai->pathIndex + 1 < static_cast<int>(ai->path.size())) {
+		glm::vec3 offset = ai->path[ai->pathIndex] - position;
+		offset.y = 0.0f;
+		if (glm::dot(offset, offset) >= 0.25f) break;
+		++ai->pathIndex;
 	}
+	return ai->path[ai->pathIndex];
 }
 
-void AISystem::chaseBehavior(Entity* entity, Entity* player, float deltaTime)
+void AISystem::resetPath(AI* ai)
 {
-	if (!entity) return;
+	if (ai->pathRequest != 0 && m_pPathfinder) {
+		m_pPathfinder->cancel(ai->pathRequest);
+	}
+	ai->pathRequest = 0;
+	ai->path.clear();
+	ai->pathIndex = 0;
+}
 
-	auto* ai = entity->getComponent<AI>();
+void AISystem::updateChase()
+{
+	prepare(m_chase);
 
-	if (!player)
-	{
-		if(ai)	// 玩家不存在，转回空闲状态
-		{
-			ai->state = AIState::Idle;
-			ai->stateTimer.restart();
+	for (size_t i = 0; i < m_chase.entities.size(); ++i) {
+		// 玩家不存在，转回空闲状态
+		if (!m_pPlayer) {
+			requestTransition(m_chase, i, AIState::Idle);
+			continue;
+		}
+
+		const int action = m_utility.getBest(m_chase.agents[i]);
+		if (action == ActionAttack) {
+			requestTransition(m_chase, i, AIState::Attack);	// 接近玩家，切换到攻击状态
+			continue;
+		}
+
+		chaseStep(m_chase, i);
+		if (action == ActionRest) {
+			requestTransition(m_chase, i, AIState::Patrol);	// 玩家太远或自身重伤，返回巡逻状态
 		}
-		return;
 	}
+}
 
-	auto* transform = entity->getComponent<Transform>();
-	auto* velocity = entity->getComponent<Velocity>();
-	auto* movementProperties = entity->getComponent<MovementProperties>();
-	auto* playerTransform = player->getComponent<Transform>();
-	if (!ai || !transform || !velocity || !movementProperties || !playerTransform) return;
+void AISystem::chaseStep(StateBucket& bucket, size_t i)
+{
+	const uint32_t agent = bucket.agents[i];
+	glm::vec3 direction = m_perception.getDirection(agent);
+
+	// 能直接看到玩家时直线逼近；视线被挡住时沿流场绕开障碍，流场查不到时仍然直线逼近
+	glm::vec3 flow;
+	if (!m_perception.has(agent, Perception::Visible) && m_pFlowField &&
+		m_pFlowField->getDirection(bucket.transforms[i]->position, flow)) {
+		direction = flow;
+	}
 
-	// 计算到玩家的方向
-	glm::vec3 direction = playerTransform->position - transform->position;
-	float distance = glm::length(direction);
+	moveToward(bucket, i, direction, bucket.ais[i]->chaseSpeed);
+}
+
+void AISystem::moveToward(StateBucket& bucket, size_t i, const glm::vec3& direction, float speed)
+{
+	AI* ai = bucket.ais[i];
+	Transform* transform = bucket.transforms[i];
+	MovementProperties* movement = bucket.movements[i];
+
+	// 应用移动速度
+	movement->moveSpeed = speed;
+	bucket.velocities[i]->linear = ai->desiredVelocity = direction * movement->getEffectiveSpeed();
+
+	// 更新朝向
+	glm::quat targetRot = glm::quatLookAt(direction, glm::vec3(0, 1, 0));
+	const float rotSpeed = movement->getEffectiveSpeed() * bucket.deltaTimes[i];
+	transform->rotation = glm::slerp(transform->rotation, targetRot, glm::clamp(rotSpeed, 0.0f, 1.0f));
+}
 
-	if (distance > ai->attackRange) {
-		direction = glm::normalize(direction);
+void AISystem::stop(StateBucket& bucket, size_t i)
+{
+	bucket.velocities[i]->linear = bucket.ais[i]->desiredVelocity = glm::vec3(0.0f);
+}
 
-		// 应用移动速度
-		movementProperties->moveSpeed = ai->chaseSpeed; // 使用追击速度
-		velocity->linear = direction * movementProperties->getEffectiveSpeed();
+void AISystem::updateAttack()
+{
+	prepare(m_attack);
 
-		// 更新朝向
-		glm::quat targetRot = glm::quatLookAt(direction, glm::vec3(0, 1, 0));
-		const float rotSpeed = movementProperties->getEffectiveSpeed() * deltaTime;
-		transform->rotation = glm::slerp(transform->rotation, targetRot, glm::clamp(rotSpeed, 0.0f, 1.0f));
+	for (size_t i = 0; i < m_attack.entities.size(); ++i) {
+		// 玩家不存在，转回空闲状态
+		if (!m_pPlayer) {
+			requestTransition(m_attack, i, AIState::Idle);
+			continue;
+		}
+
+		Entity* entity = m_attack.entities[i];
+		auto* attack = entity->getComponent<Attack>();
+		auto* combat = entity->getComponent<CombatInput>();
+		if (!attack || !combat || !m_pPlayerHealth) continue;
+
+		// 超出攻击范围转追逐，不值得继续交战时返回巡逻
+		const int action = m_utility.getBest(m_attack.agents[i]);
+		if (action != ActionAttack) {
+			requestTransition(m_attack, i, action == ActionChase ? AIState::Chase : AIState::Patrol);
+			continue;
+		}
+
+		attackStep(m_attack, i, attack, combat);
 	}
+}
 
-	// 如果接近玩家，切换到攻击状态
-	if (distance < ai->attackRange) {
-		ai->state = AIState::Attack;
-		ai->stateTimer.restart();
-		Logger::instance()->log("敌人开始攻击");
+bool AISystem::attackStep(StateBucket& bucket, size_t i, Attack* attack, CombatInput* combat)
+{
+	// 攻击冷却结束，执行攻击
+	const uint32_t agent = bucket.agents[i];
+	if (attack->attackTimer.elapsed() < attack->cooldown || m_perception.getDistance(agent) <= 0.0f) return false;
+
+	Transform* transform = bucket.transforms[i];
+	glm::vec3 dir = m_perception.getDirection(agent);
+	float angle = glm::degrees(glm::acos(glm::dot(transform->forward, dir)));
+	if (angle <= attack->angle) {
+		// 应用伤害
+		combat->requestCombat(m_pPlayer);
+		attack->attackTimer.restart();
+		return true;
 	}
 
-	// 如果玩家太远，返回巡逻状态
-	if (distance > ai->chaseRange) {
-		ai->state = AIState::Patrol;
-		ai->stateTimer.restart();
-		Logger::instance()->log("玩家超出追击范围，敌人放弃");
+	glm::quat targetRot = glm::quatLookAt(dir, glm::vec3(0, 1, 0));
+	const float rotSpeed = bucket.movements[i]->getEffectiveSpeed() * bucket.deltaTimes[i];
+	transform->rotation = glm::slerp(transform->rotation, targetRot, glm::clamp(rotSpeed, 0.0f, 1.0f));
+	return false;
+}
+
+void AISystem::updateBehaviors()
+{
+	prepare(m_behavior);
+
+	for (size_t i = 0; i < m_behavior.entities.size(); ++i) {
+		Behavior* behavior = m_behaviors[i];
+		const BehaviorTree* tree = m_pBehaviorTrees->get(behavior->tree);
+		tree->tick(*behavior, [this, i](const BehaviorTree::Node& node, float* slot, bool resumed) {
+			return runLeaf(i, node, slot, resumed);
+		});
 	}
 }
 
-void AISystem::attackBehavior(Entity* entity, Entity* player, float deltaTime)
+BehaviorStatus AISystem::runLeaf(size_t i, const BehaviorTree::Node& node, float* slot, bool resumed)
 {
-	if (!entity) return;
+	StateBucket& bucket = m_behavior;
+	const float distance = m_perception.getDistance(bucket.agents[i]);
 
-	auto* ai = entity->getComponent<AI>();
+	switch (node.op) {
+	case BehaviorOp::InRange:
+		return distance <= node.params[0] ? BehaviorStatus::Success : BehaviorStatus::Failure;
+
+	case BehaviorOp::HealthBelow: {
+		auto* health = bucket.entities[i]->getComponent<Health>();
+		if (!health || health->getMax() <= 0.0f) return BehaviorStatus::Failure;
+		return health->getCurrent() < health->getMax() * node.params[0] ? BehaviorStatus::Success : BehaviorStatus::Failure;
+	}
+
+	case BehaviorOp::Idle:
+		if (!resumed) *slot = 0.0f;
+		stop(bucket, i);
+		*slot += bucket.deltaTimes[i];
+		return *slot >= node.params[0] ? BehaviorStatus::Success : BehaviorStatus::Running;
 
-	if (!player)
-	{
-		if (ai)	// 玩家不存在，转回空闲状态
-		{
-			ai->state = AIState::Idle;
-			ai->stateTimer.restart();
+	case BehaviorOp::Patrol:
+		if (!resumed) {
+			*slot = 0.0f;
+			resetPath(bucket.ais[i]);
 		}
-		return;
+		if (node.params[1] >= 0.0f && distance <= node.params[1]) return BehaviorStatus::Failure;	// 发现玩家，中断巡逻
+		if (!patrolStep(bucket, i)) return BehaviorStatus::Failure;
+		*slot += bucket.deltaTimes[i];
+		return *slot >= node.params[0] ? BehaviorStatus::Success : BehaviorStatus::Running;
+
+	case BehaviorOp::Chase:
+		if (!m_pPlayer || distance > node.params[1]) return BehaviorStatus::Failure;
+		if (distance <= node.params[0]) {
+			stop(bucket, i);
+			return BehaviorStatus::Success;
+		}
+		chaseStep(bucket, i);
+		return BehaviorStatus::Running;
+
+	case BehaviorOp::Attack: {
+		Entity* entity = bucket.entities[i];
+		auto* attack = entity->getComponent<Attack>();
+		auto* combat = entity->getComponent<CombatInput>();
+		if (!m_pPlayer || !m_pPlayerHealth || !attack || !combat) return BehaviorStatus::Failure;
+		if (distance > attack->range) return BehaviorStatus::Failure;
+
+		stop(bucket, i);
+		return attackStep(bucket, i, attack, combat) ? BehaviorStatus::Success : BehaviorStatus::Running;
 	}
 
-	auto* transform = entity->getComponent<Transform>();
-	auto* velocity = entity->getComponent<Velocity>();
-	auto* attack = entity->getComponent<Attack>();
-	auto* combat = entity->getComponent<CombatInput>();
-	auto* playerTransform = player->getComponent<Transform>();
-	auto* playerHealth = player->getComponent<Health>();
-	auto* movementProperties = entity->getComponent<MovementProperties>();
+	case BehaviorOp::Flee: {
+		if (!m_pPlayer || distance >= node.params[0]) return BehaviorStatus::Success;
 
-	if (!ai || !transform || !velocity || !attack || !combat || !playerTransform || !playerHealth || !movementProperties) return;
+		// 在水平面上背向玩家移动
+		const glm::vec3 direction = m_perception.getDirection(bucket.agents[i]);
+		glm::vec3 away(-direction.x, 0.0f, -direction.z);
+		const float length = glm::length(away);
+		if (length <= 0.0f) return BehaviorStatus::Failure;
+		moveToward(bucket, i, away / length, bucket.ais[i]->chaseSpeed);
+		return BehaviorStatus::Running;
+	}
 
-	// 停止移动
-	velocity->linear = glm::vec3(0.0f);
+	default:
+		return BehaviorStatus::Failure;
+	}
+}
 
-	// 超出攻击范围转追逐
-	float distance = glm::distance(transform->position, playerTransform->position);
-	if (distance > attack->range) {
-		ai->state = AIState::Chase;
+void AISystem::requestTransition(const StateBucket& bucket, size_t i, AIState state)
+{
+	// 同一实体本帧只保留最后一次切换
+	if (!m_transitions.empty() && m_transitions.back().ai == bucket.ais[i]) {
+		m_transitions.back().state = state;
 		return;
 	}
+	m_transitions.push_back({ bucket.ais[i], bucket.velocities[i], state });
+}
 
-	// 攻击冷却结束，执行攻击
-	if (attack->attackTimer.elapsed() >= attack->cooldown) {
-		// 计算距离和方向
-		glm::vec3 toTarget = playerTransform->position - transform->position;
-		float distance = glm::length(toTarget);
-		if (distance <= attack->range)
-		{
-			// 计算角度
-			glm::vec3 dir = glm::normalize(toTarget);
-			float angle = glm::degrees(glm::acos(glm::dot(transform->forward, dir)));
-
-			if (angle <= attack->angle)
-			{
-				// 应用伤害
-				combat->requestCombat(player);
-				attack->attackTimer.restart();
-			}
-			else
-			{
-				glm::quat targetRot = glm::quatLookAt(dir, glm::vec3(0, 1, 0));
-				const float rotSpeed = movementProperties->getEffectiveSpeed() * deltaTime;
-				transform->rotation = glm::slerp(transform->rotation, targetRot, glm::clamp(rotSpeed, 0.0f, 1.0f));
-			}
+void AISystem::applyTransitions()
+{
+	for (const Transition& transition : m_transitions) {
+		transition.ai->state = transition.state;
+		transition.ai->stateTime = 0.0f;
+		resetPath(transition.ai);
+
+		// 空闲和攻击状态原地不动
+		if (transition.state == AIState::Idle || transition.state == AIState::Attack) {
+			transition.velocity->linear = transition.ai->desiredVelocity = glm::vec3(0.0f);
 		}
 	}
-
-}
\ No newline at end of file
+	m_transitions.clear();
+}
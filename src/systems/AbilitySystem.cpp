@@ -3,58 +3,118 @@
 #include "ecs/Entity.h"
 #include "components/DarkEnergy.h"
 #include "components/Corruption.h"
-#include "components/Transform.h"
 #include "components/AbilityInput.h"
 #include "components/Cooldown.h"
+#include "components/StatModifiers.h"
+#include "ability/EffectProgram.h"
 #include "core/Logger.h"
 
-/// @brief 能力消耗配置
-/// @details 每种能力的消耗量
-const std::unordered_map<AbilityType, float> ABILITY_COST = {
-	{AbilityType::Perception, 10.0f},
-	{AbilityType::Manipulation, 20.0f},
-	{AbilityType::Distortion, 30.0f},
-	{AbilityType::Assimilation, 40.0f},
-	{AbilityType::Purification, 50.0f}
-};
+#include <algorithm>
 
 /// @brief 能力腐蚀增量系数
-/// @details 每使用一次能力，增加的腐蚀度
+/// @details 每消耗一点暗能量增加的腐蚀度
 const float CORRUPTION_PER_ENERGY = 0.1f;
 
-void AbilitySystem::update(World& world, float deltaTime)
+/// @brief 能力表
+/// @details 名称、消耗、冷却、腐蚀系数和效果程序名称，按能力类型下标排列；
+/// 效果程序从 resources/abilities/<名称>.fx 加载
+constexpr AbilitySystem::AbilityDef AbilitySystem::s_abilities[ABILITY_COUNT] = {
+	{ AbilityType::Perception,		"感知", 10.0f, 2.0f, CORRUPTION_PER_ENERGY, "perception" },
+	{ AbilityType::Manipulation,	"操控", 20.0f, 3.0f, CORRUPTION_PER_ENERGY, "manipulation" },
+	{ AbilityType::Distortion,		"扭曲", 30.0f, 5.0f, CORRUPTION_PER_ENERGY, "distortion" },
+	{ AbilityType::Assimilation,	"同化", 40.0f, 8.0f, CORRUPTION_PER_ENERGY, "assimilation" },
+	{ AbilityType::Purification,	"净化", 50.0f, 10.0f, CORRUPTION_PER_ENERGY, "purification" }
+};
+
+/// @brief 检查能力表的每一行都在自己能力类型的下标上，并且都有效果程序
+constexpr bool isAbilityTableOrdered()
 {
-	for (auto& entity : world.getEntities()) {
-		// 更新所有实体的冷却时间
-		auto* cooldown = entity->getComponent<Cooldown>();
-		if (cooldown) {
-			cooldown->update(deltaTime);
+	for (size_t i = 0; i < ABILITY_COUNT; ++i) {
+		if (abilityIndex(AbilitySystem::getAbility(static_cast<AbilityType>(i)).type) != i) return false;
+		if (!AbilitySystem::getAbility(static_cast<AbilityType>(i)).script) return false;
+	}
+	return true;
+}
+static_assert(isAbilityTableOrdered(), "能力表必须按 AbilityType 顺序排列且每项都有效果程序");
+
+AbilitySystem::AbilitySystem(SpatialIndex* spatialIndex, CorruptionDiffusion* corruptionDiffusion,
+	DamageQueue* damageQueue, ProjectilePool* projectiles, const EffectLibrary* effects)
+	: m_pEffects(effects),
+	m_vm(EffectVM::Context{ spatialIndex, damageQueue, projectiles, corruptionDiffusion }),
+	m_batchSizes{},
+	m_results{},
+	m_time(0.0f)
+{
+	for (size_t i = 0; i < ABILITY_COUNT; ++i) {
+		m_programs[i] = m_pEffects ? m_pEffects->find(s_abilities[i].script) : -1;
+		if (m_programs[i] < 0) {
+			Logger::instance()->log("能力缺少效果程序: " + std::string(s_abilities[i].name) +
+				" (" + s_abilities[i].script + ")", Logger::LogLevel::ERROR);
 		}
+	}
+}
+
+AbilitySystem::~AbilitySystem()
+{
+	m_vm.logStats();
+}
 
+void AbilitySystem::update(World& world, float deltaTime)
+{
+	// 冷却记录的是结束时刻，只需推进时钟
+	m_time += deltaTime;
+
+	// 1. 收集通过冷却和能量检查的施放，按能力分批
+	for (auto& entity : world.getEntities()) {
 		auto* abilityInput = entity->getComponent<AbilityInput>();
-		if (!abilityInput || abilityInput->requestedAbilities.empty()) {
+		if (!abilityInput || abilityInput->requestedAbilities.none()) {
 			continue;
 		}
 
-		// 处理所有请求的能力
-		for (AbilityType type : abilityInput->requestedAbilities) {
+		// 按能力类型顺序处理所有请求的能力
+		auto* cooldown = entity->getComponent<Cooldown>();
+		for (size_t i = 0; i < ABILITY_COUNT; ++i) {
+			if (!abilityInput->requestedAbilities.test(i)) continue;
+
 			// 检查冷却状态
-			if (cooldown && cooldown->isOnCooldown(type))
+			const AbilityType type = static_cast<AbilityType>(i);
+			if (cooldown && cooldown->isOnCooldown(type, m_time))
+				continue;
+
+			if (!payCost(entity.get(), s_abilities[i]))
 				continue;
 
-			if (activateAbility(entity.get(), type))
-			{
-				if (cooldown)
-					cooldown->setCooldown(type, getCooldownDuration(type));
-			}
+			m_batches[i][m_batchSizes[i]++] = entity.get();
+			if (m_batchSizes[i] == EffectVM::MaxBatch)
+				flush(i);
 		}
 
 		// 清除已处理的请求
 		abilityInput->clear();
 	}
+
+	// 2. 执行剩余的施放
+	for (size_t i = 0; i < ABILITY_COUNT; ++i) {
+		flush(i);
+	}
 }
 
 bool AbilitySystem::activateAbility(Entity* entity, AbilityType type) {
+	const size_t index = abilityIndex(type);
+	if (!payCost(entity, s_abilities[index])) {
+		return false;
+	}
+
+	// 单次施放按只有一个施法者的批次执行
+	flush(index);
+	m_batches[index][0] = entity;
+	m_batchSizes[index] = 1;
+	flush(index);
+	return m_results[0];
+}
+
+bool AbilitySystem::payCost(Entity* entity, const AbilityDef& ability)
+{
 	if(!entity) {
 		Logger::instance()->log("无法激活能力，实体为空", Logger::LogLevel::ERROR);
 		return false;
@@ -69,116 +129,55 @@ bool AbilitySystem::activateAbility(Entity* entity, AbilityType type) {
 	}
 
 	// 检查能量是否足够
-	float cost = ABILITY_COST.at(type);
-
-	if (energy->current < cost) {
+	if (energy->current < ability.cost) {
 		Logger::instance()->log("暗能量不足，无法使用能力", Logger::LogLevel::INFO);
 		return false;
 	}
 
 	// 消耗能量
-	energy->current -= cost;
-
-	// 是否应用能力成功
-	bool isSuccess = false;
-
-	// 应用能力效果
-	switch (type) {
-	case AbilityType::Perception: isSuccess = applyPerception(entity); break;
-	case AbilityType::Manipulation: isSuccess = applyManipulation(entity); break;
-	case AbilityType::Distortion: isSuccess = applyDistortion(entity); break;
-	case AbilityType::Assimilation: isSuccess = applyAssimilation(entity); break;
-	case AbilityType::Purification: isSuccess = applyPurification(entity); break;
-	}
-
-	if (isSuccess)
-	{
-		// 增加腐蚀度
-		float corruptionIncrease = cost * CORRUPTION_PER_ENERGY;
-		corruption->current += corruptionIncrease;
+	energy->current -= ability.cost;
+	return true;
+}
 
-		Logger::instance()->log("能力激活: " + std::to_string(static_cast<int>(type)) +
-			" 消耗: " + std::to_string(cost) +
-			" 腐蚀度增加：" + std::to_string(corruptionIncrease) +
-			" 当前腐蚀度: " + std::to_string(corruption->current));
+void AbilitySystem::flush(size_t index)
+{
+	const int count = m_batchSizes[index];
+	if (count == 0) return;
+	m_batchSizes[index] = 0;
+
+	const AbilityDef& ability = s_abilities[index];
+	const EffectProgram* program = m_pEffects ? m_pEffects->get(m_programs[index]) : nullptr;
+	if (program) {
+		// 每种能力使用独立的修正来源，重复施放只刷新自己的修正
+		m_vm.run(*program, m_batches[index], count, StatModifiers::SourceAbility + static_cast<uint32_t>(index), m_results);
 	}
-	else
-	{
-		Logger::instance()->log("能力激活失败: " + abilityTypeToString(type), Logger::LogLevel::ERROR);	
+	else {
+		std::fill(m_results, m_results + count, false);
 	}
 
-	return isSuccess;
-}
-
-bool AbilitySystem::applyPerception(Entity* entity)
-{
-	Logger::instance()->log("感知能力激活，显示隐藏元素");
-	return true; // 假设感知能力总是成功
+	for (int c = 0; c < count; ++c) {
+		finishCast(m_batches[index][c], ability, m_results[c]);
+	}
 }
 
-bool AbilitySystem::applyDistortion(Entity* entity)
+void AbilitySystem::finishCast(Entity* entity, const AbilityDef& ability, bool success)
 {
-	auto* transform = entity->getComponent<Transform>();
-	if (!transform) return false;
-
-	// 反转重力方向
-	transform->gravityDirection *= -1.0f;
-
-	Logger::instance()->log("重力扭曲激活，新重力方向: (" +
-		std::to_string(transform->gravityDirection.x) + ", " +
-		std::to_string(transform->gravityDirection.y) + ", " +
-		std::to_string(transform->gravityDirection.z) + ")");
-
-	// 增加额外腐蚀度作为代价
-	if (auto* corruption = entity->getComponent<Corruption>()) {
-		corruption->current += 5.0f;
+	if (!success) {
+		Logger::instance()->log("能力激活失败: " + std::string(ability.name), Logger::LogLevel::ERROR);
+		return;
 	}
-	return true;
-}
 
-bool AbilitySystem::applyManipulation(Entity* entity)
-{
-	Logger::instance()->log("操控能力激活，移动物体");
-	return true; // 假设操控能力总是成功
-}
+	if (auto* cooldown = entity->getComponent<Cooldown>()) {
+		cooldown->setCooldown(ability.type, m_time, ability.cooldown);
+	}
 
-bool AbilitySystem::applyPurification(Entity* entity) {
+	// 增加腐蚀度
 	auto* corruption = entity->getComponent<Corruption>();
-	if (!corruption) return false;
-
-	// 减少腐蚀度
-	corruption->current -= 15.0f;
-	if (corruption->current < 0.0f) corruption->current = 0.0f;
-
-	Logger::instance()->log("净化能力激活，当前腐蚀度: " + std::to_string(corruption->current));
-	return true;
-}
+	float corruptionIncrease = ability.cost * ability.corruptionFactor;
+	corruption->add(corruptionIncrease);
 
-bool AbilitySystem::applyAssimilation(Entity* entity) {
-	Logger::instance()->log("同化能力激活，控制敌人");
-	return true; // 假设同化能力总是成功
+	Logger::instance()->log("能力激活: " + std::string(ability.name) +
+		" 消耗: " + std::to_string(ability.cost) +
+		" 腐蚀度增加：" + std::to_string(corruptionIncrease) +
+		" 当前腐蚀度: " + std::to_string(corruption->getCurrent()));
 }
-
-std::string AbilitySystem::abilityTypeToString(AbilityType type) const
-{
-	switch (type) {
-	case AbilityType::Perception: return "感知";
-	case AbilityType::Manipulation: return "操控";
-	case AbilityType::Distortion: return "扭曲";
-	case AbilityType::Assimilation: return "同化";
-	case AbilityType::Purification: return "净化";
-	default: return "未知";
-	}
-}
-
-float AbilitySystem::getCooldownDuration(AbilityType type) const
-{
-	switch (type) {
-	case AbilityType::Perception: return 2.0f;
-	case AbilityType::Manipulation: return 3.0f;
-	case AbilityType::Distortion: return 5.0f;
-	case AbilityType::Assimilation: return 8.0f;
-	case AbilityType::Purification: return 10.0f;
-	default: return 0.0f;
-	}
-}
\ No newline at end of file
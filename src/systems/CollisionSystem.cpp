@@ -0,0 +1,433 @@
+#include "systems/CollisionSystem.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "components/Transform.h"
+#include "components/Velocity.h"
+#include "components/Collider.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// @brief 位置修正迭代次数
+const int SOLVER_ITERATIONS = 4;
+
+/// @brief 休眠参数
+/// @details 速度和位置修正都低于阈值并持续 SLEEP_TIME 秒后进入休眠
+const float SLEEP_SPEED = 0.05f;
+const float SLEEP_CORRECTION = 0.001f;
+const float SLEEP_TIME = 0.5f;
+
+/// @brief 唤醒参数
+/// @details 休眠实体的速度、被挤压的深度或离入睡时位置的距离超过阈值时唤醒；
+/// 静态网格中的位置与实际位置的误差不超过 WAKE_DISTANCE
+const float WAKE_SPEED = 0.1f;
+const float WAKE_PENETRATION = 0.01f;
+const float WAKE_DISTANCE = 0.05f;
+
+void CollisionSystem::update(World& world, float deltaTime)
+{
+	addNewBodies(world);
+	updateBodyLists();
+	if (m_staticDirty) rebuildStatic();
+	gatherAwake();
+
+	// 休眠实体之间不生成配对，没有清醒实体时无事可做
+	const int count = static_cast<int>(m_transforms.size());
+	if (count == m_staticCount) return;
+
+	buildGrid(m_dynamicGrid, m_staticCount, count);
+	findContacts();
+	solveContacts();
+	updateSleeping(deltaTime);
+
+	// 写回被推开的实体位置：本帧的清醒实体和被挤压唤醒的休眠实体
+	for (int i = m_staticCount; i < count; ++i) {
+		if (m_correction[i] > 0.0f) {
+			m_transforms[i]->position = glm::vec3(m_x[i], m_y[i], m_z[i]);
+		}
+	}
+	for (int i : m_woken) {
+		if (m_correction[i] > 0.0f) {
+			m_transforms[i]->position = glm::vec3(m_x[i], m_y[i], m_z[i]);
+		}
+		m_correction[i] = 0.0f;
+	}
+	m_woken.clear();
+}
+
+void CollisionSystem::removeEntity(int entity)
+{
+	auto it = m_bodyOfEntity.find(entity);
+	if (it == m_bodyOfEntity.end()) return;
+
+	// 表项等下次整理列表时释放，避免列表中残留的下标指向复用后的表项
+	Body& body = m_bodies[it->second];
+	if (body.collider->sleeping) m_staticDirty = true;
+	body.transform = nullptr;
+	body.velocity = nullptr;
+	body.collider = nullptr;
+	m_bodyOfEntity.erase(it);
+}
+
+void CollisionSystem::addNewBodies(World& world)
+{
+	const auto& entities = world.getEntities();
+	size_t first = entities.size();
+	while (first > 0 && entities[first - 1]->getId() > m_lastEntityId) --first;
+	if (first == entities.size()) return;
+
+	for (size_t i = first; i < entities.size(); ++i) {
+		Entity* entity = entities[i].get();
+		auto* collider = entity->getComponent<Collider>();
+		if (!collider) continue;
+		auto* transform = entity->getComponent<Transform>();
+		if (!transform) continue;
+
+		int body;
+		if (m_freeBodies.empty()) {
+			body = static_cast<int>(m_bodies.size());
+			m_bodies.emplace_back();
+		}
+		else {
+			body = m_freeBodies.back();
+			m_freeBodies.pop_back();
+		}
+		m_bodies[body] = Body{ transform, entity->getComponent<Velocity>(), collider };
+		m_bodyOfEntity[entity->getId()] = body;
+
+		if (collider->sleeping) {
+			m_sleepingBodies.push_back(body);
+			m_staticDirty = true;
+		}
+		else {
+			m_awakeBodies.push_back(body);
+		}
+	}
+	m_lastEntityId = entities.back()->getId();
+}
+
+void CollisionSystem::updateBodyLists()
+{
+	// 1. 上一帧入睡的实体移入休眠列表，已销毁的表项释放
+	size_t kept = 0;
+	for (int body : m_awakeBodies) {
+		const Body& entry = m_bodies[body];
+		if (!entry.transform) {
+			releaseBody(body);
+		}
+		else if (entry.collider->sleeping) {
+			m_sleepingBodies.push_back(body);
+			m_staticDirty = true;
+		}
+		else {
+			m_awakeBodies[kept++] = body;
+		}
+	}
+	m_awakeBodies.resize(kept);
+
+	// 2. 开始移动或被其他系统移动过的休眠实体立即唤醒
+	for (size_t k = 0; k < m_sleepingBodies.size(); ++k) {
+		const Body& entry = m_bodies[m_sleepingBodies[k]];
+		if (!entry.transform || !entry.collider->sleeping) {
+			m_staticDirty = true;
+			continue;
+		}
+
+		bool wake = entry.velocity && glm::dot(entry.velocity->linear, entry.velocity->linear) > WAKE_SPEED * WAKE_SPEED;
+		if (k < static_cast<size_t>(m_staticCount)) {
+			const glm::vec3 moved = entry.transform->position - glm::vec3(m_x[k], m_y[k], m_z[k]);
+			wake = wake || glm::dot(moved, moved) > WAKE_DISTANCE * WAKE_DISTANCE;
+		}
+		if (wake) {
+			entry.collider->sleeping = false;
+			entry.collider->sleepTimer = 0.0f;
+			m_staticDirty = true;
+		}
+	}
+}
+
+void CollisionSystem::rebuildStatic()
+{
+	// 被唤醒的表项移回清醒列表，已销毁的表项释放
+	size_t kept = 0;
+	for (int body : m_sleepingBodies) {
+		const Body& entry = m_bodies[body];
+		if (!entry.transform) {
+			releaseBody(body);
+		}
+		else if (!entry.collider->sleeping) {
+			m_awakeBodies.push_back(body);
+		}
+		else {
+			m_sleepingBodies[kept++] = body;
+		}
+	}
+	m_sleepingBodies.resize(kept);
+
+	m_transforms.clear();
+	m_velocities.clear();
+	m_colliders.clear();
+	m_x.clear(); m_y.clear(); m_z.clear();
+	m_radius.clear();
+	m_segment.clear();
+	m_inverseMass.clear();
+	m_awake.clear();
+	for (int body : m_sleepingBodies) {
+		const Body& entry = m_bodies[body];
+		const Collider& collider = *entry.collider;
+		m_transforms.push_back(entry.transform);
+		m_velocities.push_back(entry.velocity);
+		m_colliders.push_back(entry.collider);
+		m_x.push_back(entry.transform->position.x);
+		m_y.push_back(entry.transform->position.y);
+		m_z.push_back(entry.transform->position.z);
+		m_radius.push_back(collider.radius);
+		m_segment.push_back(std::max(0.0f, collider.height - 2.0f * collider.radius));
+		m_inverseMass.push_back(0.0f);
+		m_awake.push_back(0);
+	}
+	m_staticCount = static_cast<int>(m_sleepingBodies.size());
+	m_correction.assign(m_staticCount, 0.0f);
+	m_cellX.resize(m_staticCount);
+	m_cellZ.resize(m_staticCount);
+	buildGrid(m_staticGrid, 0, m_staticCount);
+	m_staticDirty = false;
+}
+
+void CollisionSystem::gatherAwake()
+{
+	const size_t size = static_cast<size_t>(m_staticCount);
+	m_transforms.resize(size);
+	m_velocities.resize(size);
+	m_colliders.resize(size);
+	m_x.resize(size); m_y.resize(size); m_z.resize(size);
+	m_radius.resize(size);
+	m_segment.resize(size);
+	m_inverseMass.resize(size);
+	m_awake.resize(size);
+
+	for (int body : m_awakeBodies) {
+		const Body& entry = m_bodies[body];
+		const Collider& collider = *entry.collider;
+		m_transforms.push_back(entry.transform);
+		m_velocities.push_back(entry.velocity);
+		m_colliders.push_back(entry.collider);
+		m_x.push_back(entry.transform->position.x);
+		m_y.push_back(entry.transform->position.y);
+		m_z.push_back(entry.transform->position.z);
+		m_radius.push_back(collider.radius);
+		m_segment.push_back(std::max(0.0f, collider.height - 2.0f * collider.radius));
+		m_inverseMass.push_back(collider.inverseMass);
+		m_awake.push_back(1);
+	}
+	m_correction.resize(m_transforms.size());
+	std::fill(m_correction.begin() + size, m_correction.end(), 0.0f);
+}
+
+void CollisionSystem::buildGrid(Grid& grid, int begin, int end)
+{
+	const int count = end - begin;
+	m_cellX.resize(end);
+	m_cellZ.resize(end);
+	grid.maxRadius = count > 0 ? *std::max_element(m_radius.begin() + begin, m_radius.begin() + end) : 0.0f;
+
+	// 网格边长取最大直径，保证同一网格中重叠的两个碰撞体一定位于相邻格子
+	grid.cellSize = std::max(2.0f * grid.maxRadius, 0.01f);
+	const float invCellSize = 1.0f / grid.cellSize;
+
+	uint32_t bucketCount = 64;
+	while (bucketCount < static_cast<uint32_t>(count) * 2) bucketCount <<= 1;
+	grid.bucketMask = bucketCount - 1;
+
+	grid.bucketStart.assign(bucketCount + 1, 0);
+	for (int i = begin; i < end; ++i) {
+		m_cellX[i] = static_cast<int>(std::floor(m_x[i] * invCellSize));
+		m_cellZ[i] = static_cast<int>(std::floor(m_z[i] * invCellSize));
+		++grid.bucketStart[bucketOf(grid, m_cellX[i], m_cellZ[i]) + 1];
+	}
+	for (uint32_t b = 0; b < bucketCount; ++b) {
+		grid.bucketStart[b + 1] += grid.bucketStart[b];
+	}
+
+	grid.sorted.resize(count);
+	m_cursor.assign(grid.bucketStart.begin(), grid.bucketStart.end() - 1);
+	for (int i = begin; i < end; ++i) {
+		grid.sorted[m_cursor[bucketOf(grid, m_cellX[i], m_cellZ[i])]++] = i;
+	}
+}
+
+void CollisionSystem::releaseBody(int body)
+{
+	m_bodies[body] = Body{ nullptr, nullptr, nullptr };
+	m_freeBodies.push_back(body);
+}
+
+void CollisionSystem::findContacts()
+{
+	m_contacts.clear();
+	const int count = static_cast<int>(m_transforms.size());
+	const float invStaticCellSize = 1.0f / m_staticGrid.cellSize;
+
+	// 休眠实体只作为被动方参与，只需从每个清醒实体出发查找
+	for (int i = m_staticCount; i < count; ++i) {
+		// 1. 清醒实体之间：相邻格子，每个配对只记录一次
+		for (int dz = -1; dz <= 1; ++dz) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				const int cx = m_cellX[i] + dx;
+				const int cz = m_cellZ[i] + dz;
+				const int bucket = bucketOf(m_dynamicGrid, cx, cz);
+				for (int s = m_dynamicGrid.bucketStart[bucket]; s < m_dynamicGrid.bucketStart[bucket + 1]; ++s) {
+					const int j = m_dynamicGrid.sorted[s];
+					if (j <= i || m_cellX[j] != cx || m_cellZ[j] != cz) continue;
+
+					float ox = m_x[j] - m_x[i];
+					float oz = m_z[j] - m_z[i];
+					float reach = m_radius[i] + m_radius[j];
+					if (ox * ox + oz * oz < reach * reach) {
+						m_contacts.push_back({ i, j });
+					}
+				}
+			}
+		}
+
+		// 2. 清醒实体与休眠实体：静态网格的边长按休眠实体确定，按可能接触的范围查找格子
+		if (m_staticCount == 0) continue;
+		const float range = m_radius[i] + m_staticGrid.maxRadius;
+		const int x0 = static_cast<int>(std::floor((m_x[i] - range) * invStaticCellSize));
+		const int x1 = static_cast<int>(std::floor((m_x[i] + range) * invStaticCellSize));
+		const int z0 = static_cast<int>(std::floor((m_z[i] - range) * invStaticCellSize));
+		const int z1 = static_cast<int>(std::floor((m_z[i] + range) * invStaticCellSize));
+		for (int cz = z0; cz <= z1; ++cz) {
+			for (int cx = x0; cx <= x1; ++cx) {
+				const int bucket = bucketOf(m_staticGrid, cx, cz);
+				for (int s = m_staticGrid.bucketStart[bucket]; s < m_staticGrid.bucketStart[bucket + 1]; ++s) {
+					const int j = m_staticGrid.sorted[s];
+					if (m_cellX[j] != cx || m_cellZ[j] != cz) continue;
+
+					float ox = m_x[j] - m_x[i];
+					float oz = m_z[j] - m_z[i];
+					float reach = m_radius[i] + m_radius[j];
+					if (ox * ox + oz * oz < reach * reach) {
+						m_contacts.push_back({ i, j });
+					}
+				}
+			}
+		}
+	}
+}
+
+void CollisionSystem::solveContacts()
+{
+	for (int iteration = 0; iteration < SOLVER_ITERATIONS; ++iteration) {
+		for (const Contact& contact : m_contacts) {
+			const int a = contact.a;
+			const int b = contact.b;
+
+			float nx, ny, nz;
+			float depth = penetration(a, b, nx, ny, nz);
+			if (depth <= 0.0f) continue;
+
+			// 被明显挤压的休眠实体需要唤醒
+			if (!m_awake[b] && depth > WAKE_PENETRATION) {
+				m_awake[b] = 1;
+				m_inverseMass[b] = m_colliders[b]->inverseMass;
+				m_colliders[b]->sleeping = false;
+				m_colliders[b]->sleepTimer = 0.0f;
+				m_woken.push_back(b);
+				m_staticDirty = true;
+			}
+
+			const float wa = m_inverseMass[a];
+			const float wb = m_inverseMass[b];
+			const float w = wa + wb;
+			if (w <= 0.0f) continue;
+
+			const float pushA = depth * wa / w;
+			const float pushB = depth * wb / w;
+			m_x[a] -= nx * pushA; m_y[a] -= ny * pushA; m_z[a] -= nz * pushA;
+			m_x[b] += nx * pushB; m_y[b] += ny * pushB; m_z[b] += nz * pushB;
+			m_correction[a] += pushA;
+			m_correction[b] += pushB;
+		}
+	}
+}
+
+void CollisionSystem::updateSleeping(float deltaTime)
+{
+	// 清醒实体为数据数组后部本帧收集的实体，加上被挤压唤醒的休眠实体
+	const int begin = m_staticCount;
+	const int count = static_cast<int>(m_transforms.size());
+	auto forEachAwake = [&](auto&& fn) {
+		for (int i = begin; i < count; ++i) fn(i);
+		for (int i : m_woken) fn(i);
+	};
+
+	// 1. 更新每个清醒实体的静止时间
+	forEachAwake([&](int i) {
+		Velocity* velocity = m_velocities[i];
+		bool still = (!velocity || glm::dot(velocity->linear, velocity->linear) < SLEEP_SPEED * SLEEP_SPEED)
+			&& m_correction[i] < SLEEP_CORRECTION;
+		m_colliders[i]->sleepTimer = still ? m_colliders[i]->sleepTimer + deltaTime : 0.0f;
+	});
+
+	// 2. 按清醒实体之间的接触合并成岛
+	m_islandParent.resize(count);
+	forEachAwake([&](int i) { m_islandParent[i] = i; });
+	for (const Contact& contact : m_contacts) {
+		if (!m_awake[contact.b]) continue;
+		int ra = findIsland(contact.a);
+		int rb = findIsland(contact.b);
+		if (ra != rb) m_islandParent[ra] = rb;
+	}
+
+	// 3. 每座岛取最短静止时间，整座岛都静止足够久才休眠，下一帧移入休眠列表
+	m_islandTimer.resize(count);
+	forEachAwake([&](int i) { m_islandTimer[i] = SLEEP_TIME; });
+	forEachAwake([&](int i) {
+		int root = findIsland(i);
+		m_islandTimer[root] = std::min(m_islandTimer[root], m_colliders[i]->sleepTimer);
+	});
+	forEachAwake([&](int i) {
+		if (m_islandTimer[findIsland(i)] >= SLEEP_TIME) {
+			m_colliders[i]->sleeping = true;
+		}
+	});
+}
+
+float CollisionSystem::penetration(int a, int b, float& nx, float& ny, float& nz) const
+{
+	// 胶囊中心线在Y方向的区间
+	const float a0 = m_y[a] + m_radius[a], a1 = a0 + m_segment[a];
+	const float b0 = m_y[b] + m_radius[b], b1 = b0 + m_segment[b];
+	float dy = 0.0f;
+	if (b1 < a0) dy = b1 - a0;
+	else if (b0 > a1) dy = b0 - a1;
+
+	const float dx = m_x[b] - m_x[a];
+	const float dz = m_z[b] - m_z[a];
+	const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+	const float depth = m_radius[a] + m_radius[b] - distance;
+	if (depth <= 0.0f) return depth;
+
+	// 角色贴地移动，只在XZ平面上推开
+	const float planar = std::sqrt(dx * dx + dz * dz);
+	if (planar > 1e-5f) {
+		nx = dx / planar;
+		nz = dz / planar;
+	}
+	else {
+		nx = 1.0f;	// 完全重合时任选一个方向
+		nz = 0.0f;
+	}
+	ny = 0.0f;
+	return depth;
+}
+
+int CollisionSystem::findIsland(int i)
+{
+	while (m_islandParent[i] != i) {
+		m_islandParent[i] = m_islandParent[m_islandParent[i]];	// 路径压缩
+		i = m_islandParent[i];
+	}
+	return i;
+}
@@ -1,16 +1,23 @@
 #include "systems/CombatSystem.h"
 #include "ecs/World.h"
 #include "ecs/Entity.h"
-#include "components/Health.h"
 #include "components/Attack.h"
 #include "components/CombatInput.h"
 #include "components/Transform.h"
 #include "components/SpatialDistortion.h"
-#include "core/Logger.h"
+#include "combat/DamageQueue.h"
+#include "spatial/SpatialIndex.h"
 
 #include <glm/glm.hpp>
 
+CombatSystem::CombatSystem(const SpatialIndex* spatialIndex, DamageQueue* damageQueue)
+	: m_pSpatialIndex(spatialIndex), m_pDamageQueue(damageQueue)
+{
+}
+
 void CombatSystem::update(World& world, float deltaTime) {
+	if (!m_pDamageQueue) return;
+
 	// 处理所有攻击
 	for (auto& attacker : world.getEntities()) {
 		if (!attacker) continue; // 跳过无效实体
@@ -37,53 +44,29 @@ void CombatSystem::update(World& world, float deltaTime) {
 			}
 		}
 	}
+
+	// 统一结算本帧所有伤害（包括其他系统追加的）
+	m_pDamageQueue->resolve(world);
 }
 
 void CombatSystem::applyDamage(Entity* attacker, Entity* target, float damage) {
 	if (!attacker || !target) return;
 
-	auto* health = target->getComponent<Health>();
-	if (!health) return;
-
-	health->current -= damage;
-
-	Logger::instance()->log("攻击者: " + std::to_string(attacker->getId()) +
-		" 攻击目标: " + std::to_string(target->getId()) +
-		" 造成伤害: " + std::to_string(damage) +
-		" 当前生命值: " + std::to_string(health->current));
-	if (health->current <= 0.0f) {
-		health->current = 0.0f;
-		Logger::instance()->log("实体被击败");
-		target->getWorld().markEntityForDestruction(*target);
-	}
+	m_pDamageQueue->push(attacker->getId(), target->getId(), damage, DamageType::Physical);
 }
 
 void CombatSystem::applyAreaDamage(Entity* source, float radius, float damage) {
-	if (!source) return;
+	if (!source || !m_pSpatialIndex) return;
 
 	auto* sourceTransform = source->getComponent<Transform>();
 	if (!sourceTransform) return;
 
-	// 在实际游戏中，这里会使用空间分区数据结构优化
-	for (auto& entity : source->getWorld().getEntities()) {
-		if (entity.get() == source) continue; // 跳过自己
-
-		auto* health = entity->getComponent<Health>();
-		auto* transform = entity->getComponent<Transform>();
-
-		if (!health || !transform) continue;
-
-		float distance = glm::distance(sourceTransform->position, transform->position);
-		if (distance <= radius) {
-			health->current -= damage;
-			Logger::instance()->log("空间扭曲造成伤害: " + std::to_string(damage));
-		}
-
-		if (health->current <= 0.0f) {
-			health->current = 0.0f;
-			Logger::instance()->log("实体被击败");
-			entity->getWorld().markEntityForDestruction(*entity);
-			// 在实际游戏中，这里会触发死亡动画和实体移除
-		}
-	}
-}
\ No newline at end of file
+	// 只遍历半径覆盖的网格，没有生命值的实体在结算时忽略
+	SpatialIndex::Filter filter;
+	filter.exclude = source;
+	const int sourceId = source->getId();
+	m_pSpatialIndex->forEachInRadius(sourceTransform->position, radius, filter,
+		[&](const SpatialIndex::Entry& entry, float) {
+			m_pDamageQueue->push(sourceId, entry.entity->getId(), damage, DamageType::Rift);
+		});
+}
@@ -4,36 +4,90 @@
 #include "components/Corruption.h"
 #include "components/DarkEnergy.h"
 #include "components/Health.h"
+#include "components/StatModifiers.h"
 #include "core/Logger.h"
+#include "core/Simd.h"
+
+#include <algorithm>
 
 /// @brief 腐蚀系统更新间隔时间
 /// @details 此常量定义了腐蚀系统的更新频率，单位为秒。
 const float EFFECT_INTERVAL = 1.0f;
 
+/// @brief 各阶段效果参数
+/// @details 高腐蚀和临界阶段每次结算流失的基础最大生命值比例，
+/// 以及中、高阶段随腐蚀度线性增加的属性降幅上限（临界阶段取满额）
+const float HIGH_HEALTH_DRAIN = 0.01f;
+const float CRITICAL_HEALTH_DRAIN = 0.1f;
+const float MEDIUM_MAX_HEALTH_REDUCTION = 0.1f;
+const float HIGH_MAX_HEALTH_REDUCTION = 0.3f;
+const float RECOVERY_REDUCTION = 0.3f;
+
+/// @brief 能力失控效果
+/// @details 中腐蚀阶段每次结算累计的时间和触发间隔
+const float LOSS_OF_CONTROL_STEP = 0.1f;
+const float LOSS_OF_CONTROL_INTERVAL = 5.0f;
+
 void CorruptionSystem::update(World& world, float deltaTime) {
-	for (auto& entity : world.getEntities()) {
-		if (auto* corruption = entity->getComponent<Corruption>()) {
-			// 更新阶段并检查变化
-			if (corruption->updateStage()) {
-				onStageChanged(entity.get(), corruption->stage);
-			}
+	refreshMembers(world);
 
-			if(corruption->effectTimer.elapsed() >= EFFECT_INTERVAL) {
-				corruption->effectTimer.restart(); // 重置计时器
-				// 更新腐蚀效果
-				updateCorruptionEffects(entity.get(), deltaTime);
-			}
-		}
+	// 处理上次以来腐蚀度写入产生的阶段变化
+	for (const Corruption::StageChanged& event : m_stageEvents.getEvents()) {
+		onStageChanged(event);
 	}
+	m_stageEvents.clear();
+
+	m_effectTimer += deltaTime;
+	if (m_effectTimer < EFFECT_INTERVAL || m_entities.empty()) return;
+	m_effectTimer = 0.0f; // 重置计时器
+
+	gather();
+	runKernel();
+	scatter();
 }
 
-void CorruptionSystem::onStageChanged(Entity* entity, Corruption::Stage newStage)
+void CorruptionSystem::refreshMembers(World& world)
 {
-	auto* corruption = entity->getComponent<Corruption>();
-	if (!corruption) return;
+	const auto& entities = world.getEntities();
+	const int lastId = entities.empty() ? -1 : entities.back()->getId();
+	if (entities.size() == m_worldEntityCount && lastId == m_lastEntityId) return;
+	m_worldEntityCount = entities.size();
+	m_lastEntityId = lastId;
+
+	m_entities.clear();
+	m_corruptions.clear();
+	m_healths.clear();
+	m_modifiers.clear();
+	for (auto& entity : entities) {
+		auto* corruption = entity->getComponent<Corruption>();
+		if (!corruption) continue;
+
+		// 新成员绑定到阶段事件队列，已绑定的不会重复补发
+		corruption->bind(entity->getId(), &m_stageEvents);
+
+		auto* health = entity->getComponent<Health>();
+		const bool hasVitals = health && entity->getComponent<DarkEnergy>();
+		m_entities.push_back(entity.get());
+		m_corruptions.push_back(corruption);
+		m_healths.push_back(hasVitals ? health : nullptr);
+		m_modifiers.push_back(entity->getComponent<StatModifiers>());
+	}
+
+	// 结算数组补齐到4的倍数，补齐部分保持为无腐蚀的空数据
+	const size_t padded = (m_entities.size() + 3) & ~static_cast<size_t>(3);
+	for (auto* array : { &m_corruption, &m_lowThreshold, &m_mediumThreshold, &m_highThreshold, &m_health,
+		&m_baseMaxHealth, &m_hasVitals, &m_stage, &m_maxHealthScale, &m_recoveryScale }) {
+		array->assign(padded, 0.0f);
+	}
+	m_appliedHealthScale.assign(padded, -1.0f);
+	m_appliedRecoveryScale.assign(padded, -1.0f);
+	m_changed.assign(padded / 4, 0);
+}
 
+void CorruptionSystem::onStageChanged(const Corruption::StageChanged& event)
+{
 	std::string stageName;
-	switch (newStage) {
+	switch (event.to) {
 	case Corruption::None: stageName = "无腐蚀"; break;
 	case Corruption::Low: stageName = "低腐蚀"; break;
 	case Corruption::Medium: stageName = "中腐蚀"; break;
@@ -41,136 +95,137 @@ void CorruptionSystem::onStageChanged(Entity* entity, Corruption::Stage newStage
 	case Corruption::Critical: stageName = "临界腐蚀"; break;
 	}
 
-	Logger::instance()->log("实体 " + std::to_string(entity->getId()) + " 进入 " + stageName + " 阶段", Logger::LogLevel::INFO);
+	Logger::instance()->log("实体 " + std::to_string(event.entity) + " 进入 " + stageName + " 阶段", Logger::LogLevel::INFO);
 }
 
-void CorruptionSystem::updateCorruptionEffects(Entity* entity, float deltaTime) {
-	auto* corruption = entity->getComponent<Corruption>();
-
-	// 根据腐蚀度应用不同效果
-	switch (corruption->getStage()) {
-	case Corruption::Low:
-		applyLowCorruptionEffects(entity);
-		break;
-	case Corruption::Medium:
-		applyMediumCorruptionEffects(entity);
-		break;
-	case Corruption::High:
-		applyHighCorruptionEffects(entity);
-		break;
-	case Corruption::Critical:
-		applyCriticalCorruptionEffects(entity);
-		break;
-	default:
-		// 无腐蚀阶段，不应用任何效果
-		break;
+void CorruptionSystem::gather()
+{
+	for (size_t i = 0; i < m_entities.size(); ++i) {
+		const Corruption* corruption = m_corruptions[i];
+		const Health* health = m_healths[i];
+		m_corruption[i] = corruption->getCurrent();
+		m_lowThreshold[i] = corruption->getLowThreshold();
+		m_mediumThreshold[i] = corruption->getMediumThreshold();
+		m_highThreshold[i] = corruption->getHighThreshold();
+		m_health[i] = health ? health->getCurrent() : 0.0f;
+		m_baseMaxHealth[i] = health ? health->getBaseMax() : 0.0f;
+		m_hasVitals[i] = health ? 1.0f : 0.0f;
 	}
 }
 
-void CorruptionSystem::applyLowCorruptionEffects(Entity* entity) {
-	auto* corruption = entity->getComponent<Corruption>();
-
-	// 低腐蚀效果：轻微视觉扭曲
-	// 在实际游戏中，这里会设置着色器参数
+void CorruptionSystem::runKernel()
+{
+	const simd::float4 zero(0.0f);
+	const simd::float4 one(1.0f);
+	const simd::float4 highDrain(HIGH_HEALTH_DRAIN);
+	const simd::float4 criticalDrain(CRITICAL_HEALTH_DRAIN);
+	const simd::float4 mediumHealthReduction(MEDIUM_MAX_HEALTH_REDUCTION);
+	const simd::float4 highHealthReduction(HIGH_MAX_HEALTH_REDUCTION);
+	const simd::float4 recoveryReduction(RECOVERY_REDUCTION);
+	const simd::float4 criticalHealthScale(1.0f - HIGH_MAX_HEALTH_REDUCTION);
+	const simd::float4 criticalRecoveryScale(1.0f - RECOVERY_REDUCTION);
+
+	m_mediumCount = 0;
+	const size_t padded = m_corruption.size();
+	for (size_t i = 0; i < padded; i += 4) {
+		const simd::float4 corruption = simd::load(&m_corruption[i]);
+		const simd::float4 low = simd::load(&m_lowThreshold[i]);
+		const simd::float4 medium = simd::load(&m_mediumThreshold[i]);
+		const simd::float4 high = simd::load(&m_highThreshold[i]);
+
+		// 1. 阶段 = 越过的阈值数，与 Corruption::stageOf 的划分一致
+		const simd::float4 aboveNone = simd::cmpgt(corruption, zero);
+		const simd::float4 aboveLow = simd::cmpge(corruption, low);
+		const simd::float4 aboveMedium = simd::cmpge(corruption, medium);
+		const simd::float4 aboveHigh = simd::cmpge(corruption, high);
+		simd::store(&m_stage[i], (aboveNone & one) + (aboveLow & one) + (aboveMedium & one) + (aboveHigh & one));
+
+		// 2. 高腐蚀和临界阶段流失生命值
+		const simd::float4 drain = simd::select(aboveHigh, criticalDrain, simd::select(aboveMedium, highDrain, zero));
+		const simd::float4 vitals = simd::cmpgt(simd::load(&m_hasVitals[i]), zero);
+		simd::store(&m_health[i], simd::load(&m_health[i]) - simd::load(&m_baseMaxHealth[i]) * (vitals & drain));
+
+		// 3. 中、高阶段的降幅随腐蚀度在阶段内的位置线性增加
+		const simd::float4 mediumRatio = simd::min(simd::max((corruption - low) / (medium - low), zero), one);
+		const simd::float4 highRatio = simd::min(simd::max((corruption - medium) / (high - medium), zero), one);
+		const simd::float4 ratio = simd::select(aboveMedium, highRatio, mediumRatio);
+		const simd::float4 healthReduction = simd::select(aboveMedium, highHealthReduction, mediumHealthReduction);
+
+		// 低于中腐蚀阶段或缺少生命值、暗能量时系数为1，对应撤销修正
+		const simd::float4 affected = aboveLow & vitals;
+		const simd::float4 healthScale = simd::select(affected,
+			simd::select(aboveHigh, criticalHealthScale, one - healthReduction * ratio), one);
+		const simd::float4 recoveryScale = simd::select(affected,
+			simd::select(aboveHigh, criticalRecoveryScale, one - recoveryReduction * ratio), one);
+		simd::store(&m_maxHealthScale[i], healthScale);
+		simd::store(&m_recoveryScale[i], recoveryScale);
+
+		// 4. 生命值有流失或系数与上次施加的不同时才需要写回
+		const simd::float4 drained = vitals & simd::cmpgt(drain, zero);
+		const simd::float4 changed = drained |
+			simd::cmpgt(simd::max(healthScale - simd::load(&m_appliedHealthScale[i]), simd::load(&m_appliedHealthScale[i]) - healthScale), zero) |
+			simd::cmpgt(simd::max(recoveryScale - simd::load(&m_appliedRecoveryScale[i]), simd::load(&m_appliedRecoveryScale[i]) - recoveryScale), zero);
+		m_changed[i / 4] = static_cast<uint8_t>(simd::movemask(changed));
+
+		// 5. 统计中腐蚀阶段的实体
+		const int mediumMask = simd::movemask(simd::select(aboveMedium, zero, affected));
+		m_mediumCount += (mediumMask & 1) + ((mediumMask >> 1) & 1) + ((mediumMask >> 2) & 1) + ((mediumMask >> 3) & 1);
+	}
 }
 
-void CorruptionSystem::applyMediumCorruptionEffects(Entity* entity) {
-	auto* corruption = entity->getComponent<Corruption>();
-	auto* health = entity->getComponent<Health>();
-	auto* energy = entity->getComponent<DarkEnergy>();
-
-	// 检查组件是否存在
-	if (!health || !energy) return;
+void CorruptionSystem::scatter()
+{
+	for (size_t block = 0; block < m_changed.size(); ++block) {
+		const int mask = m_changed[block];
+		if (mask == 0) continue;
 
-	// 效果1：随机能力失控
-	static float effectTimer = 0.0f;
-	effectTimer += 0.1f; // 简化计时
+		for (int lane = 0; lane < 4; ++lane) {
+			const size_t i = block * 4 + lane;
+			if (!(mask & (1 << lane)) || i >= m_entities.size()) continue;
 
-	if (effectTimer > 5.0f) { // 每5秒触发一次
-		// 在实际游戏中，这里会随机触发一个能力
-		Logger::instance()->log("腐蚀效应：能力失控", Logger::LogLevel::WARN);
-		effectTimer = 0.0f;
-	}
+			if (Health* health = m_healths[i]) {
+				health->setCurrent(m_health[i]);
+			}
 
-	// 效果2：生命值上限降低（最多降低10%）
-	float maxReduction = 0.1f;
-	float reductionRatio = (corruption->current - corruption->lowThreshold) /
-		(corruption->mediumThreshold - corruption->lowThreshold);
-	health->max = health->baseMax * (1.0f - maxReduction * reductionRatio);
+			if (m_maxHealthScale[i] == m_appliedHealthScale[i] && m_recoveryScale[i] == m_appliedRecoveryScale[i]) continue;
+			m_appliedHealthScale[i] = m_maxHealthScale[i];
+			m_appliedRecoveryScale[i] = m_recoveryScale[i];
 
-	// 如果当前生命值超过上限，调整到上限
-	if (health->current > health->max) {
-		health->current = health->max;
+			// 系数为1时撤销修正，包括降到低腐蚀以下和缺少生命值或暗能量的实体
+			if (m_maxHealthScale[i] == 1.0f && m_recoveryScale[i] == 1.0f) {
+				clearCorruptionModifiers(i);
+			}
+			else {
+				setCorruptionModifiers(i, m_maxHealthScale[i], m_recoveryScale[i]);
+			}
+		}
 	}
 
-	// 效果3：能量恢复速率降低（最多降低30%）
-	float recoveryReduction = 0.3f * reductionRatio;
-	energy->recoveryRate = energy->baseRecoveryRate * (1.0f - recoveryReduction);
+	// 中腐蚀效果：随机能力失控
+	m_lossOfControlTimer += LOSS_OF_CONTROL_STEP * m_mediumCount;
+	if (m_lossOfControlTimer > LOSS_OF_CONTROL_INTERVAL) {
+		// 在实际游戏中，这里会随机触发一个能力
+		Logger::instance()->log("腐蚀效应：能力失控", Logger::LogLevel::WARN);
+		m_lossOfControlTimer = 0.0f;
+	}
 }
 
-void CorruptionSystem::applyHighCorruptionEffects(Entity* entity) {
-	auto* corruption = entity->getComponent<Corruption>();
-	auto* health = entity->getComponent<Health>();
-	auto* energy = entity->getComponent<DarkEnergy>();
-
-	// 检查组件是否存在
-	if (!health || !energy) return;
-
-	// 效果1：生命值快速减少
-	float healthReduction = health->baseMax * 0.01f; // 每秒减少1%的最大生命值
-	health->current -= healthReduction;
-
-	// 生命值上限降低（最多降低30%）
-	float maxReduction = 0.3f;
-	float reductionRatio = (corruption->current - corruption->mediumThreshold) /
-		(corruption->highThreshold - corruption->mediumThreshold);
-	health->max = health->baseMax * (1.0f - maxReduction * reductionRatio);
-
-	// 如果当前生命值超过上限，调整到上限
-	if (health->current > health->max) {
-		health->current = health->max;
+void CorruptionSystem::setCorruptionModifiers(size_t member, float maxHealthScale, float recoveryScale)
+{
+	StatModifiers*& modifiers = m_modifiers[member];
+	if (!modifiers) {
+		modifiers = m_entities[member]->getComponent<StatModifiers>();
+		if (!modifiers) modifiers = &m_entities[member]->addComponent<StatModifiers>();
 	}
 
-	// 效果2：能量恢复速率降低（最多降低30%）
-	float recoveryReduction = 0.3f * reductionRatio;
-	energy->recoveryRate = energy->baseRecoveryRate * (1.0f - recoveryReduction);
-
-	// 效果3：视野严重扭曲
-	// 在实际游戏中，这里会有强烈的视觉效果
-
+	// 数值不变时不会标记脏，属性系统也就不会重算
+	modifiers->set(StatModifiers::MaxHealth, StatModifiers::Multiply, maxHealthScale, StatModifiers::SourceCorruption);
+	modifiers->set(StatModifiers::EnergyRecovery, StatModifiers::Multiply, recoveryScale, StatModifiers::SourceCorruption);
 }
 
-void CorruptionSystem::applyCriticalCorruptionEffects(Entity* entity)
+void CorruptionSystem::clearCorruptionModifiers(size_t member)
 {
-	auto* corruption = entity->getComponent<Corruption>();
-	auto* health = entity->getComponent<Health>();
-	auto* energy = entity->getComponent<DarkEnergy>();
-
-	// 检查组件是否存在
-	if (!health || !energy) return;
-
-	// 效果1：生命值快速减少
-	float healthReduction = health->baseMax * 0.1f; // 每秒减少10%的最大生命值
-	health->current -= healthReduction;
-
-	// 生命值上限降低（最多降低30%）
-	float maxReduction = 0.3f;
-	float reductionRatio = (corruption->current - corruption->mediumThreshold) /
-		(corruption->highThreshold - corruption->mediumThreshold);
-	health->max = health->baseMax * (1.0f - maxReduction * reductionRatio);
-
-	// 如果当前生命值超过上限，调整到上限
-	if (health->current > health->max) {
-		health->current = health->max;
+	if (StatModifiers* modifiers = m_modifiers[member]) {
+		modifiers->removeSource(StatModifiers::SourceCorruption);
 	}
-
-	// 效果3：能量恢复速率降低（最多降低30%）
-	float recoveryReduction = 0.3f * reductionRatio;
-	energy->recoveryRate = energy->baseRecoveryRate * (1.0f - recoveryReduction);
-
-	// 效果3：极端视觉扭曲和音效
-	// 在实际游戏中，这里会有极端的视觉和音效效果
-	
-	// 效果4：随机能力暴走（属性增强、但会有负面效果）
-
 }
@@ -0,0 +1,284 @@
+#include "systems/CrowdSystem.h"
+#include "spatial/SpatialIndex.h"
+#include "core/JobSystem.h"
+#include "core/Simd.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "components/AI.h"
+#include "components/Velocity.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// @brief 每个敌人最多考虑的邻居数（4的倍数）
+const int CROWD_MAX_NEIGHBORS = 8;
+
+/// @brief 邻居查询半径
+const float CROWD_NEIGHBOR_RADIUS = 3.0f;
+
+/// @brief 分离生效的距离
+const float CROWD_SEPARATION_RADIUS = 1.5f;
+
+/// @brief 避让的预测时间和判定为冲突的最近距离
+const float CROWD_AVOID_HORIZON = 1.0f;
+const float CROWD_AVOID_DISTANCE = 1.0f;
+
+/// @brief 各项转向的权重（相对期望速度的大小）
+const float CROWD_SEPARATION_WEIGHT = 1.5f;
+const float CROWD_ALIGNMENT_WEIGHT = 0.3f;
+const float CROWD_AVOID_WEIGHT = 1.0f;
+
+/// @brief 并行分块大小（网格数）
+const int CROWD_GRAIN = 32;
+
+CrowdSystem::CrowdSystem(const SpatialIndex* spatialIndex, JobSystem* jobSystem)
+	: m_pSpatialIndex(spatialIndex), m_pJobSystem(jobSystem)
+{
+}
+
+void CrowdSystem::update(World& world, float deltaTime)
+{
+	if (!m_pSpatialIndex) return;
+
+	// 1. 从空间索引条目收集敌人的期望速度
+	const auto& entries = m_pSpatialIndex->getEntries();
+	m_entryVelX.assign(entries.size(), 0.0f);
+	m_entryVelZ.assign(entries.size(), 0.0f);
+	m_entryVelocities.assign(entries.size(), nullptr);
+	m_order.clear();
+
+	for (size_t e = 0; e < entries.size(); ++e) {
+		const SpatialIndex::Entry& entry = entries[e];
+		if (!(entry.tags & SpatialIndex::TagEnemy)) continue;
+
+		auto* ai = entry.entity->getComponent<AI>();
+		auto* velocity = entry.entity->getComponent<Velocity>();
+		if (!ai || !velocity) continue;
+
+		const glm::vec3& desired = ai->desiredVelocity;
+		m_entryVelX[e] = desired.x;
+		m_entryVelZ[e] = desired.z;
+		m_entryVelocities[e] = velocity;
+		if (desired.x * desired.x + desired.z * desired.z < 1e-4f) continue;	// 静止的敌人只作为邻居
+
+		const uint64_t cellKey = (static_cast<uint64_t>(static_cast<uint32_t>(entry.cellZ)) << 32) | static_cast<uint32_t>(entry.cellX);
+		m_order.push_back({ cellKey, static_cast<int>(e) });
+	}
+
+	// 2. 按网格排序，同一网格的敌人连续存放（哈希桶冲突时条目会交错）
+	std::sort(m_order.begin(), m_order.end());
+
+	const int count = static_cast<int>(m_order.size());
+	if (count == 0) return;
+
+	m_agents.resize(count);
+	m_agentEntries.resize(count);
+	m_velocities.resize(count);
+	m_posX.resize(count); m_posZ.resize(count);
+	m_desiredX.resize(count); m_desiredZ.resize(count);
+	m_cellStarts.clear();
+	for (int i = 0; i < count; ++i) {
+		const int e = m_order[i].second;
+		m_agents[i] = entries[e].entity;
+		m_agentEntries[i] = e;
+		m_velocities[i] = m_entryVelocities[e];
+		m_posX[i] = entries[e].position.x;
+		m_posZ[i] = entries[e].position.z;
+		m_desiredX[i] = m_entryVelX[e];
+		m_desiredZ[i] = m_entryVelZ[e];
+		if (i == 0 || m_order[i].first != m_order[i - 1].first) {
+			m_cellStarts.push_back(i);
+		}
+	}
+	m_cellStarts.push_back(count);
+
+	const size_t slots = static_cast<size_t>(count) * CROWD_MAX_NEIGHBORS;
+	m_nbrX.resize(slots);
+	m_nbrZ.resize(slots);
+	m_nbrVelX.resize(slots);
+	m_nbrVelZ.resize(slots);
+	m_nbrMask.resize(slots);
+
+	// 3. 逐网格查询邻居并计算转向，按块并行
+	auto job = [this](int begin, int end) {
+		NeighborScratch scratch;
+		for (int c = begin; c < end; ++c) {
+			gatherNeighbors(m_cellStarts[c], m_cellStarts[c + 1], scratch);
+			steer(m_cellStarts[c], m_cellStarts[c + 1]);
+		}
+	};
+	const int cells = static_cast<int>(m_cellStarts.size()) - 1;
+	if (m_pJobSystem) {
+		m_pJobSystem->parallelFor(cells, CROWD_GRAIN, job);
+	}
+	else {
+		job(0, cells);
+	}
+
+	// 4. 写回速度
+	for (int i = 0; i < count; ++i) {
+		m_velocities[i]->linear.x = m_desiredX[i];
+		m_velocities[i]->linear.z = m_desiredZ[i];
+	}
+}
+
+void CrowdSystem::gatherNeighbors(int begin, int end, NeighborScratch& scratch)
+{
+	using namespace simd;
+
+	const auto& entries = m_pSpatialIndex->getEntries();
+	const SpatialIndex::Entry& first = entries[m_agentEntries[begin]];
+	const float cellSize = m_pSpatialIndex->getCellSize();
+
+	// 1. 一次查询覆盖整个网格内所有敌人的邻居范围
+	const glm::vec3 center((first.cellX + 0.5f) * cellSize, 0.0f, (first.cellZ + 0.5f) * cellSize);
+	SpatialIndex::Filter filter;
+	filter.requireTags = SpatialIndex::TagEnemy;
+
+	scratch.x.clear();
+	scratch.z.clear();
+	scratch.entries.clear();
+	m_pSpatialIndex->forEachInRadius(center, cellSize * 0.7072f + CROWD_NEIGHBOR_RADIUS, filter,
+		[&](const SpatialIndex::Entry& entry, float) {
+			scratch.x.push_back(entry.position.x);
+			scratch.z.push_back(entry.position.z);
+			scratch.entries.push_back(static_cast<int>(&entry - entries.data()));
+		});
+
+	// 补齐到4的倍数，补位放在远处
+	const size_t candidates = scratch.entries.size();
+	const size_t padded = (candidates + 3) & ~static_cast<size_t>(3);
+	scratch.x.resize(padded, 1e9f);
+	scratch.z.resize(padded, 1e9f);
+	scratch.distSq.resize(padded);
+
+	const float4 radiusSq(CROWD_NEIGHBOR_RADIUS * CROWD_NEIGHBOR_RADIUS);
+	for (int i = begin; i < end; ++i) {
+		// 2. 一次计算4个候选的距离，只有半径内的候选才进入最近K个的插入排序
+		const float4 px(m_posX[i]);
+		const float4 pz(m_posZ[i]);
+		scratch.hits.clear();
+		for (size_t c = 0; c < padded; c += 4) {
+			const float4 dx = load(&scratch.x[c]) - px;
+			const float4 dz = load(&scratch.z[c]) - pz;
+			const float4 distSq = dx * dx + dz * dz;
+			const int inside = movemask(cmple(distSq, radiusSq));
+			if (!inside) continue;
+
+			store(&scratch.distSq[c], distSq);
+			for (int j = 0; j < 4; ++j) {
+				if (!(inside & (1 << j))) continue;
+				const int candidate = static_cast<int>(c) + j;
+				if (scratch.entries[candidate] == m_agentEntries[i]) continue;	// 排除自身
+
+				const float d = scratch.distSq[candidate];
+				if (scratch.hits.size() == CROWD_MAX_NEIGHBORS && d >= scratch.hits.back().first) continue;
+				if (scratch.hits.size() < CROWD_MAX_NEIGHBORS) scratch.hits.push_back({ d, candidate });
+
+				size_t k = scratch.hits.size() - 1;
+				for (; k > 0 && scratch.hits[k - 1].first > d; --k) {
+					scratch.hits[k] = scratch.hits[k - 1];
+				}
+				scratch.hits[k] = { d, candidate };
+			}
+		}
+
+		const size_t base = static_cast<size_t>(i) * CROWD_MAX_NEIGHBORS;
+		for (int k = 0; k < CROWD_MAX_NEIGHBORS; ++k) {
+			const size_t slot = base + k;
+			if (k < static_cast<int>(scratch.hits.size())) {
+				const int c = scratch.hits[k].second;
+				const int e = scratch.entries[c];
+				m_nbrX[slot] = scratch.x[c] - m_posX[i];
+				m_nbrZ[slot] = scratch.z[c] - m_posZ[i];
+				m_nbrVelX[slot] = m_entryVelX[e];
+				m_nbrVelZ[slot] = m_entryVelZ[e];
+				m_nbrMask[slot] = 1.0f;
+			}
+			else {
+				// 空槽位放在远处，掩码保证不产生任何贡献
+				m_nbrX[slot] = CROWD_NEIGHBOR_RADIUS * 2.0f;
+				m_nbrZ[slot] = 0.0f;
+				m_nbrVelX[slot] = 0.0f;
+				m_nbrVelZ[slot] = 0.0f;
+				m_nbrMask[slot] = 0.0f;
+			}
+		}
+	}
+}
+
+void CrowdSystem::steer(int begin, int end)
+{
+	using namespace simd;
+
+	const float4 zero(0.0f);
+	const float4 one(1.0f);
+	const float4 epsilon(1e-4f);
+	const float4 separationRadius(CROWD_SEPARATION_RADIUS);
+	const float4 invSeparationRadius(1.0f / CROWD_SEPARATION_RADIUS);
+	const float4 horizon(CROWD_AVOID_HORIZON);
+	const float4 invHorizon(1.0f / CROWD_AVOID_HORIZON);
+	const float4 avoidDistanceSq(CROWD_AVOID_DISTANCE * CROWD_AVOID_DISTANCE);
+
+	for (int i = begin; i < end; ++i) {
+		const size_t base = static_cast<size_t>(i) * CROWD_MAX_NEIGHBORS;
+		const float4 vx(m_desiredX[i]);
+		const float4 vz(m_desiredZ[i]);
+
+		float4 sepX, sepZ, alignX, alignZ, avoidX, avoidZ, neighborCount;
+		for (int k = 0; k < CROWD_MAX_NEIGHBORS; k += 4) {
+			const float4 dx = load(&m_nbrX[base + k]);
+			const float4 dz = load(&m_nbrZ[base + k]);
+			const float4 nvx = load(&m_nbrVelX[base + k]);
+			const float4 nvz = load(&m_nbrVelZ[base + k]);
+			const float4 mask = load(&m_nbrMask[base + k]);
+
+			const float4 distSq = max(dx * dx + dz * dz, epsilon);
+			const float4 dist = sqrt(distSq);
+
+			// 分离：(1 - d / R) 线性衰减，方向背离邻居
+			const float4 push = max(one - dist * invSeparationRadius, zero) * mask / dist;
+			sepX = sepX - dx * push;
+			sepZ = sepZ - dz * push;
+
+			// 对齐：邻居速度之和
+			alignX = alignX + nvx * mask;
+			alignZ = alignZ + nvz * mask;
+			neighborCount = neighborCount + mask;
+
+			// 避让：相对运动的最近接近点在预测时间内且过近时，沿接近点反方向错开
+			const float4 rvx = nvx - vx;
+			const float4 rvz = nvz - vz;
+			const float4 rvSq = max(rvx * rvx + rvz * rvz, epsilon);
+			const float4 t = min(max(zero - (dx * rvx + dz * rvz) / rvSq, zero), horizon);
+			const float4 cx = dx + rvx * t;
+			const float4 cz = dz + rvz * t;
+			const float4 closestSq = max(cx * cx + cz * cz, epsilon);
+			const float4 threat = select(cmplt(closestSq, avoidDistanceSq), (one - t * invHorizon) * mask, zero);
+			const float4 avoid = threat / sqrt(closestSq);
+			avoidX = avoidX - cx * avoid;
+			avoidZ = avoidZ - cz * avoid;
+		}
+
+		const float desiredX = m_desiredX[i];
+		const float desiredZ = m_desiredZ[i];
+		const float speed = std::sqrt(desiredX * desiredX + desiredZ * desiredZ);
+
+		float steerX = desiredX + speed * (CROWD_SEPARATION_WEIGHT * sum(sepX) + CROWD_AVOID_WEIGHT * sum(avoidX));
+		float steerZ = desiredZ + speed * (CROWD_SEPARATION_WEIGHT * sum(sepZ) + CROWD_AVOID_WEIGHT * sum(avoidZ));
+		const float neighbors = sum(neighborCount);
+		if (neighbors > 0.0f) {
+			steerX += CROWD_ALIGNMENT_WEIGHT * (sum(alignX) / neighbors - desiredX);
+			steerZ += CROWD_ALIGNMENT_WEIGHT * (sum(alignZ) / neighbors - desiredZ);
+		}
+
+		// 不超过期望速度的大小
+		const float steerSpeed = std::sqrt(steerX * steerX + steerZ * steerZ);
+		if (steerSpeed > speed) {
+			steerX *= speed / steerSpeed;
+			steerZ *= speed / steerSpeed;
+		}
+		m_desiredX[i] = steerX;
+		m_desiredZ[i] = steerZ;
+	}
+}
@@ -0,0 +1,16 @@
+#include "systems/DistortionSystem.h"
+#include "spatial/SpatialIndex.h"
+#include "spatial/DistortionEffects.h"
+#include "ecs/World.h"
+
+DistortionSystem::DistortionSystem(const SpatialIndex* spatialIndex, DistortionEffects* distortionEffects)
+	: m_pSpatialIndex(spatialIndex), m_pDistortionEffects(distortionEffects)
+{
+}
+
+void DistortionSystem::update(World& world, float deltaTime)
+{
+	if (!m_pSpatialIndex || !m_pDistortionEffects) return;
+
+	m_pDistortionEffects->resolve(world, *m_pSpatialIndex);
+}
@@ -4,12 +4,47 @@
 #include "components/Corruption.h"
 #include "components/CorruptionSource.h"
 #include "components/DarkTide.h"
+#include "components/StatModifiers.h"
 #include "components/Transform.h"
 #include "prefabs/EnemyPrefab.h"
+#include "prefabs/EnemyPool.h"
+#include "spatial/CorruptionField.h"
+#include "spatial/CorruptionDiffusion.h"
+#include "spatial/InfluenceMap.h"
 #include "core/Logger.h"
-
-EnvironmentSystem::EnvironmentSystem()
-	: m_darkTideTimer(0.0f), m_darkTideInterval(120.0f)
+#include "core/Random.h"
+
+/// @brief 腐蚀源向扩散场注入的参数
+/// @details 注入半径为腐蚀源范围的比例，每秒注入量为腐蚀强度的比例
+const float DIFFUSION_INJECT_RADIUS_RATIO = 0.25f;
+const float DIFFUSION_INJECT_RATE = 0.05f;
+
+/// @brief 扩散场对实体腐蚀度的影响系数
+/// @details 每秒增加的腐蚀度 = 扩散场采样值 * 系数。实体只从扩散场累积腐蚀，
+/// 系数按稳态标定：腐蚀源中心的扩散浓度约为强度的 1/4（范围8）到 1/6（范围6），
+/// 取5使中心处的累积速度与原先按距离线性衰减的强度相当
+const float DIFFUSION_EXPOSURE = 5.0f;
+
+/// @brief 每个刷怪位置比较的候选点数
+const int SPAWN_CANDIDATES = 6;
+
+/// @brief 刷怪评分中威胁和密度的惩罚权重
+/// @details 评分 = 腐蚀浓度 - 威胁 * 权重 - 密度 * 权重
+const float SPAWN_THREAT_PENALTY = 20.0f;
+const float SPAWN_CROWD_PENALTY = 1.0f;
+
+/// @brief 刷怪候选点的坐标范围（X和Z）
+const float SPAWN_AREA_MIN = -50.0f;
+const float SPAWN_AREA_MAX = 50.0f;
+
+/// @brief 每帧最多加入世界的暗蚀生物数
+const int ENEMY_SPAWN_BUDGET = 16;
+
+EnvironmentSystem::EnvironmentSystem(CorruptionField* corruptionField, CorruptionDiffusion* corruptionDiffusion, JobSystem* jobSystem,
+	const InfluenceMap* influenceMap, EnemyPool* enemyPool)
+	: m_pCorruptionField(corruptionField), m_pCorruptionDiffusion(corruptionDiffusion), m_pJobSystem(jobSystem),
+	m_pInfluenceMap(influenceMap), m_pEnemyPool(enemyPool), m_pendingSpawns(0),
+	m_darkTideTimer(0.0f), m_darkTideInterval(120.0f)
 { }
 
 void EnvironmentSystem::update(World& world, float deltaTime)
@@ -21,43 +56,54 @@ void EnvironmentSystem::update(World& world, float deltaTime)
         m_darkTideTimer = 0.0f;
         Logger::instance()->log("暗蚀潮汐爆发！腐蚀强度增加，敌人生成率提升");
     }
+    spawnPendingEnemies(world);
 
+    // 更新所有腐蚀源，参数变化时才重新光栅化到腐蚀场
+    if (m_pCorruptionField) m_pCorruptionField->beginUpdate();
     for (auto& entity : world.getEntities()) {
-		// 更新所有腐蚀源
         if (auto* source = entity->getComponent<CorruptionSource>()) {
             auto* transform = entity->getComponent<Transform>();
             if (!transform) continue;
 
-            // 腐蚀源随时间增强
-            source->power += deltaTime * 0.1f;
-
-            // 影响范围内的实体（简化实现，实际应使用空间划分）
-            for (auto& other : world.getEntities()) {
-                if (other->getId() == entity->getId()) continue;
+            // 腐蚀源随时间增强，潮汐等修正作用在增长后的基础值上
+            source->basePower += deltaTime * 0.1f;
+            auto* modifiers = entity->getComponent<StatModifiers>();
+            source->power = modifiers ? modifiers->apply(StatModifiers::CorruptionPower, source->basePower) : source->basePower;
 
-                auto* otherTransform = other->getComponent<Transform>();
-                auto* corruption = other->getComponent<Corruption>();
-                if (!otherTransform || !corruption) continue;
+            if (m_pCorruptionField)
+                m_pCorruptionField->setSource(entity->getId(), transform->position, source->power, source->radius);
 
-                float distance = glm::distance(transform->position, otherTransform->position);
-                if (distance <= source->radius) {
-                    // 距离越近影响越大（线性衰减）
-                    float effect = source->power * (1.0f - distance / source->radius);
-                    corruption->current += effect * deltaTime;
-                }
-            }
+            // 向扩散场持续注入，使腐蚀向周围蔓延
+            if (m_pCorruptionDiffusion)
+                m_pCorruptionDiffusion->inject(transform->position, source->radius * DIFFUSION_INJECT_RADIUS_RATIO,
+                    source->power * DIFFUSION_INJECT_RATE * deltaTime);
         }
+    }
+    if (m_pCorruptionField) m_pCorruptionField->removeStaleSources();
+
+    // 推进扩散模拟
+    if (m_pCorruptionDiffusion) m_pCorruptionDiffusion->step(deltaTime, m_pJobSystem);
 
-        // 更新所有空间扭曲效果
+    // 实体只从扩散场采样；腐蚀场仍供影响力和渲染使用，不再叠加到暴露量上，避免重复计算
+    if (m_pCorruptionDiffusion) {
         for (auto& entity : world.getEntities()) {
-            if (auto* distortion = entity->getComponent<SpatialDistortion>()) {
-                distortion->duration -= deltaTime;
-
-                if (distortion->duration <= 0.0f) {
-                    // 扭曲效果结束
-                    entity->getWorld().markEntityForDestruction(*entity);
-                    Logger::instance()->log("空间扭曲效果结束");
-                }
+            auto* corruption = entity->getComponent<Corruption>();
+            auto* transform = entity->getComponent<Transform>();
+            if (!corruption || !transform) continue;
+
+            corruption->add(m_pCorruptionDiffusion->sample(transform->position) * DIFFUSION_EXPOSURE * deltaTime);
+        }
+    }
+
+    // 更新所有空间扭曲效果
+    for (auto& entity : world.getEntities()) {
+        if (auto* distortion = entity->getComponent<SpatialDistortion>()) {
+            distortion->duration -= deltaTime;
+
+            if (distortion->duration <= 0.0f) {
+                // 扭曲效果结束
+                entity->getWorld().markEntityForDestruction(*entity);
+                Logger::instance()->log("空间扭曲效果结束");
             }
         }
     }
@@ -74,22 +120,22 @@ void EnvironmentSystem::spawnCorruptionSource(World& world, const glm::vec3& pos
         std::to_string(position.z) + ")");
 }
 
-void EnvironmentSystem::spawnDarkTide(World& world, float duration, float powerMultiplier, float spawnRate) {
+void EnvironmentSystem::spawnDarkTide(World& world, float duration, float powerMultiplier, float spawnRate, int waveSize) {
     auto& tide = world.createEntity();
     tide.addComponent<DarkTide>(duration, powerMultiplier, spawnRate);
 
-    // 增强所有腐蚀源
+    // 在潮汐持续期间增强所有腐蚀源，到期后修正自动移除；再次爆发只刷新时长，不会叠乘
     for (auto& entity : world.getEntities()) {
-        if (auto* source = entity->getComponent<CorruptionSource>()) {
-            source->power *= powerMultiplier;
+        if (entity->hasComponent<CorruptionSource>()) {
+            auto* modifiers = entity->getComponent<StatModifiers>();
+            if (!modifiers) modifiers = &entity->addComponent<StatModifiers>();
+            modifiers->set(StatModifiers::CorruptionPower, StatModifiers::Multiply, powerMultiplier,
+                StatModifiers::SourceDarkTide, duration);
         }
     }
 
-    // 生成更多暗蚀生物
-    for (int i = 0; i < 5; i++) {
-        glm::vec3 position(rand() % 100 - 50, 0.0f, rand() % 100 - 50);
-        Prefab::createDarkCreature(world, position);
-    }
+    // 生成更多暗蚀生物，由每帧的预算分批加入世界
+    if (waveSize > 0) m_pendingSpawns += waveSize;
 
     Logger::instance()->log("暗蚀潮汐开始，持续: " + std::to_string(duration) + "秒");
 }
@@ -122,4 +168,46 @@ void EnvironmentSystem::spawnSpatialDistortion(World& world, DistortionType type
         " 在位置: (" + std::to_string(position.x) + ", " +
         std::to_string(position.y) + ", " +
         std::to_string(position.z) + ")");
-}
\ No newline at end of file
+}
+
+glm::vec3 EnvironmentSystem::pickSpawnPosition(Random& random) const
+{
+    // 一次生成所有候选点的坐标
+    float coordinates[SPAWN_CANDIDATES * 2];
+    const int candidates = m_pInfluenceMap ? SPAWN_CANDIDATES : 1;
+    random.fill(coordinates, candidates * 2, SPAWN_AREA_MIN, SPAWN_AREA_MAX);
+
+    glm::vec3 best(coordinates[0], 0.0f, coordinates[1]);
+    if (!m_pInfluenceMap) return best;
+
+    // 影响力图采样是O(1)的，多比较几个候选点几乎没有开销
+    auto score = [this](const glm::vec3& position) {
+        return m_pInfluenceMap->sample(InfluenceMap::Corruption, position)
+            - m_pInfluenceMap->sample(InfluenceMap::Threat, position) * SPAWN_THREAT_PENALTY
+            - m_pInfluenceMap->sample(InfluenceMap::Crowd, position) * SPAWN_CROWD_PENALTY;
+    };
+    float bestScore = score(best);
+    for (int i = 1; i < candidates; ++i) {
+        const glm::vec3 candidate(coordinates[i * 2], 0.0f, coordinates[i * 2 + 1]);
+        const float candidateScore = score(candidate);
+        if (candidateScore > bestScore) {
+            best = candidate;
+            bestScore = candidateScore;
+        }
+    }
+    return best;
+}
+
+void EnvironmentSystem::spawnPendingEnemies(World& world)
+{
+    const int count = m_pendingSpawns < ENEMY_SPAWN_BUDGET ? m_pendingSpawns : ENEMY_SPAWN_BUDGET;
+    if (count == 0) return;
+
+    Random random = world.random(RandomStream::Environment);
+    for (int i = 0; i < count; ++i) {
+        const glm::vec3 position = pickSpawnPosition(random);
+        if (m_pEnemyPool) m_pEnemyPool->acquire(position);
+        else Prefab::createDarkCreature(world, position);
+    }
+    m_pendingSpawns -= count;
+}
@@ -0,0 +1,51 @@
+#include "systems/HealthSystem.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "core/Simd.h"
+#include "core/Logger.h"
+
+void HealthSystem::update(World& world, float deltaTime)
+{
+	m_deaths.clear();
+	m_dead.clear();
+	sweep(world.getHealthStore());
+
+	for (size_t i = 0; i < m_dead.size(); ++i) {
+		world.markEntityForDestruction(*m_dead[i]);
+		Logger::instance()->log("实体被击败: " + std::to_string(m_deaths[i].entity) +
+			" 击杀者: " + std::to_string(m_deaths[i].killer));
+	}
+}
+
+void HealthSystem::sweep(HealthStore& store)
+{
+	const simd::float4 zero(0.0f);
+	const simd::float4 one(1.0f);
+	const simd::float4 half(0.5f);
+
+	float* current = store.getCurrent();
+	const float* max = store.getMax();
+	float* reported = store.getReported();
+	const size_t capacity = store.getCapacity();
+	for (size_t i = 0; i < capacity; i += 4) {
+		// 1. 夹紧到 [0, 最大值]
+		const simd::float4 health = simd::max(simd::min(simd::load(&current[i]), simd::load(&max[i])), zero);
+		simd::store(&current[i], health);
+
+		// 2. 生命值为0且尚未上报的是本帧新死亡的槽位，空闲槽位始终标记为已上报
+		const simd::float4 wasReported = simd::load(&reported[i]);
+		const simd::float4 dead = simd::cmple(health, zero) & simd::cmplt(wasReported, half);
+		const int mask = simd::movemask(dead);
+		if (mask == 0) continue;
+
+		// 3. 标记上报并取出所属实体
+		simd::store(&reported[i], simd::select(dead, one, wasReported));
+		for (int lane = 0; lane < 4; ++lane) {
+			if (!(mask & (1 << lane))) continue;
+			const uint32_t slot = static_cast<uint32_t>(i + lane);
+			Entity* owner = store.getOwner(slot);
+			m_dead.push_back(owner);
+			m_deaths.push_back({ owner->getId(), store.lastAttacker(slot) });
+		}
+	}
+}
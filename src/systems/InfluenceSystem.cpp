@@ -0,0 +1,16 @@
+#include "systems/InfluenceSystem.h"
+#include "spatial/SpatialIndex.h"
+#include "spatial/InfluenceMap.h"
+#include "ecs/World.h"
+
+InfluenceSystem::InfluenceSystem(const SpatialIndex* spatialIndex, const CorruptionField* corruptionField, InfluenceMap* influenceMap)
+	: m_pSpatialIndex(spatialIndex), m_pCorruptionField(corruptionField), m_pInfluenceMap(influenceMap)
+{
+}
+
+void InfluenceSystem::update(World& world, float deltaTime)
+{
+	if (!m_pSpatialIndex || !m_pInfluenceMap) return;
+
+	m_pInfluenceMap->update(*m_pSpatialIndex, m_pCorruptionField, deltaTime);
+}
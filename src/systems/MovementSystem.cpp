@@ -3,22 +3,39 @@
 #include "ecs/Entity.h"
 #include "components/Transform.h"
 #include "components/Velocity.h"
+#include "spatial/DistortionEffects.h"
+
+MovementSystem::MovementSystem(const DistortionEffects* distortionEffects)
+	: m_pDistortionEffects(distortionEffects)
+{
+}
 
 void MovementSystem::update(World& world, float deltaTime) {
-	for (auto& entity : world.getEntities()) {
+	const auto& entities = world.getEntities();
+	for (size_t i = 0; i < entities.size(); ++i) {
+		auto& entity = entities[i];
 		auto* transform = entity->getComponent<Transform>();
 		auto* velocity = entity->getComponent<Velocity>();
 
 		if (transform && velocity) {
-			// 更新位置
-			transform->position += velocity->linear * deltaTime;
+			// 时间膨胀区域内的实体使用缩放后的时间
+			float scaledDelta = deltaTime;
+			glm::vec3 gravity(0.0f);
+			if (m_pDistortionEffects) {
+				scaledDelta *= m_pDistortionEffects->getTimeScale(i);
+				gravity = m_pDistortionEffects->getGravity(i);
+			}
+
+			// 更新位置（重力偏移区域额外施加牵引）
+			transform->position += (velocity->linear + gravity) * scaledDelta;
+			if (transform->position.y < 0.0f) transform->position.y = 0.0f;	// 不穿过地面
 
 			// 更新旋转（四元数旋转）
 			if (glm::length(velocity->angular) > 0.0f) {
-				float angle = glm::length(velocity->angular) * deltaTime;
+				float angle = glm::length(velocity->angular) * scaledDelta;
 				glm::quat rot = glm::angleAxis(angle, glm::normalize(velocity->angular));
 				transform->rotation = rot * transform->rotation;
 			}
 		}
 	}
-}
\ No newline at end of file
+}
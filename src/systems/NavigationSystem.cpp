@@ -0,0 +1,29 @@
+#include "systems/NavigationSystem.h"
+#include "navigation/FlowField.h"
+#include "navigation/Pathfinder.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "components/Player.h"
+#include "components/Transform.h"
+
+NavigationSystem::NavigationSystem(FlowField* flowField, Pathfinder* pathfinder, JobSystem* jobSystem)
+	: m_pFlowField(flowField), m_pPathfinder(pathfinder), m_pJobSystem(jobSystem)
+{
+}
+
+void NavigationSystem::update(World& world, float deltaTime)
+{
+	if (m_pPathfinder) {
+		m_pPathfinder->update(m_pJobSystem);
+	}
+	if (!m_pFlowField) return;
+
+	for (auto& entity : world.getEntities()) {
+		if (!entity->getComponent<Player>()) continue;
+
+		if (auto* transform = entity->getComponent<Transform>()) {
+			m_pFlowField->update(transform->position, m_pJobSystem);
+		}
+		break;
+	}
+}
@@ -9,11 +9,25 @@
 #include "components/CombatInput.h"
 #include "components/MovementProperties.h"
 #include "components/Camera.h"
+#include "combat/ProjectilePool.h"
+#include "spatial/SpatialIndex.h"
 
 #include "core/Logger.h"
 
-PlayerControlSystem::PlayerControlSystem(InputMap* inputMap)
-	: m_pInputMap(inputMap)
+/// @brief 远程攻击的发射间隔（秒）
+const float PLAYER_RANGED_INTERVAL = 0.1f;
+
+/// @brief 玩家投射物的速度、半径、伤害和存活时间
+const float PLAYER_PROJECTILE_SPEED = 40.0f;
+const float PLAYER_PROJECTILE_RADIUS = 0.1f;
+const float PLAYER_PROJECTILE_DAMAGE = 8.0f;
+const float PLAYER_PROJECTILE_LIFETIME = 2.0f;
+
+/// @brief 投射物发射点相对玩家位置的高度
+const float PLAYER_PROJECTILE_HEIGHT = 1.0f;
+
+PlayerControlSystem::PlayerControlSystem(InputMap* inputMap, ProjectilePool* projectiles)
+	: m_pInputMap(inputMap), m_pProjectiles(projectiles), m_rangedTimer(PLAYER_RANGED_INTERVAL)
 {
 }
 
@@ -37,6 +51,7 @@ void PlayerControlSystem::update(World& world, float deltaTime)
 	checkAbility(pPlayer, InputMap::Ability5, AbilityType::Purification);
 
 	handleMovement(pPlayer, deltaTime);
+	handleRangedAttack(pPlayer, deltaTime);
 
 	auto* attack = pPlayer->getComponent<Attack>();
 	auto* transform = pPlayer->getComponent<Transform>();
@@ -144,3 +159,24 @@ void PlayerControlSystem::handleMovement(Entity* player, float deltaTime)
 		velocity->linear = glm::vec3(0.0f);
 	}
 }
+
+void PlayerControlSystem::handleRangedAttack(Entity* player, float deltaTime)
+{
+	if (!player || !m_pProjectiles) return;
+
+	m_rangedTimer += deltaTime;
+	if (!m_pInputMap->isActionHeld(InputMap::AttackRanged) || m_rangedTimer < PLAYER_RANGED_INTERVAL) return;
+
+	auto* transform = player->getComponent<Transform>();
+	if (!transform) return;
+
+	// 沿水平朝向发射，只命中敌人
+	glm::vec3 direction(transform->forward.x, 0.0f, transform->forward.z);
+	if (glm::dot(direction, direction) < 1e-6f) return;
+	direction = glm::normalize(direction);
+
+	m_pProjectiles->spawn(transform->position + glm::vec3(0.0f, PLAYER_PROJECTILE_HEIGHT, 0.0f),
+		direction * PLAYER_PROJECTILE_SPEED, PLAYER_PROJECTILE_RADIUS, PLAYER_PROJECTILE_DAMAGE, PLAYER_PROJECTILE_LIFETIME,
+		player->getId(), SpatialIndex::TagEnemy);
+	m_rangedTimer = 0.0f;
+}
@@ -0,0 +1,117 @@
+#include "systems/ProjectileSystem.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "components/Collider.h"
+#include "combat/DamageQueue.h"
+#include "combat/ProjectilePool.h"
+#include "spatial/SpatialIndex.h"
+#include "core/JobSystem.h"
+
+#include <cmath>
+
+/// @brief 超过该数量才分发给任务系统
+const size_t PROJECTILE_SWEEP_PARALLEL_THRESHOLD = 1024;
+
+/// @brief 每个任务块包含的投射物数
+const int PROJECTILE_SWEEP_GRAIN = 256;
+
+/// @brief 查询半径在线段半长和投射物半径之外的余量
+/// @details 需覆盖目标的碰撞半径和高度，空间索引按实体位置（脚底）做三维距离筛选
+const float PROJECTILE_QUERY_MARGIN = 2.5f;
+
+/// @brief 没有碰撞体的目标使用的半径和高度
+const float PROJECTILE_DEFAULT_TARGET_RADIUS = 0.5f;
+const float PROJECTILE_DEFAULT_TARGET_HEIGHT = 1.0f;
+
+ProjectileSystem::ProjectileSystem(const SpatialIndex* spatialIndex, DamageQueue* damageQueue, ProjectilePool* projectiles, JobSystem* jobSystem)
+	: m_pSpatialIndex(spatialIndex), m_pDamageQueue(damageQueue), m_pProjectiles(projectiles), m_pJobSystem(jobSystem),
+	m_hitTargets(projectiles ? projectiles->getCapacity() : 0, -1)
+{
+}
+
+void ProjectileSystem::update(World& world, float deltaTime)
+{
+	if (!m_pProjectiles || !m_pDamageQueue) return;
+
+	const size_t count = m_pProjectiles->getCount();
+	if (count == 0) return;
+
+	// 1. 用本帧起点到终点的线段检测命中
+	if (m_pJobSystem && count >= PROJECTILE_SWEEP_PARALLEL_THRESHOLD) {
+		m_pJobSystem->parallelFor(static_cast<int>(count), PROJECTILE_SWEEP_GRAIN, [this, deltaTime](int begin, int end) {
+			sweep(static_cast<size_t>(begin), static_cast<size_t>(end), deltaTime);
+		});
+	}
+	else {
+		sweep(0, count, deltaTime);
+	}
+
+	// 2. 推进所有投射物
+	m_pProjectiles->integrate(deltaTime, m_pJobSystem);
+
+	// 3. 倒序处理命中和到期，移到空位的是已经处理过且保留下来的投射物
+	for (size_t i = count; i-- > 0;) {
+		const int target = m_hitTargets[i];
+		if (target >= 0) {
+			m_pDamageQueue->push(m_pProjectiles->getOwner(i), target, m_pProjectiles->getDamage(i), m_pProjectiles->getType(i));
+			m_pProjectiles->despawn(i);
+		}
+		else if (m_pProjectiles->getLifetime(i) <= 0.0f) {
+			m_pProjectiles->despawn(i);
+		}
+	}
+}
+
+void ProjectileSystem::sweep(size_t begin, size_t end, float deltaTime)
+{
+	for (size_t i = begin; i < end; ++i) {
+		m_hitTargets[i] = -1;
+		if (!m_pSpatialIndex) continue;
+
+		const glm::vec3 start = m_pProjectiles->getPosition(i);
+		const glm::vec3 move = m_pProjectiles->getVelocity(i) * deltaTime;
+		const float radius = m_pProjectiles->getRadius(i);
+		const int owner = m_pProjectiles->getOwner(i);
+
+		SpatialIndex::Filter filter;
+		filter.requireTags = m_pProjectiles->getTargetTags(i);
+
+		// 水平面上的线段参数，竖直方向单独判断
+		const float a = move.x * move.x + move.z * move.z;
+		float bestTime = 2.0f;
+		m_pSpatialIndex->forEachInRadius(start + move * 0.5f, glm::length(move) * 0.5f + radius + PROJECTILE_QUERY_MARGIN, filter,
+			[&](const SpatialIndex::Entry& entry, float) {
+				if (entry.entity->getId() == owner) return;
+
+				float targetRadius = PROJECTILE_DEFAULT_TARGET_RADIUS;
+				float targetHeight = PROJECTILE_DEFAULT_TARGET_HEIGHT;
+				if (auto* collider = entry.entity->getComponent<Collider>()) {
+					targetRadius = collider->radius;
+					targetHeight = collider->height;
+				}
+
+				// 扫掠球与竖直圆柱：先求水平面上首次接触的时刻 t ∈ [0, 1]
+				const float mx = start.x - entry.position.x;
+				const float mz = start.z - entry.position.z;
+				const float reach = radius + targetRadius;
+				const float c = mx * mx + mz * mz - reach * reach;
+				float t = 0.0f;
+				if (c > 0.0f) {
+					const float b = mx * move.x + mz * move.z;
+					if (a <= 0.0f || b >= 0.0f) return;	// 静止或正在远离
+					const float discriminant = b * b - a * c;
+					if (discriminant < 0.0f) return;
+					t = (-b - std::sqrt(discriminant)) / a;
+					if (t > 1.0f) return;
+				}
+				if (t >= bestTime) return;
+
+				// 再检查接触时刻的高度是否落在圆柱高度范围内
+				const float y = start.y + move.y * t;
+				if (y < entry.position.y - radius || y > entry.position.y + targetHeight + radius) return;
+
+				bestTime = t;
+				m_hitTargets[i] = entry.entity->getId();
+			});
+	}
+}
@@ -0,0 +1,15 @@
+#include "systems/SpatialIndexSystem.h"
+#include "spatial/SpatialIndex.h"
+#include "ecs/World.h"
+
+SpatialIndexSystem::SpatialIndexSystem(SpatialIndex* spatialIndex)
+	: m_pSpatialIndex(spatialIndex)
+{
+}
+
+void SpatialIndexSystem::update(World& world, float deltaTime)
+{
+	if (!m_pSpatialIndex) return;
+
+	m_pSpatialIndex->rebuild(world);
+}
@@ -0,0 +1,243 @@
+#include "systems/SquadSystem.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "core/Logger.h"
+#include "core/Random.h"
+#include "components/Player.h"
+#include "components/Enemy.h"
+#include "components/Transform.h"
+#include "components/Velocity.h"
+#include "components/Health.h"
+#include "components/AI.h"
+#include "components/Behavior.h"
+#include "components/Squad.h"
+#include "components/MeshRenderer.h"
+#include "navigation/Pathfinder.h"
+#include "prefabs/EnemyPrefab.h"
+#include "prefabs/EnemyPool.h"
+
+#include <cmath>
+#include <algorithm>
+
+/// @brief 合并与拆分的检查间隔（秒）
+const float SQUAD_UPDATE_INTERVAL = 0.5f;
+
+/// @brief 小队离玩家小于该距离时拆分
+const float SQUAD_SPLIT_DISTANCE = 45.0f;
+
+/// @brief 合并时划分区域的格子边长
+const float SQUAD_CELL_SIZE = 20.0f;
+
+/// @brief 成员相对小队中心的最大水平偏移
+/// @details 成员和小队并入时处在同一格子，偏移不超过格子对角线
+const float SQUAD_MAX_OFFSET = SQUAD_CELL_SIZE * 1.41421356f;
+
+/// @brief 敌人离玩家超过该水平距离才会被合并
+/// @details 拆分距离加上最大偏移：拆分后重建的成员离玩家都不超过该距离，不会在下次检查时被重新合并；
+/// 新组建的小队中心离玩家也一定超过拆分距离，不会立即拆分
+const float SQUAD_MERGE_DISTANCE = SQUAD_SPLIT_DISTANCE + SQUAD_MAX_OFFSET;
+
+/// @brief 小队游荡的路点离组建位置的最大距离，与单个敌人巡逻点的范围相当
+const float SQUAD_WANDER_RADIUS = 5.0f;
+
+/// @brief 离路点小于该距离视为到达
+const float SQUAD_WAYPOINT_TOLERANCE = 0.5f;
+
+/// @brief 组成新小队所需的最少敌人数
+const size_t SQUAD_MIN_MEMBERS = 2;
+
+/// @brief 每个小队的成员上限
+const size_t SQUAD_MAX_MEMBERS = 32;
+
+SquadSystem::SquadSystem(Pathfinder* pathfinder, EnemyPool* enemyPool)
+	: m_pPathfinder(pathfinder), m_pEnemyPool(enemyPool), m_timer(0.0f)
+{
+}
+
+SquadSystem::~SquadSystem() = default;
+
+void SquadSystem::update(World& world, float deltaTime)
+{
+	Entity* player = nullptr;
+	glm::vec3 playerPosition(0.0f);
+	for (auto& entity : world.getEntities()) {
+		if (!entity->getComponent<Player>()) continue;
+		if (auto* transform = entity->getComponent<Transform>()) {
+			player = entity.get();
+			playerPosition = transform->position;
+		}
+		break;
+	}
+
+	// 1. 小队整体在组建位置附近巡逻游荡，检查时顺便收集需要拆分的小队
+	const bool check = (m_timer += deltaTime) >= SQUAD_UPDATE_INTERVAL;
+	m_toSplit.clear();
+	m_candidates.clear();
+	m_squads.clear();
+	for (auto& entity : world.getEntities()) {
+		auto* transform = entity->getComponent<Transform>();
+		if (!transform) continue;
+
+		if (auto* squad = entity->getComponent<Squad>()) {
+			if (auto* velocity = entity->getComponent<Velocity>()) {
+				moveSquad(world, *entity, *squad, *transform, *velocity);
+			}
+
+			if (!check || squad->members.empty()) continue;
+			glm::vec3 offset = playerPosition - transform->position;
+			offset.y = 0.0f;
+			if (player && glm::length(offset) < SQUAD_SPLIT_DISTANCE) {
+				m_toSplit.push_back(entity.get());
+			}
+			else if (squad->members.size() < SQUAD_MAX_MEMBERS) {
+				m_squads.emplace_back(cellKey(transform->position), entity.get());
+			}
+			continue;
+		}
+
+		// 2. 收集远处空闲或巡逻中的普通敌人
+		if (!check || !player || !entity->getComponent<Enemy>() || entity->getComponent<Behavior>()) continue;
+		auto* ai = entity->getComponent<AI>();
+		auto* health = entity->getComponent<Health>();
+		if (!ai || !health || health->getCurrent() <= 0.0f || ai->assimilatedTime > 0.0f) continue;
+		if (ai->state != AIState::Idle && ai->state != AIState::Patrol) continue;
+		glm::vec3 offset = playerPosition - transform->position;
+		offset.y = 0.0f;
+		if (glm::length(offset) <= SQUAD_MERGE_DISTANCE) continue;
+		m_candidates.emplace_back(cellKey(transform->position), entity.get());
+	}
+	if (!check) return;
+	m_timer = 0.0f;
+
+	// 3. 先合并再拆分，拆分新建的敌人不会在本次被合并
+	const size_t merged = mergeCandidates(world);
+	for (Entity* squad : m_toSplit) {
+		split(world, squad);
+	}
+
+	if (merged > 0 || !m_toSplit.empty()) {
+		Logger::instance()->log("小队更新：合并敌人 " + std::to_string(merged) + " 个，拆分小队 " +
+			std::to_string(m_toSplit.size()) + " 个");
+	}
+}
+
+void SquadSystem::moveSquad(World& world, Entity& entity, Squad& squad, const Transform& transform, Velocity& velocity)
+{
+	glm::vec3 offset = squad.waypoint - transform.position;
+	offset.y = 0.0f;
+	const float distance = glm::length(offset);
+	if (distance > SQUAD_WAYPOINT_TOLERANCE) {
+		velocity.linear = offset * (squad.speed / distance);
+		return;
+	}
+
+	// 到达路点后停一帧，在组建位置附近另取一个路点
+	float point[2];
+	world.random(RandomStream::Squad, entity.getId()).fill(point, 2, -SQUAD_WANDER_RADIUS, SQUAD_WANDER_RADIUS);
+	squad.waypoint = squad.anchor + glm::vec3(point[0], 0.0f, point[1]);
+	velocity.linear = glm::vec3(0.0f);
+}
+
+void SquadSystem::split(World& world, Entity* squad)
+{
+	auto* transform = squad->getComponent<Transform>();
+	auto* data = squad->getComponent<Squad>();
+	for (const SquadMember& member : data->members) {
+		const glm::vec3 position = transform->position + member.offset;
+		auto& enemy = m_pEnemyPool ? m_pEnemyPool->acquire(position) : Prefab::createDarkCreature(world, position);
+		if (auto* health = enemy.getComponent<Health>()) {
+			health->setCurrent(member.health);
+			health->setMax(member.maxHealth);
+			health->setBaseMax(member.baseMaxHealth);
+		}
+	}
+	data->members.clear();
+
+	// 收回网格留给之后组建的小队，避免每次合并都重新上传GPU缓冲
+	if (auto* renderer = squad->getComponent<MeshRenderer>()) {
+		if (renderer->mesh) m_meshes.emplace_back(renderer->mesh);
+		renderer->mesh = nullptr;
+	}
+	world.markEntityForDestruction(*squad);
+}
+
+size_t SquadSystem::mergeCandidates(World& world)
+{
+	// 同一格子的候选和小队排到一起
+	auto byKey = [](const std::pair<uint64_t, Entity*>& a, const std::pair<uint64_t, Entity*>& b) {
+		return a.first < b.first;
+	};
+	std::sort(m_candidates.begin(), m_candidates.end(), byKey);
+	std::sort(m_squads.begin(), m_squads.end(), byKey);
+
+	size_t merged = 0;
+	size_t squadIndex = 0;
+	for (size_t begin = 0; begin < m_candidates.size();) {
+		const uint64_t key = m_candidates[begin].first;
+		size_t end = begin;
+		while (end < m_candidates.size() && m_candidates[end].first == key) ++end;
+
+		// 格子里已有小队时并入，否则人数足够才组成新小队
+		while (squadIndex < m_squads.size() && m_squads[squadIndex].first < key) ++squadIndex;
+		Entity* squad = nullptr;
+		if (squadIndex < m_squads.size() && m_squads[squadIndex].first == key) {
+			squad = m_squads[squadIndex].second;
+		}
+		else if (end - begin >= SQUAD_MIN_MEMBERS) {
+			glm::vec3 center(0.0f);
+			float speed = 0.0f;
+			for (size_t i = begin; i < end; ++i) {
+				Entity* enemy = m_candidates[i].second;
+				center += enemy->getComponent<Transform>()->position;
+				const float patrolSpeed = enemy->getComponent<AI>()->patrolSpeed;
+				speed = i == begin ? patrolSpeed : std::min(speed, patrolSpeed);
+			}
+			center /= static_cast<float>(end - begin);
+			center.y = 0.0f;
+
+			Mesh* mesh = nullptr;
+			if (!m_meshes.empty()) {
+				mesh = m_meshes.back().release();
+				m_meshes.pop_back();
+			}
+			squad = &Prefab::createSquad(world, center, mesh);
+			squad->getComponent<Squad>()->speed = speed;	// 按最慢的成员移动
+		}
+
+		if (squad) {
+			auto* data = squad->getComponent<Squad>();
+			for (size_t i = begin; i < end && data->members.size() < SQUAD_MAX_MEMBERS; ++i) {
+				absorb(squad, m_candidates[i].second);
+				++merged;
+			}
+		}
+		begin = end;
+	}
+	return merged;
+}
+
+void SquadSystem::absorb(Entity* squad, Entity* enemy)
+{
+	auto* ai = enemy->getComponent<AI>();
+	if (m_pPathfinder && ai->pathRequest != 0) {
+		m_pPathfinder->cancel(ai->pathRequest);
+		ai->pathRequest = 0;
+	}
+
+	const auto* health = enemy->getComponent<Health>();
+	SquadMember member;
+	member.offset = enemy->getComponent<Transform>()->position - squad->getComponent<Transform>()->position;
+	member.health = health->getCurrent();
+	member.maxHealth = health->getMax();
+	member.baseMaxHealth = health->getBaseMax();
+	squad->getComponent<Squad>()->members.push_back(member);
+
+	enemy->getWorld().markEntityForDestruction(*enemy);
+}
+
+uint64_t SquadSystem::cellKey(const glm::vec3& position)
+{
+	const int32_t x = static_cast<int32_t>(std::floor(position.x / SQUAD_CELL_SIZE));
+	const int32_t z = static_cast<int32_t>(std::floor(position.z / SQUAD_CELL_SIZE));
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
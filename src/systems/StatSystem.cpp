@@ -0,0 +1,43 @@
+#include "systems/StatSystem.h"
+#include "ecs/World.h"
+#include "ecs/Entity.h"
+#include "components/StatModifiers.h"
+#include "components/Health.h"
+#include "components/DarkEnergy.h"
+
+void StatSystem::update(World& world, float deltaTime)
+{
+	for (auto& entity : world.getEntities()) {
+		auto* modifiers = entity->getComponent<StatModifiers>();
+		if (!modifiers) continue;
+
+		modifiers->advance(deltaTime);
+		if (modifiers->pendingMask) {
+			writeBack(entity.get(), modifiers);
+		}
+	}
+}
+
+void StatSystem::writeBack(Entity* entity, StatModifiers* modifiers)
+{
+	const uint32_t pending = modifiers->pendingMask;
+
+	if (pending & (1u << StatModifiers::MaxHealth)) {
+		if (auto* health = entity->getComponent<Health>()) {
+			health->setMax(modifiers->apply(StatModifiers::MaxHealth, health->getBaseMax()));
+
+			// 如果当前生命值超过上限，调整到上限
+			if (health->getCurrent() > health->getMax()) {
+				health->setCurrent(health->getMax());
+			}
+		}
+	}
+
+	if (pending & (1u << StatModifiers::EnergyRecovery)) {
+		if (auto* energy = entity->getComponent<DarkEnergy>()) {
+			energy->recoveryRate = modifiers->apply(StatModifiers::EnergyRecovery, energy->baseRecoveryRate);
+		}
+	}
+
+	modifiers->pendingMask = 0;
+}